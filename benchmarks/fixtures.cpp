@@ -0,0 +1,46 @@
+#include "fixtures.h"
+#include "../src/core/channels/channelFactory.h"
+#include "../src/core/mixer.h"
+#include "../src/core/model/model.h"
+#include "../src/core/wave.h"
+
+namespace giada::bench
+{
+namespace
+{
+void addChannel_(m::model::Model& model, m::channelFactory::Data data)
+{
+	model.get().channels.add(data.channel);
+	model.addChannelShared(std::move(data.shared));
+}
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+void makeLayout(m::model::Model& model, int numChannels, int bufferSize, m::Wave& wave)
+{
+	const m::Resampler::Quality quality = m::Resampler::Quality::LINEAR;
+
+	model.init();
+
+	addChannel_(model, m::channelFactory::create(m::Mixer::MASTER_OUT_CHANNEL_ID, ChannelType::MASTER, 0, 0, bufferSize, quality, false));
+	addChannel_(model, m::channelFactory::create(m::Mixer::MASTER_IN_CHANNEL_ID, ChannelType::MASTER, 0, 0, bufferSize, quality, false));
+	addChannel_(model, m::channelFactory::create(m::Mixer::PREVIEW_CHANNEL_ID, ChannelType::PREVIEW, 0, 0, bufferSize, quality, false));
+
+	for (int i = 0; i < numChannels; i++)
+	{
+		m::channelFactory::Data data = m::channelFactory::create(/*id=*/0, ChannelType::SAMPLE,
+		    /*columnId=*/1, /*position=*/i, bufferSize, quality, /*overdubProtection=*/false);
+
+		data.channel.samplePlayer->mode = SamplePlayerMode::SINGLE_ENDLESS;
+		data.channel.samplePlayer->loadWave(*data.shared, &wave);
+		data.shared->playStatus.store(ChannelStatus::PLAY);
+
+		addChannel_(model, std::move(data));
+	}
+
+	model.swap(m::model::SwapType::HARD);
+}
+} // namespace giada::bench
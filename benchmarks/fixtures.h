@@ -0,0 +1,24 @@
+#ifndef G_BENCH_FIXTURES_H
+#define G_BENCH_FIXTURES_H
+
+namespace giada::m
+{
+class Wave;
+}
+
+namespace giada::m::model
+{
+class Model;
+}
+
+namespace giada::bench
+{
+/* makeLayout
+Initializes the model with the internal channels (master out, master in and
+preview) plus 'numChannels' sample channels, all playing Wave 'wave' in
+SINGLE_ENDLESS mode, so that they never stop. */
+
+void makeLayout(m::model::Model&, int numChannels, int bufferSize, m::Wave& wave);
+} // namespace giada::bench
+
+#endif
@@ -0,0 +1,94 @@
+#include "../src/core/const.h"
+#include "../src/core/engine.h"
+#include "../src/gui/ui.h"
+#include "../src/utils/log.h"
+#include "../src/utils/string.h"
+#include "suite.h"
+#include <algorithm>
+#include <cstdlib>
+#include <fmt/core.h>
+#include <fstream>
+#include <string>
+
+/* Global Engine and UI objects, referenced by the core sources linked into
+the benchmark executable. They are not used by the benchmarks themselves. */
+
+giada::m::Engine g_engine;
+giada::v::Ui     g_ui;
+
+namespace
+{
+void printUsage_()
+{
+	fmt::print("Usage: giada-bench [options]\n"
+	           "  --out <path>      write results to a JSON file (default: stdout)\n"
+	           "  --filter <text>   run only benchmarks whose name contains <text>\n"
+	           "  --samples <n>     timed samples per benchmark (default: 20)\n"
+	           "  --min-time <ms>   minimum duration of a sample (default: 10)\n"
+	           "  --list            list available benchmarks and quit\n");
+}
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+
+int main(int argc, char** argv)
+{
+	using namespace giada;
+
+	bench::Suite::Options options;
+	std::string           outPath;
+
+	for (int i = 1; i < argc; i++)
+	{
+		const std::string arg     = argv[i];
+		const bool        hasNext = i + 1 < argc;
+
+		if (arg == "--out" && hasNext)
+			outPath = argv[++i];
+		else if (arg == "--filter" && hasNext)
+			options.filter = argv[++i];
+		else if (arg == "--samples" && hasNext)
+			options.samples = std::max(1, u::string::toInt(argv[++i]));
+		else if (arg == "--min-time" && hasNext)
+			options.minTimeMs = std::max(1, u::string::toInt(argv[++i]));
+		else if (arg == "--list")
+			options.listOnly = true;
+		else
+		{
+			printUsage_();
+			return arg == "--help" ? EXIT_SUCCESS : EXIT_FAILURE;
+		}
+	}
+
+	u::log::init(LOG_MODE_MUTE);
+
+	bench::Suite suite(options);
+
+	bench::benchWaveReader(suite);
+	bench::benchResampler(suite);
+	bench::benchWaveFx(suite);
+	bench::benchSequencer(suite);
+	bench::benchModel(suite);
+	bench::benchMixer(suite);
+
+	if (options.listOnly)
+		return EXIT_SUCCESS;
+
+	const std::string json = suite.toJson().dump(4);
+
+	if (outPath.empty())
+	{
+		fmt::print("{}\n", json);
+		return EXIT_SUCCESS;
+	}
+
+	std::ofstream file(outPath);
+	if (!file.is_open())
+	{
+		fmt::print(stderr, "Can't write results to {}\n", outPath);
+		return EXIT_FAILURE;
+	}
+	file << json << "\n";
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,57 @@
+#include "../src/core/const.h"
+#include "../src/core/mixer.h"
+#include "../src/core/model/model.h"
+#include "../src/core/wave.h"
+#include "deps/mcl-audio-buffer/src/audioBuffer.hpp"
+#include "fixtures.h"
+#include "suite.h"
+#include <cmath>
+#include <fmt/core.h>
+
+namespace giada::bench
+{
+void benchMixer(Suite& suite)
+{
+	constexpr int SAMPLE_RATE  = 44100;
+	constexpr int BUFFER_SIZE  = 256;
+	constexpr int NUM_CHANNELS = 2;
+
+	m::Wave wave(0);
+	wave.alloc(SAMPLE_RATE * 10, NUM_CHANNELS, SAMPLE_RATE, 32, "bench.wav");
+	wave.getWritableBuffer().forEachFrame([](float* f, int i) {
+		f[0] = std::sin(i * 0.01f) * 0.1f;
+		f[1] = std::cos(i * 0.01f) * 0.1f;
+	});
+
+	mcl::AudioBuffer out(BUFFER_SIZE, NUM_CHANNELS);
+	mcl::AudioBuffer in; // No input
+
+	for (const int renderThreads : {0, G_DEFAULT_RENDER_THREADS})
+	{
+		for (const int numChannels : {8, 32, 128})
+		{
+			m::model::Model model;
+			m::Mixer        mixer(model);
+
+			makeLayout(model, numChannels, BUFFER_SIZE, wave);
+			mixer.reset(SAMPLE_RATE, BUFFER_SIZE);
+			mixer.startRenderPool(renderThreads, BUFFER_SIZE, SAMPLE_RATE);
+
+			/* As in Engine::renderOffline(), no realtime thread is running: the
+			Layout can be read directly. */
+
+			const m::model::Layout& layout = model.get();
+
+			suite.run(fmt::format("Mixer::render/channels={}/threads={}", numChannels,
+			              renderThreads == 0 ? "0" : "auto"),
+			    [&]() {
+				    out.clear();
+				    mixer.render(out, in, layout, /*maxFramesToRec=*/SAMPLE_RATE);
+				    doNotOptimize(out[0][0]);
+			    });
+
+			mixer.stopRenderPool();
+		}
+	}
+}
+} // namespace giada::bench
@@ -0,0 +1,30 @@
+#include "../src/core/model/model.h"
+#include "../src/core/wave.h"
+#include "fixtures.h"
+#include "suite.h"
+#include <fmt/core.h>
+
+namespace giada::bench
+{
+void benchModel(Suite& suite)
+{
+	constexpr int SAMPLE_RATE = 44100;
+	constexpr int BUFFER_SIZE = 1024;
+
+	m::Wave wave(0);
+	wave.alloc(SAMPLE_RATE, 2, SAMPLE_RATE, 32, "bench.wav");
+
+	for (const int numChannels : {16, 128, 1024})
+	{
+		m::model::Model model;
+		makeLayout(model, numChannels, BUFFER_SIZE, wave);
+
+		/* A swap copies the whole non-realtime Layout into the realtime one. No
+		realtime thread is reading it here, so this measures the copy alone. */
+
+		suite.run(fmt::format("model::Model::swap/channels={}", numChannels), [&]() {
+			model.swap(m::model::SwapType::HARD);
+		});
+	}
+}
+} // namespace giada::bench
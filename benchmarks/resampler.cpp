@@ -0,0 +1,47 @@
+#include "../src/core/resampler.h"
+#include "suite.h"
+#include <cmath>
+#include <fmt/core.h>
+#include <vector>
+
+namespace giada::bench
+{
+void benchResampler(Suite& suite)
+{
+	constexpr int  BUFFER_SIZE  = 1024;
+	constexpr int  NUM_CHANNELS = 2;
+	constexpr long INPUT_SIZE   = 44100 * 10;
+
+	std::vector<float> input(INPUT_SIZE * NUM_CHANNELS);
+	std::vector<float> output(BUFFER_SIZE * NUM_CHANNELS);
+
+	for (std::size_t i = 0; i < input.size(); i++)
+		input[i] = std::sin(i * 0.01f);
+
+	for (const auto& [quality, label] : {
+	         std::pair{m::Resampler::Quality::LINEAR, "linear"},
+	         std::pair{m::Resampler::Quality::ZERO_ORDER_HOLD, "zoh"},
+	         std::pair{m::Resampler::Quality::SINC_FASTEST, "sinc-fastest"},
+	         std::pair{m::Resampler::Quality::SINC_MEDIUM, "sinc-medium"},
+	         std::pair{m::Resampler::Quality::SINC_BEST, "sinc-best"}})
+	{
+		for (const float ratio : {0.5f, 1.5f})
+		{
+			m::Resampler resampler(quality, NUM_CHANNELS);
+
+			long inputPos = 0;
+			suite.run(fmt::format("Resampler::process/{}/ratio={}", label, ratio), [&]() {
+				const m::Resampler::Result res = resampler.process(input.data(), inputPos, INPUT_SIZE,
+				    NUM_CHANNELS, output.data(), BUFFER_SIZE, ratio);
+				inputPos += res.used;
+				if (inputPos >= INPUT_SIZE - BUFFER_SIZE * 2)
+				{
+					resampler.last();
+					inputPos = 0;
+				}
+				doNotOptimize(output[0]);
+			});
+		}
+	}
+}
+} // namespace giada::bench
@@ -0,0 +1,70 @@
+#include "../src/core/actions/action.h"
+#include "../src/core/jackTransport.h"
+#include "../src/core/kernelMidi.h"
+#include "../src/core/midiEvent.h"
+#include "../src/core/midiSynchronizer.h"
+#include "../src/core/model/actions.h"
+#include "../src/core/model/model.h"
+#include "../src/core/sequencer.h"
+#include "suite.h"
+#include <algorithm>
+#include <fmt/core.h>
+
+namespace giada::bench
+{
+void benchSequencer(Suite& suite)
+{
+	constexpr int SAMPLE_RATE       = 44100;
+	constexpr int BUFFER_SIZE       = 256;
+	constexpr int ACTIONS_PER_FRAME = 4; // i.e. 4 channels triggered together
+	constexpr int NOTE_ON           = 0x90;
+	constexpr int NOTE_OFF          = 0x80;
+
+	m::model::Model     model;
+	m::KernelMidi       kernelMidi(model);
+	m::MidiSynchronizer midiSynchronizer(kernelMidi);
+	m::JackTransport    jackTransport;
+	m::Sequencer        sequencer(model, midiSynchronizer, jackTransport);
+
+	model.init();
+	sequencer.reset(SAMPLE_RATE);
+
+	const Frame framesInLoop = sequencer.getFramesInLoop();
+
+	for (const int numActions : {1000, 10000, 100000})
+	{
+		/* Spread actions evenly across the loop, alternating note on and note off
+		events. */
+
+		const int   numKeyFrames = numActions / ACTIONS_PER_FRAME;
+		const Frame step         = std::max<Frame>(1, framesInLoop / numKeyFrames);
+
+		m::model::Actions::Map map;
+		ID                     id = 1;
+		for (int i = 0; i < numKeyFrames; i++)
+		{
+			const Frame frame  = (i * step) % framesInLoop;
+			const int   status = i % 2 == 0 ? NOTE_ON : NOTE_OFF;
+			for (int c = 0; c < ACTIONS_PER_FRAME; c++)
+			{
+				m::Action a;
+				a.id        = id++;
+				a.channelId = c + 1;
+				a.frame     = frame;
+				a.event     = m::MidiEvent::makeFrom3Bytes(status, 60, 127);
+				map[frame].push_back(a);
+			}
+		}
+
+		m::model::Actions actions;
+		actions.set(std::move(map));
+
+		const m::model::Sequencer& sequencerLayout = model.get().sequencer;
+
+		suite.run(fmt::format("Sequencer::advance/actions={}", numActions), [&]() {
+			const m::Sequencer::EventBuffer& events = sequencer.advance(sequencerLayout, BUFFER_SIZE, SAMPLE_RATE, actions);
+			doNotOptimize(events.size());
+		});
+	}
+}
+} // namespace giada::bench
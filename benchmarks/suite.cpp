@@ -0,0 +1,160 @@
+#include "suite.h"
+#include "../src/core/const.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <ctime>
+#include <fmt/core.h>
+#include <numeric>
+
+namespace giada::bench
+{
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+/* measure_
+Returns the time in nanoseconds spent running 'f' for 'iterations' times. */
+
+double measure_(const std::function<void()>& f, std::size_t iterations)
+{
+	const Clock::time_point start = Clock::now();
+	for (std::size_t i = 0; i < iterations; i++)
+		f();
+	return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+/* -------------------------------------------------------------------------- */
+
+std::string getCompiler_()
+{
+#if defined(__clang__)
+	return fmt::format("clang {}.{}.{}", __clang_major__, __clang_minor__, __clang_patchlevel__);
+#elif defined(__GNUC__)
+	return fmt::format("gcc {}.{}.{}", __GNUC__, __GNUC_MINOR__, __GNUC_PATCHLEVEL__);
+#elif defined(_MSC_VER)
+	return fmt::format("msvc {}", _MSC_VER);
+#else
+	return "unknown";
+#endif
+}
+
+/* -------------------------------------------------------------------------- */
+
+std::string getDate_()
+{
+	const std::time_t now = std::time(nullptr);
+	char              buf[32];
+	std::strftime(buf, sizeof(buf), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+	return buf;
+}
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+Suite::Suite(Options o)
+: m_options(o)
+{
+}
+
+/* -------------------------------------------------------------------------- */
+
+const std::vector<Suite::Result>& Suite::getResults() const { return m_results; }
+
+/* -------------------------------------------------------------------------- */
+
+bool Suite::shouldRun(const std::string& name) const
+{
+	return m_options.filter.empty() || name.find(m_options.filter) != std::string::npos;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Suite::run(const std::string& name, std::function<void()> f)
+{
+	if (!shouldRun(name))
+		return;
+
+	if (m_options.listOnly)
+	{
+		fmt::print("{}\n", name);
+		return;
+	}
+
+	/* Calibration: double the iterations until a sample is long enough. */
+
+	const double minTimeNs  = m_options.minTimeMs * 1000000.0;
+	std::size_t  iterations = 1;
+	while (measure_(f, iterations) < minTimeNs && iterations < (1u << 30))
+		iterations *= 2;
+
+	std::vector<double> samples(m_options.samples);
+	for (double& s : samples)
+		s = measure_(f, iterations) / iterations;
+
+	std::sort(samples.begin(), samples.end());
+
+	const std::size_t count  = samples.size();
+	const double      mean   = std::accumulate(samples.begin(), samples.end(), 0.0) / count;
+	const double      median = count % 2 == 0 ? (samples[count / 2 - 1] + samples[count / 2]) / 2.0 : samples[count / 2];
+
+	double variance = 0.0;
+	for (double s : samples)
+		variance += (s - mean) * (s - mean);
+	variance /= count;
+
+	Result result;
+	result.name       = name;
+	result.iterations = iterations;
+	result.samples    = static_cast<int>(count);
+	result.min        = samples.front();
+	result.median     = median;
+	result.mean       = mean;
+	result.max        = samples.back();
+	result.stddev     = std::sqrt(variance);
+
+	fmt::print(stderr, "{:<48} {:>14.1f} ns (min {:.1f}, max {:.1f}, stddev {:.1f}) x {}\n",
+	    name, result.median, result.min, result.max, result.stddev, iterations);
+
+	m_results.push_back(result);
+}
+
+/* -------------------------------------------------------------------------- */
+
+nlohmann::json Suite::toJson() const
+{
+	nlohmann::json j;
+
+	j["version"]  = G_VERSION_STR;
+	j["date"]     = getDate_();
+	j["compiler"] = getCompiler_();
+#ifdef NDEBUG
+	j["build"] = "release";
+#else
+	j["build"] = "debug";
+#endif
+	j["samples"]   = m_options.samples;
+	j["minTimeMs"] = m_options.minTimeMs;
+	j["unit"]      = "ns";
+
+	nlohmann::json benchmarks = nlohmann::json::array();
+	for (const Result& r : m_results)
+	{
+		benchmarks.push_back({
+		    {"name", r.name},
+		    {"iterations", r.iterations},
+		    {"samples", r.samples},
+		    {"min", r.min},
+		    {"median", r.median},
+		    {"mean", r.mean},
+		    {"max", r.max},
+		    {"stddev", r.stddev},
+		});
+	}
+	j["benchmarks"] = benchmarks;
+
+	return j;
+}
+} // namespace giada::bench
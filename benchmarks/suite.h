@@ -0,0 +1,97 @@
+#ifndef G_BENCH_SUITE_H
+#define G_BENCH_SUITE_H
+
+#include <cstddef>
+#include <functional>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <vector>
+
+namespace giada::bench
+{
+/* doNotOptimize
+Prevents the compiler from optimizing away a computation whose result is never
+used otherwise. */
+
+#if defined(__GNUC__) || defined(__clang__)
+template <typename T>
+inline void doNotOptimize(const T& v)
+{
+	asm volatile("" : : "r,m"(v) : "memory");
+}
+#else
+inline const void* volatile sink_ = nullptr;
+
+template <typename T>
+inline void doNotOptimize(const T& v)
+{
+	sink_ = &v;
+}
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+class Suite
+{
+public:
+	struct Options
+	{
+		int         samples   = 20;   // Number of timed samples per benchmark
+		double      minTimeMs = 10.0; // Minimum duration of a single sample
+		std::string filter    = "";   // Run only benchmarks containing this text
+		bool        listOnly  = false; // Print names, don't run anything
+	};
+
+	/* Result
+	Statistics of a single benchmark, in nanoseconds per iteration. */
+
+	struct Result
+	{
+		std::string name;
+		std::size_t iterations = 0; // Iterations per sample
+		int         samples    = 0;
+		double      min        = 0.0;
+		double      median     = 0.0;
+		double      mean       = 0.0;
+		double      max        = 0.0;
+		double      stddev     = 0.0;
+	};
+
+	Suite(Options);
+
+	/* run
+	Runs the benchmark 'f', unless filtered out. The number of iterations per
+	sample is calibrated first (which also warms up caches and allocations) so
+	that each sample lasts at least Options::minTimeMs. A summary line is
+	printed to stderr, so that stdout can be used for JSON. */
+
+	void run(const std::string& name, std::function<void()> f);
+
+	/* toJson
+	Returns all results collected so far, plus some information on the build
+	and the run, as a JSON object. */
+
+	nlohmann::json toJson() const;
+
+	const std::vector<Result>& getResults() const;
+
+private:
+	bool shouldRun(const std::string& name) const;
+
+	Options             m_options;
+	std::vector<Result> m_results;
+};
+
+/* -------------------------------------------------------------------------- */
+
+/* Benchmark groups, one per file. */
+
+void benchWaveReader(Suite&);
+void benchResampler(Suite&);
+void benchWaveFx(Suite&);
+void benchSequencer(Suite&);
+void benchModel(Suite&);
+void benchMixer(Suite&);
+} // namespace giada::bench
+
+#endif
@@ -0,0 +1,54 @@
+#include "../src/core/waveFx.h"
+#include "../src/core/wave.h"
+#include "suite.h"
+#include <cmath>
+
+namespace giada::bench
+{
+void benchWaveFx(Suite& suite)
+{
+	constexpr int SAMPLE_RATE  = 44100;
+	constexpr int NUM_CHANNELS = 2;
+	constexpr int WAVE_SIZE    = SAMPLE_RATE * 10;
+
+	m::Wave wave(0);
+	wave.alloc(WAVE_SIZE, NUM_CHANNELS, SAMPLE_RATE, 32, "bench.wav");
+	wave.getWritableBuffer().forEachFrame([](float* f, int i) {
+		f[0] = std::sin(i * 0.01f) * 0.5f;
+		f[1] = std::cos(i * 0.01f) * 0.5f;
+	});
+
+	/* All operations run in place over the whole wave (10 seconds of stereo 
+	audio). The data changes on each iteration, but the amount of work doesn't. */
+
+	suite.run("wfx::normalize", [&]() {
+		m::wfx::normalize(wave, 0, WAVE_SIZE);
+		doNotOptimize(wave.getBuffer()[0][0]);
+	});
+
+	suite.run("wfx::fade", [&]() {
+		m::wfx::fade(wave, 0, WAVE_SIZE - 1, m::wfx::Fade::IN);
+		doNotOptimize(wave.getBuffer()[0][0]);
+	});
+
+	suite.run("wfx::smooth", [&]() {
+		m::wfx::smooth(wave, 0, WAVE_SIZE - 1);
+		doNotOptimize(wave.getBuffer()[0][0]);
+	});
+
+	suite.run("wfx::reverse", [&]() {
+		m::wfx::reverse(wave, 0, WAVE_SIZE);
+		doNotOptimize(wave.getBuffer()[0][0]);
+	});
+
+	suite.run("wfx::shift", [&]() {
+		m::wfx::shift(wave, SAMPLE_RATE / 10);
+		doNotOptimize(wave.getBuffer()[0][0]);
+	});
+
+	suite.run("wfx::silence", [&]() {
+		m::wfx::silence(wave, 0, WAVE_SIZE);
+		doNotOptimize(wave.getBuffer()[0][0]);
+	});
+}
+} // namespace giada::bench
@@ -0,0 +1,68 @@
+#include "../src/core/channels/waveReader.h"
+#include "../src/core/resampler.h"
+#include "../src/core/wave.h"
+#include "deps/mcl-audio-buffer/src/audioBuffer.hpp"
+#include "suite.h"
+#include <cmath>
+#include <fmt/core.h>
+
+namespace giada::bench
+{
+void benchWaveReader(Suite& suite)
+{
+	constexpr int   SAMPLE_RATE  = 44100;
+	constexpr int   BUFFER_SIZE  = 1024;
+	constexpr int   NUM_CHANNELS = 2;
+	constexpr Frame WAVE_SIZE    = SAMPLE_RATE * 10;
+
+	m::Wave wave(0);
+	wave.alloc(WAVE_SIZE, NUM_CHANNELS, SAMPLE_RATE, 32, "bench.wav");
+	wave.getWritableBuffer().forEachFrame([](float* f, int i) {
+		f[0] = std::sin(i * 0.01f);
+		f[1] = std::cos(i * 0.01f);
+	});
+
+	mcl::AudioBuffer out(BUFFER_SIZE, NUM_CHANNELS);
+
+	/* Copy path, pitch == 1.0. */
+
+	{
+		m::WaveReader waveReader(nullptr);
+		waveReader.wave = &wave;
+
+		Frame tracker = 0;
+		suite.run("WaveReader::fill/copy", [&]() {
+			const m::WaveReader::Result res = waveReader.fill(out, tracker, WAVE_SIZE, 0, 1.0f);
+			tracker                         = (tracker + res.used) % (WAVE_SIZE - BUFFER_SIZE);
+			doNotOptimize(out[0][0]);
+		});
+	}
+
+	/* Resampled path, pitch != 1.0, for the qualities available to users. */
+
+	for (const auto& [quality, label] : {
+	         std::pair{m::Resampler::Quality::LINEAR, "linear"},
+	         std::pair{m::Resampler::Quality::SINC_FASTEST, "sinc-fastest"},
+	         std::pair{m::Resampler::Quality::SINC_BEST, "sinc-best"}})
+	{
+		for (const float pitch : {0.5f, 1.5f})
+		{
+			m::Resampler  resampler(quality, NUM_CHANNELS);
+			m::WaveReader waveReader(&resampler);
+			waveReader.wave = &wave;
+
+			Frame tracker = 0;
+			suite.run(fmt::format("WaveReader::fill/resampled/{}/pitch={}", label, pitch), [&]() {
+				const m::WaveReader::Result res = waveReader.fill(out, tracker, WAVE_SIZE, 0, pitch);
+				tracker += res.used;
+				if (tracker >= WAVE_SIZE - BUFFER_SIZE * 2)
+				{
+					waveReader.last();
+					tracker = 0;
+				}
+				doNotOptimize(out[0][0]);
+			});
+		}
+	}
+}
+} // namespace giada::bench
@@ -0,0 +1,55 @@
+#!/usr/bin/env python3
+#
+# Compares two JSON files produced by 'giada-bench --out <file>', e.g. one from
+# the base commit and one from a branch. Prints the change of the median time
+# for each benchmark found in both files, and flags those slower than the given
+# threshold. Exits with status 1 if any regression is found.
+#
+# Usage:
+#   compare_benchmarks.py <baseline.json> <candidate.json> [--threshold <pct>]
+#
+# Requirements:
+# - python >= 3.6
+
+import argparse
+import json
+import sys
+
+
+def load(path):
+    with open(path) as f:
+        data = json.load(f)
+    return {b["name"]: b for b in data["benchmarks"]}
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare giada-bench results.")
+    parser.add_argument("baseline")
+    parser.add_argument("candidate")
+    parser.add_argument("--threshold", type=float, default=5.0,
+                        help="regression threshold, in percent (default: 5)")
+    args = parser.parse_args()
+
+    baseline = load(args.baseline)
+    candidate = load(args.candidate)
+
+    regressions = 0
+    width = max((len(name) for name in baseline), default=0)
+
+    for name, base in baseline.items():
+        if name not in candidate:
+            continue
+        before = base["median"]
+        after = candidate[name]["median"]
+        delta = (after - before) / before * 100.0 if before > 0 else 0.0
+        flag = ""
+        if delta > args.threshold:
+            flag = "  <-- REGRESSION"
+            regressions += 1
+        print(f"{name:<{width}}  {before:>14.1f}  {after:>14.1f}  {delta:>+7.1f}%{flag}")
+
+    return 1 if regressions > 0 else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -30,12 +30,13 @@
 #include "core/kernelAudio.h"
 #include "core/midiSynchronizer.h"
 #include "core/mixer.h"
+#include "core/waveLoader.h"
 #include "utils/fs.h"
 
 namespace giada::m
 {
 ChannelsApi::ChannelsApi(model::Model& m, KernelAudio& k, Mixer& mx, Sequencer& s,
-    ChannelManager& cm, Recorder& r, ActionRecorder& ar, PluginHost& ph, PluginManager& pm)
+    ChannelManager& cm, Recorder& r, ActionRecorder& ar, PluginHost& ph, PluginManager& pm, WaveLoader& wl)
 : m_model(m)
 , m_kernelAudio(k)
 , m_mixer(mx)
@@ -45,6 +46,7 @@ ChannelsApi::ChannelsApi(model::Model& m, KernelAudio& k, Mixer& mx, Sequencer&
 , m_actionRecorder(ar)
 , m_pluginHost(ph)
 , m_pluginManager(pm)
+, m_waveLoader(wl)
 {
 }
 
@@ -160,6 +162,18 @@ void ChannelsApi::press(ID channelId, int velocity)
 	const bool  canRecordActions = m_recorder.canRecordActions();
 	const bool  canQuantize      = m_sequencer.canQuantize();
 	const Frame currentFrameQ    = m_sequencer.getCurrentFrameQuantized();
+
+	/* A channel whose Wave is still loading in the background gets it loaded
+	next. The press is replayed as soon as the Wave is in place, but recorded
+	as an action right now, where it belongs. */
+
+	if (m_waveLoader.press(channelId, velocity, m_sequencer.getCurrentFrame()))
+	{
+		if (canRecordActions)
+			m_channelManager.recordKeyPress(channelId, currentFrameQ);
+		return;
+	}
+
 	m_channelManager.keyPress(channelId, velocity, canRecordActions, canQuantize, currentFrameQ);
 }
 
@@ -167,6 +181,16 @@ void ChannelsApi::release(ID channelId)
 {
 	const bool  canRecordActions = m_recorder.canRecordActions();
 	const Frame currentFrameQ    = m_sequencer.getCurrentFrameQuantized();
+
+	/* Same as above for a press still waiting to be replayed. */
+
+	if (m_waveLoader.release(channelId))
+	{
+		if (canRecordActions)
+			m_channelManager.recordKeyRelease(channelId, currentFrameQ);
+		return;
+	}
+
 	m_channelManager.keyRelease(channelId, canRecordActions, currentFrameQ);
 }
 
@@ -46,12 +46,13 @@ class Recorder;
 class ActionRecorder;
 class PluginHost;
 class PluginManager;
+class WaveLoader;
 class Wave;
 class ChannelsApi
 {
 public:
 	ChannelsApi(model::Model&, KernelAudio&, Mixer&, Sequencer&, ChannelManager&,
-	    Recorder&, ActionRecorder&, PluginHost&, PluginManager&);
+	    Recorder&, ActionRecorder&, PluginHost&, PluginManager&, WaveLoader&);
 
 	bool hasChannelsWithAudioData() const;
 	bool hasChannelsWithActions() const;
@@ -102,6 +103,7 @@ private:
 	ActionRecorder& m_actionRecorder;
 	PluginHost&     m_pluginHost;
 	PluginManager&  m_pluginManager;
+	WaveLoader&     m_waveLoader;
 };
 } // namespace giada::m
 
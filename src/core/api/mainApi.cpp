@@ -33,13 +33,14 @@
 
 namespace giada::m
 {
-MainApi::MainApi(KernelAudio& ka, Mixer& m, Sequencer& s, MidiSynchronizer& ms, ChannelManager& cm, Recorder& r)
+MainApi::MainApi(KernelAudio& ka, Mixer& m, Sequencer& s, MidiSynchronizer& ms, ChannelManager& cm, Recorder& r, LoadMonitor& lm)
 : m_kernelAudio(ka)
 , m_mixer(m)
 , m_sequencer(s)
 , m_midiSynchronizer(ms)
 , m_channelManager(cm)
 , m_recorder(r)
+, m_loadMonitor(lm)
 {
 }
 
@@ -302,4 +303,21 @@ void MainApi::startActionRecOnCallback()
 {
 	m_recorder.startActionRecOnCallback();
 }
+
+/* -------------------------------------------------------------------------- */
+
+LoadMonitor::Stats MainApi::getLoadStats() const
+{
+	return m_loadMonitor.getStats();
+}
+
+void MainApi::resetLoadStats()
+{
+	m_loadMonitor.reset();
+}
+
+void MainApi::dumpLoadStats() const
+{
+	m_loadMonitor.dump();
+}
 } // namespace giada::m
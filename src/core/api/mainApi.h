@@ -27,6 +27,7 @@
 #ifndef G_MAIN_API_H
 #define G_MAIN_API_H
 
+#include "core/loadMonitor.h"
 #include "core/mixer.h"
 
 namespace giada::m
@@ -40,29 +41,30 @@ class Recorder;
 class MainApi
 {
 public:
-	MainApi(KernelAudio&, Mixer&, Sequencer&, MidiSynchronizer&, ChannelManager&, Recorder&);
+	MainApi(KernelAudio&, Mixer&, Sequencer&, MidiSynchronizer&, ChannelManager&, Recorder&, LoadMonitor&);
 
-	bool              isRecordingInput() const;
-	bool              isRecordingActions() const;
-	bool              isSequencerRunning() const;
-	RecTriggerMode    getRecTriggerMode() const;
-	InputRecMode      getInputRecMode() const;
-	bool              isMetronomeOn() const;
-	bool              getInToOut() const;
-	Peak              getPeakOut() const;
-	Peak              getPeakIn() const;
-	Mixer::RecordInfo getRecordInfo() const;
-	int               getBeats() const;
-	int               getBars() const;
-	float             getBpm() const;
-	int               getQuantizerValue() const;
-	int               getCurrentBeat() const;
-	Frame             getCurrentFrame() const;
-	int               getFramesInBar() const;
-	int               getFramesInLoop() const;
-	int               getFramesInSeq() const;
-	int               getFramesInBeat() const;
-	SeqStatus         getSequencerStatus() const;
+	bool               isRecordingInput() const;
+	bool               isRecordingActions() const;
+	bool               isSequencerRunning() const;
+	RecTriggerMode     getRecTriggerMode() const;
+	InputRecMode       getInputRecMode() const;
+	bool               isMetronomeOn() const;
+	bool               getInToOut() const;
+	Peak               getPeakOut() const;
+	Peak               getPeakIn() const;
+	Mixer::RecordInfo  getRecordInfo() const;
+	int                getBeats() const;
+	int                getBars() const;
+	float              getBpm() const;
+	int                getQuantizerValue() const;
+	int                getCurrentBeat() const;
+	Frame              getCurrentFrame() const;
+	int                getFramesInBar() const;
+	int                getFramesInLoop() const;
+	int                getFramesInSeq() const;
+	int                getFramesInBeat() const;
+	SeqStatus          getSequencerStatus() const;
+	LoadMonitor::Stats getLoadStats() const;
 
 	void toggleMetronome();
 	void setMasterInVolume(float);
@@ -85,6 +87,8 @@ public:
 	void stopInputRecording();
 	void toggleInputRecording();
 	void startActionRecOnCallback();
+	void resetLoadStats();
+	void dumpLoadStats() const;
 
 private:
 	KernelAudio&      m_kernelAudio;
@@ -93,6 +97,7 @@ private:
 	MidiSynchronizer& m_midiSynchronizer;
 	ChannelManager&   m_channelManager;
 	Recorder&         m_recorder;
+	LoadMonitor&      m_loadMonitor;
 };
 } // namespace giada::m
 
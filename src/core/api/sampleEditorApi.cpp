@@ -189,6 +189,18 @@ void SampleEditorApi::reload(ID channelId)
 
 /* -------------------------------------------------------------------------- */
 
+void SampleEditorApi::expand(ID channelId)
+{
+	Wave& wave = getWave(channelId);
+	if (!wave.isCompact())
+		return;
+
+	model::DataLock lock = m_model.lockData();
+	wave.expand();
+}
+
+/* -------------------------------------------------------------------------- */
+
 Wave& SampleEditorApi::getWave(ID channelId) const
 {
 	Channel&      ch           = m_channelManager.getChannel(channelId);
@@ -57,6 +57,12 @@ public:
 	void resetBeginEnd(ID channelId);
 	void reload(ID channelId);
 
+	/* expand
+	Converts a compact Wave back to float, so that it can be displayed and
+	edited. Does nothing if the Wave is not compact. */
+
+	void expand(ID channelId);
+
 private:
 	Wave& getWave(ID channelId) const;
 
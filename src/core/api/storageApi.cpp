@@ -26,20 +26,86 @@
 
 #include "storageApi.h"
 #include "core/actions/actionFactory.h"
+#include "core/audioFileWriter.h"
 #include "core/channels/channelFactory.h"
 #include "core/engine.h"
 #include "core/midiSynchronizer.h"
 #include "core/model/model.h"
 #include "core/patchFactory.h"
 #include "core/plugins/pluginFactory.h"
+#include "core/wave.h"
 #include "core/waveFactory.h"
+#include "core/waveLoader.h"
+#include "deps/mcl-audio-buffer/src/audioBuffer.hpp"
 #include "utils/fs.h"
 #include "utils/log.h"
+#include "utils/vector.h"
+#include <algorithm>
+#include <tuple>
 
 namespace giada::m
 {
+namespace
+{
+/* PROGRESS_*
+Loading progress reached at the end of each stage of loadProject(). */
+
+constexpr float PROGRESS_PATCH_ = 0.05f;
+constexpr float PROGRESS_MODEL_ = 0.9f;
+
+/* -------------------------------------------------------------------------- */
+
+/* makeWaveRequests_
+Lists the Waves of a Patch in the order they should be loaded in background:
+Waves of channels that read actions first, as they may start playing on their
+own, then column by column from left to right (the columns shown first in the
+main window) and from top to bottom. */
+
+std::vector<WaveLoader::Request> makeWaveRequests_(const Patch& patch)
+{
+	auto getColumnIndex = [&patch](ID columnId) {
+		return std::find_if(patch.columns.begin(), patch.columns.end(), [columnId](const Patch::Column& c) { return c.id == columnId; }) - patch.columns.begin();
+	};
+
+	auto getRank = [&getColumnIndex](const Patch::Channel& c) {
+		return std::tuple(!c.readActions, getColumnIndex(c.columnId), c.position);
+	};
+
+	std::vector<const Patch::Channel*> channels;
+	for (const Patch::Channel& c : patch.channels)
+		if (c.waveId != 0)
+			channels.push_back(&c);
+
+	std::stable_sort(channels.begin(), channels.end(), [&getRank](const Patch::Channel* a, const Patch::Channel* b) {
+		return getRank(*a) < getRank(*b);
+	});
+
+	/* A Wave shared by multiple channels is loaded once, for all of them. */
+
+	std::vector<WaveLoader::Request> requests;
+	for (const Patch::Channel* c : channels)
+	{
+		auto request = std::find_if(requests.begin(), requests.end(), [c](const WaveLoader::Request& r) { return r.wave.id == c->waveId; });
+		if (request != requests.end())
+		{
+			request->channelIds.push_back(c->id);
+			continue;
+		}
+		auto wave = std::find_if(patch.waves.begin(), patch.waves.end(), [c](const Patch::Wave& w) { return w.id == c->waveId; });
+		if (wave != patch.waves.end())
+			requests.push_back({*wave, {c->id}});
+	}
+
+	return requests;
+}
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
 StorageApi::StorageApi(Engine& e, model::Model& m, PluginManager& pm, MidiSynchronizer& ms,
-    Mixer& mx, ChannelManager& cm, KernelAudio& ka, Sequencer& s, ActionRecorder& ar)
+    Mixer& mx, ChannelManager& cm, KernelAudio& ka, Sequencer& s, ActionRecorder& ar, WaveLoader& wl)
 : m_engine(e)
 , m_model(m)
 , m_pluginManager(pm)
@@ -49,6 +115,8 @@ StorageApi::StorageApi(Engine& e, model::Model& m, PluginManager& pm, MidiSynchr
 , m_kernelAudio(ka)
 , m_sequencer(s)
 , m_actionRecorder(ar)
+, m_waveLoader(wl)
+, m_lazySampleRateRatio(1.0f)
 {
 }
 
@@ -104,7 +172,9 @@ model::LoadState StorageApi::loadProject(const std::string& projectPath, PluginM
 
 	progress(0.0f);
 
-	/* Read the selected project's patch. */
+	/* Read the selected project's patch. Progress is split in stages: reading
+	the patch, loading the model (most of the time, spent on samples and
+	plug-ins) and preparing the engine. */
 
 	const std::string patchPath = u::fs::join(projectPath, u::fs::stripExt(u::fs::basename(projectPath)) + G_PATCH_EXT);
 	const Patch       patch     = patchFactory::deserialize(patchPath);
@@ -112,9 +182,11 @@ model::LoadState StorageApi::loadProject(const std::string& projectPath, PluginM
 	if (patch.status != G_FILE_OK)
 		return {};
 
-	progress(0.3f);
+	progress(PROGRESS_PATCH_);
 
-	/* Then suspend Mixer, MIDI synch and reset the engine. */
+	/* Then suspend Mixer, MIDI synch and reset the engine. Resetting the engine
+	also drops samples still being loaded in background for the current
+	project, if any. */
 
 	m_midiSynchronizer.stopSendClock();
 	m_mixer.disable();
@@ -122,12 +194,14 @@ model::LoadState StorageApi::loadProject(const std::string& projectPath, PluginM
 
 	/* Load the patch into Model. */
 
-	const int                sampleRate  = m_kernelAudio.getSampleRate();
-	const int                bufferSize  = m_kernelAudio.getBufferSize();
-	const Resampler::Quality rsmpQuality = m_kernelAudio.getResamplerQuality();
-	const model::LoadState   state       = m_model.load(patch, m_pluginManager, sampleRate, bufferSize, rsmpQuality);
+	const int                sampleRate    = m_kernelAudio.getSampleRate();
+	const int                bufferSize    = m_kernelAudio.getBufferSize();
+	const Resampler::Quality rsmpQuality   = m_kernelAudio.getResamplerQuality();
+	const bool               lazyWaves     = m_model.get().kernelAudio.lazyWaveLoading;
+	const auto               modelProgress = [&progress](float v) { progress(PROGRESS_PATCH_ + v * (PROGRESS_MODEL_ - PROGRESS_PATCH_)); };
+	const model::LoadState   state         = m_model.load(patch, m_pluginManager, sampleRate, bufferSize, rsmpQuality, lazyWaves, modelProgress);
 
-	progress(0.6f);
+	progress(PROGRESS_MODEL_);
 
 	/* Prepare the engine. Recorder has to recompute the actions positions if
 	the current samplerate != patch samplerate. Clock needs to update frames
@@ -141,15 +215,240 @@ model::LoadState StorageApi::loadProject(const std::string& projectPath, PluginM
 	m_sequencer.recomputeFrames(sampleRate);
 	m_mixer.allocRecBuffer(maxFramesInLoop);
 
-	progress(0.9f);
-
 	/* Bring everything back online. */
 
 	m_mixer.enable();
 	m_midiSynchronizer.startSendClock(m_model.get().sequencer.bpm);
 
+	/* Samples, if loaded lazily, start coming in from now on. Their IDs are
+	taken right away, so that Waves created in the meantime can't get them. */
+
+	if (lazyWaves)
+	{
+		for (const Patch::Wave& w : patch.waves)
+			waveFactory::reserveId(w.id);
+
+		m_lazySampleRateRatio = sampleRate / static_cast<float>(patch.samplerate);
+		m_waveLoader.start(makeWaveRequests_(patch), sampleRate, rsmpQuality, m_model.get().kernelAudio.streamingThreshold);
+	}
+
 	progress(1.0f);
 
 	return state;
 }
+
+/* -------------------------------------------------------------------------- */
+
+bool StorageApi::isLoadingWaves() const
+{
+	return m_waveLoader.isLoading();
+}
+
+/* -------------------------------------------------------------------------- */
+
+std::vector<std::string> StorageApi::publishLoadedWaves()
+{
+	std::vector<std::string> missingWaves;
+
+	for (WaveLoader::Result& result : m_waveLoader.collect())
+	{
+		if (result.wave == nullptr)
+			missingWaves.push_back(result.patchWave.path);
+
+		const std::vector<ID> channelIds = m_channelManager.loadLazySampleChannels(std::move(result.wave), result.channelIds, m_lazySampleRateRatio);
+
+		for (const WaveLoader::Press& press : result.presses)
+		{
+			if (!u::vector::has(channelIds, [&press](ID id) { return id == press.channelId; }))
+				continue;
+			m_channelManager.keyPressLate(press.channelId, press.velocity, press.frame, m_sequencer.canQuantize(), m_sequencer.isRunning(),
+			    m_sequencer.getCurrentFrame(), m_sequencer.getCurrentFrameQuantized());
+			if (press.released)
+				m_channelManager.keyRelease(press.channelId, /*canRecordActions=*/false, m_sequencer.getCurrentFrameQuantized());
+		}
+	}
+
+	return missingWaves;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void StorageApi::waitForWaves()
+{
+	m_waveLoader.wait();
+}
+
+/* -------------------------------------------------------------------------- */
+
+model::LoadState StorageApi::preloadProject(const std::string& projectPath, model::SwitchPoint switchPoint,
+    std::function<void(float)> progress)
+{
+	u::log::print("[StorageApi::preloadProject] Preload project from {}\n", projectPath);
+
+	progress(0.0f);
+
+	const std::string patchPath = u::fs::join(projectPath, u::fs::stripExt(u::fs::basename(projectPath)) + G_PATCH_EXT);
+	const Patch       patch     = patchFactory::deserialize(patchPath);
+
+	if (patch.status != G_FILE_OK)
+		return {};
+
+	progress(PROGRESS_PATCH_);
+
+	/* Only one project can wait for the switch. Complete the switch of the
+	previous one if it's already being played, drop it otherwise. */
+
+	commitPreloadedProject();
+	m_model.discardPreload();
+
+	/* Unlike loadProject(), Mixer and MIDI synch are left running. Samples are
+	loaded in background from now on: see armPreloadedProject(). */
+
+	const int                sampleRate    = m_kernelAudio.getSampleRate();
+	const int                bufferSize    = m_kernelAudio.getBufferSize();
+	const Resampler::Quality rsmpQuality   = m_kernelAudio.getResamplerQuality();
+	const auto               modelProgress = [&progress](float v) { progress(PROGRESS_PATCH_ + v * (1.0f - PROGRESS_PATCH_)); };
+
+	m_model.preload(patch, m_pluginManager, sampleRate, bufferSize, rsmpQuality, switchPoint, modelProgress);
+
+	progress(1.0f);
+
+	return {patch};
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool StorageApi::isPreloadedProjectLoaded() const
+{
+	return m_model.isPreloadLoaded();
+}
+
+/* -------------------------------------------------------------------------- */
+
+model::LoadState StorageApi::armPreloadedProject()
+{
+	u::log::print("[StorageApi::armPreloadedProject] Preloaded project ready for the switch\n");
+
+	return m_model.armPreload();
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool StorageApi::isPreloadedProjectReady() const
+{
+	return m_model.isPreloadReady();
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool StorageApi::commitPreloadedProject()
+{
+	if (!m_model.commitPreload())
+		return false;
+
+	/* Samples still loading for the old project are of no use anymore. */
+
+	m_waveLoader.stop();
+
+	/* Same engine preparation as in loadProject(), minus the things already
+	done on the preloaded Layout. The rec buffer can be resized safely: no
+	recording is going on right after a switch. */
+
+	const int sampleRate      = m_kernelAudio.getSampleRate();
+	const int maxFramesInLoop = m_sequencer.getMaxFramesInLoop(sampleRate);
+
+	m_mixer.updateSoloCount(m_channelManager.hasSolos());
+	m_sequencer.recomputeFrames(sampleRate);
+	m_mixer.allocRecBuffer(maxFramesInLoop);
+	m_midiSynchronizer.setClockBpm(m_sequencer.getBpm());
+
+	u::log::print("[StorageApi::commitPreloadedProject] Switched to preloaded project\n");
+
+	return true;
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool StorageApi::renderProject(const std::string& filePath, int loops, std::function<void(float)> progress)
+{
+	u::log::print("[StorageApi::renderProject] Render {} loop(s) to {}\n", loops, filePath);
+
+	const int   sampleRate  = m_kernelAudio.getSampleRate();
+	const int   bufferSize  = m_kernelAudio.getBufferSize();
+	const Frame totalFrames = m_sequencer.getFramesInLoop() * loops;
+
+	if (totalFrames <= 0)
+		return false;
+
+	AudioFileWriter writer(filePath, G_MAX_IO_CHANS, sampleRate);
+	if (!writer.isOpen())
+		return false;
+
+	progress(0.0f);
+
+	/* Offline rendering reads the current Layout only. A preloaded project the
+	audio thread has switched to is the one being played: make it the current
+	one. Any other is dropped, as in preloadProject(). */
+
+	commitPreloadedProject();
+	m_model.discardPreload();
+
+	/* Suspend realtime rendering: stop MIDI synch, Mixer and the audio stream,
+	if any. From now on audio blocks are rendered by this thread alone. The
+	sequencer state is saved, to be restored once done. */
+
+	const bool      wasStreaming = m_kernelAudio.isReady();
+	const SeqStatus seqStatus    = m_sequencer.getStatus();
+	const Frame     seqFrame     = m_sequencer.getCurrentFrame();
+
+	m_midiSynchronizer.stopSendClock();
+	m_mixer.disable();
+	if (wasStreaming)
+		m_kernelAudio.stopStream();
+
+	/* Start the sequencer and all channels from the very beginning: loops that
+	were playing start over on the first beat, anything else is stopped. */
+
+	m_sequencer.rawStop();
+	m_sequencer.rewindForced();
+	m_channelManager.resetPlayback();
+	m_sequencer.rawStart();
+
+	/* Render loop. No input is passed in: input recording and monitoring make
+	no sense offline. Progress is reported once per second of rendered audio. */
+
+	mcl::AudioBuffer out(bufferSize, G_MAX_IO_CHANS);
+	mcl::AudioBuffer in;
+	bool             success = true;
+
+	for (Frame frame = 0, nextProgress = 0; frame < totalFrames && success; frame += bufferSize)
+	{
+		m_engine.renderOffline(out, in);
+		success = writer.write(out, std::min<Frame>(bufferSize, totalFrames - frame));
+
+		if (frame >= nextProgress)
+		{
+			progress(frame / static_cast<float>(totalFrames));
+			nextProgress += sampleRate;
+		}
+	}
+
+	/* Bring everything back online, with the sequencer where it was. Channels
+	are reset again: playing loops join back on the next first beat. */
+
+	m_sequencer.rawStop();
+	m_channelManager.resetPlayback();
+	m_model.get().sequencer.a_setCurrentFrame(seqFrame, sampleRate);
+	if (seqStatus == SeqStatus::RUNNING)
+		m_sequencer.rawStart();
+
+	if (wasStreaming)
+		m_kernelAudio.startStream();
+	m_mixer.enable();
+	m_midiSynchronizer.startSendClock(m_model.get().sequencer.bpm);
+
+	progress(1.0f);
+
+	return success;
+}
 } // namespace giada::m
@@ -43,11 +43,12 @@ class ChannelManager;
 class KernelAudio;
 class Sequencer;
 class ActionRecorder;
+class WaveLoader;
 class StorageApi
 {
 public:
 	StorageApi(Engine&, model::Model&, PluginManager&, MidiSynchronizer&,
-	    Mixer&, ChannelManager&, KernelAudio&, Sequencer&, ActionRecorder&);
+	    Mixer&, ChannelManager&, KernelAudio&, Sequencer&, ActionRecorder&, WaveLoader&);
 
 	/* storeProject
 	Saves the current project. Returns true on success. */
@@ -57,10 +58,73 @@ public:
 
 	/* loadProject
 	Loads a new project. Returns a model::LoadState object containing the 
-	operation state. */
+	operation state. With lazy wave loading enabled, samples are loaded in the
+	background after this method has returned: call publishLoadedWaves()
+	periodically afterwards to bring sample channels online. */
 
 	model::LoadState loadProject(const std::string& projectPath, PluginManager::SortMethod, std::function<void(float)> progress);
 
+	/* isLoadingWaves
+	True if samples of the current project are still being loaded in the
+	background. */
+
+	bool isLoadingWaves() const;
+
+	/* publishLoadedWaves
+	Hands the samples loaded in the background so far to their channels, and
+	replays the key presses received in the meantime. Returns the paths of the
+	samples that couldn't be loaded. */
+
+	std::vector<std::string> publishLoadedWaves();
+
+	/* waitForWaves
+	Blocks until all samples have been loaded in the background. Call
+	publishLoadedWaves() afterwards. */
+
+	void waitForWaves();
+
+	/* preloadProject
+	Loads a new project in the background, while the current one keeps playing.
+	Only plug-ins are created on the calling thread. Once samples are loaded
+	(see isPreloadedProjectLoaded), call armPreloadedProject(): the audio engine
+	then switches to the new project at the next 'switchPoint', with no gap in
+	between. Call commitPreloadedProject() periodically afterwards to complete
+	the operation. Returns a model::LoadState object with the Patch only: missing
+	assets are reported by armPreloadedProject(). */
+
+	model::LoadState preloadProject(const std::string& projectPath, model::SwitchPoint, std::function<void(float)> progress);
+
+	/* isPreloadedProjectLoaded
+	Tells whether the samples of a preloaded project have been loaded. */
+
+	bool isPreloadedProjectLoaded() const;
+
+	/* armPreloadedProject
+	Queues a loaded project for the switch. Returns a model::LoadState object as
+	loadProject() does. */
+
+	model::LoadState armPreloadedProject();
+
+	/* isPreloadedProjectReady
+	Tells whether a preloaded project is ready to be committed. */
+
+	bool isPreloadedProjectReady() const;
+
+	/* commitPreloadedProject
+	Completes the switch to a preloaded project, if it has taken place. Returns
+	true if the preloaded project is now the current one. */
+
+	bool commitPreloadedProject();
+
+	/* renderProject
+	Renders 'loops' loops of the current project, from the beginning, to a WAV
+	file. Rendering happens offline on the calling thread, as fast as the CPU 
+	allows: the audio device is not used and gets paused in the meantime. A
+	preloaded project already being played becomes the current one first; one
+	still waiting for the switch is dropped. Returns true on success. */
+
+	bool renderProject(const std::string& filePath, int loops, std::function<void(float)> progress);
+
 private:
 	Engine&           m_engine;
 	model::Model&     m_model;
@@ -71,6 +135,12 @@ private:
 	KernelAudio&      m_kernelAudio;
 	Sequencer&        m_sequencer;
 	ActionRecorder&   m_actionRecorder;
+	WaveLoader&       m_waveLoader;
+
+	/* m_lazySampleRateRatio
+	Engine vs. patch sample rate ratio of the project being loaded lazily. */
+
+	float m_lazySampleRateRatio;
 };
 } // namespace giada::m
 
@@ -0,0 +1,78 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2023 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#include "core/audioFileWriter.h"
+#include "deps/mcl-audio-buffer/src/audioBuffer.hpp"
+#include "utils/log.h"
+#include <cassert>
+
+namespace giada::m
+{
+AudioFileWriter::AudioFileWriter(const std::string& path, int channels, int sampleRate)
+: m_file(nullptr)
+, m_channels(channels)
+{
+	SF_INFO header;
+	header.samplerate = sampleRate;
+	header.channels   = channels;
+	header.format     = SF_FORMAT_WAV | SF_FORMAT_FLOAT;
+
+	m_file = sf_open(path.c_str(), SFM_WRITE, &header);
+	if (m_file == nullptr)
+		u::log::print("[AudioFileWriter] unable to open {} for writing: {}\n", path, sf_strerror(m_file));
+}
+
+/* -------------------------------------------------------------------------- */
+
+AudioFileWriter::~AudioFileWriter()
+{
+	if (m_file != nullptr)
+		sf_close(m_file);
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool AudioFileWriter::isOpen() const
+{
+	return m_file != nullptr;
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool AudioFileWriter::write(const mcl::AudioBuffer& b, int frames)
+{
+	assert(isOpen());
+	assert(b.countChannels() == m_channels);
+	assert(frames <= b.countFrames());
+
+	if (sf_writef_float(m_file, b[0], frames) != frames)
+	{
+		u::log::print("[AudioFileWriter] incomplete write: {}\n", sf_strerror(m_file));
+		return false;
+	}
+	return true;
+}
+} // namespace giada::m
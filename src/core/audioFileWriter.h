@@ -0,0 +1,69 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2023 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#ifndef G_AUDIO_FILE_WRITER_H
+#define G_AUDIO_FILE_WRITER_H
+
+#include <sndfile.h>
+#include <string>
+
+namespace mcl
+{
+class AudioBuffer;
+}
+
+namespace giada::m
+{
+/* AudioFileWriter
+Streams audio blocks to a 32-bit float WAV file, so that long renderings don't
+need to be held in memory all at once. The file is closed on destruction. */
+
+class AudioFileWriter final
+{
+public:
+	AudioFileWriter(const std::string& path, int channels, int sampleRate);
+	AudioFileWriter(const AudioFileWriter&) = delete;
+	AudioFileWriter& operator=(const AudioFileWriter&) = delete;
+	~AudioFileWriter();
+
+	/* isOpen
+	Tells whether the file has been opened successfully. */
+
+	bool isOpen() const;
+
+	/* write
+	Appends the first 'frames' frames of the buffer to the file. The buffer must
+	have the same number of channels as the file. Returns false on I/O error. */
+
+	bool write(const mcl::AudioBuffer&, int frames);
+
+private:
+	SNDFILE* m_file;
+	int      m_channels;
+};
+} // namespace giada::m
+
+#endif
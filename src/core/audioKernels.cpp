@@ -0,0 +1,854 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2023 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#include "core/audioKernels.h"
+#include "core/const.h"
+#include "deps/mcl-audio-buffer/src/audioBuffer.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define G_KERNELS_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(__ARM_NEON) || defined(__aarch64__) || defined(_M_ARM64)
+#define G_KERNELS_NEON
+#include <arm_neon.h>
+#endif
+
+/* G_KERNEL_TARGET
+Allows the compiler to emit instructions for a specific instruction set on a
+single function, regardless of the global compiler flags. MSVC doesn't need it.*/
+
+#if defined(__GNUC__) || defined(__clang__)
+#define G_KERNEL_TARGET(x) __attribute__((target(x)))
+#else
+#define G_KERNEL_TARGET(x)
+#endif
+
+namespace giada::m::kernels
+{
+namespace
+{
+/* Kernels work on interleaved stereo data (2 floats per frame). 'frames' is 
+the number of frames to process. Format converters work on plain samples
+instead, regardless of the channel layout. */
+
+using SumFn         = void (*)(float* dest, const float* src, int frames, float gainL, float gainR);
+using PeakFn        = Peak (*)(const float* src, int frames);
+using FinalizeFn    = Peak (*)(float* buf, const float* in, int frames, float gain, bool limit);
+using InterpolateFn = void (*)(const float* src, const float* rowA, const float* rowB, float t, int frames, float* out);
+using InterpMonoFn  = void (*)(const float* src, const float* rowA, const float* rowB, float t, int frames, float* out);
+using UpmixFn       = void (*)(const float* src, int frames, float* dest);
+using Pcm16Fn       = void (*)(const int16_t* src, int samples, float* dest);
+using Pcm24Fn       = void (*)(const uint8_t* src, int samples, float* dest);
+
+struct Table
+{
+	InstructionSet set;
+	SumFn          sum;
+	PeakFn         peak;
+	FinalizeFn     finalize;
+	InterpolateFn  interpolate;
+	InterpMonoFn   interpolateMono;
+	UpmixFn        upmix;
+	Pcm16Fn        pcm16ToFloat;
+	Pcm24Fn        pcm24ToFloat;
+};
+
+/* PCM16_SCALE_, PCM24_SCALE_
+Scaling factors from integer PCM samples to float, same as libsndfile's, so
+that a 16 or 24-bit sample survives a round trip float -> int -> float. */
+
+constexpr float PCM16_SCALE_ = 1.0f / 32768.0f;
+constexpr float PCM24_SCALE_ = 1.0f / 8388608.0f;
+
+/* -------------------------------------------------------------------------- */
+
+void sumScalar_(float* dest, const float* src, int frames, float gainL, float gainR)
+{
+	for (int i = 0; i < frames * 2; i += 2)
+	{
+		dest[i]     += src[i] * gainL;
+		dest[i + 1] += src[i + 1] * gainR;
+	}
+}
+
+Peak peakScalar_(const float* src, int frames)
+{
+	Peak peak = {0.0f, 0.0f};
+	for (int i = 0; i < frames * 2; i += 2)
+	{
+		peak.left  = std::max(peak.left, std::fabs(src[i]));
+		peak.right = std::max(peak.right, std::fabs(src[i + 1]));
+	}
+	return peak;
+}
+
+float finalizeSample_(float* buf, const float* in, int i, float gain, bool limit)
+{
+	float x = in != nullptr ? buf[i] + in[i] * gain : buf[i] * gain;
+	if (limit)
+		x = std::max(-1.0f, std::min(x, 1.0f));
+	buf[i] = x;
+	return std::fabs(x);
+}
+
+Peak finalizeScalar_(float* buf, const float* in, int frames, float gain, bool limit)
+{
+	Peak peak = {0.0f, 0.0f};
+	for (int i = 0; i < frames * 2; i += 2)
+	{
+		peak.left  = std::max(peak.left, finalizeSample_(buf, in, i, gain, limit));
+		peak.right = std::max(peak.right, finalizeSample_(buf, in, i + 1, gain, limit));
+	}
+	return peak;
+}
+
+void interpolateScalar_(const float* src, const float* rowA, const float* rowB, float t, int frames, float* out)
+{
+	float left  = 0.0f;
+	float right = 0.0f;
+	for (int i = 0; i < frames * 2; i += 2)
+	{
+		const float c = rowA[i] + (rowB[i] - rowA[i]) * t;
+		left += src[i] * c;
+		right += src[i + 1] * c;
+	}
+	out[0] = left;
+	out[1] = right;
+}
+
+void interpolateMonoScalar_(const float* src, const float* rowA, const float* rowB, float t, int frames, float* out)
+{
+	float sum = 0.0f;
+	for (int i = 0; i < frames; i++)
+	{
+		const float c = rowA[i * 2] + (rowB[i * 2] - rowA[i * 2]) * t;
+		sum += src[i] * c;
+	}
+	out[0] = sum;
+}
+
+void upmixScalar_(const float* src, int frames, float* dest)
+{
+	for (int i = 0; i < frames; i++)
+	{
+		dest[i * 2]     = src[i];
+		dest[i * 2 + 1] = src[i];
+	}
+}
+
+void pcm16ToFloatScalar_(const int16_t* src, int samples, float* dest)
+{
+	for (int i = 0; i < samples; i++)
+		dest[i] = src[i] * PCM16_SCALE_;
+}
+
+void pcm24ToFloatScalar_(const uint8_t* src, int samples, float* dest)
+{
+	/* Little-endian, 3 bytes per sample. Build the sample in the upper 24 bits
+	of a 32-bit word, then shift it back down to extend the sign. */
+
+	for (int i = 0; i < samples; i++, src += 3)
+	{
+		const uint32_t x = (uint32_t(src[0]) << 8) | (uint32_t(src[1]) << 16) | (uint32_t(src[2]) << 24);
+		dest[i]          = (static_cast<int32_t>(x) >> 8) * PCM24_SCALE_;
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+#ifdef G_KERNELS_X86
+
+/* SSE2: 2 stereo frames per register, as [L R L R]. */
+
+G_KERNEL_TARGET("sse2")
+void sumSSE2_(float* dest, const float* src, int frames, float gainL, float gainR)
+{
+	const __m128 gain = _mm_setr_ps(gainL, gainR, gainL, gainR);
+	const int    vec  = (frames / 2) * 2;
+
+	for (int i = 0; i < vec * 2; i += 4)
+		_mm_storeu_ps(dest + i, _mm_add_ps(_mm_loadu_ps(dest + i), _mm_mul_ps(_mm_loadu_ps(src + i), gain)));
+
+	sumScalar_(dest + vec * 2, src + vec * 2, frames - vec, gainL, gainR);
+}
+
+G_KERNEL_TARGET("sse2")
+Peak reducePeakSSE2_(__m128 peak, Peak tail)
+{
+	float p[4];
+	_mm_storeu_ps(p, peak);
+	return {std::max({p[0], p[2], tail.left}), std::max({p[1], p[3], tail.right})};
+}
+
+G_KERNEL_TARGET("sse2")
+Peak peakSSE2_(const float* src, int frames)
+{
+	const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+	const int    vec     = (frames / 2) * 2;
+	__m128       peak    = _mm_setzero_ps();
+
+	for (int i = 0; i < vec * 2; i += 4)
+		peak = _mm_max_ps(peak, _mm_and_ps(_mm_loadu_ps(src + i), absMask));
+
+	return reducePeakSSE2_(peak, peakScalar_(src + vec * 2, frames - vec));
+}
+
+G_KERNEL_TARGET("sse2")
+Peak finalizeSSE2_(float* buf, const float* in, int frames, float gain, bool limit)
+{
+	const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+	const __m128 g       = _mm_set1_ps(gain);
+	const __m128 lo      = _mm_set1_ps(-1.0f);
+	const __m128 hi      = _mm_set1_ps(1.0f);
+	const int    vec     = (frames / 2) * 2;
+	__m128       peak    = _mm_setzero_ps();
+
+	for (int i = 0; i < vec * 2; i += 4)
+	{
+		__m128 x = _mm_loadu_ps(buf + i);
+		x        = in != nullptr ? _mm_add_ps(x, _mm_mul_ps(_mm_loadu_ps(in + i), g)) : _mm_mul_ps(x, g);
+		if (limit)
+			x = _mm_max_ps(lo, _mm_min_ps(x, hi));
+		_mm_storeu_ps(buf + i, x);
+		peak = _mm_max_ps(peak, _mm_and_ps(x, absMask));
+	}
+
+	const float* inTail = in != nullptr ? in + vec * 2 : nullptr;
+	return reducePeakSSE2_(peak, finalizeScalar_(buf + vec * 2, inTail, frames - vec, gain, limit));
+}
+
+G_KERNEL_TARGET("sse2")
+void interpolateSSE2_(const float* src, const float* rowA, const float* rowB, float t, int frames, float* out)
+{
+	const __m128 vt  = _mm_set1_ps(t);
+	const int    vec = (frames / 2) * 2;
+	__m128       acc = _mm_setzero_ps();
+
+	for (int i = 0; i < vec * 2; i += 4)
+	{
+		const __m128 a = _mm_loadu_ps(rowA + i);
+		const __m128 c = _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(rowB + i), a), vt));
+		acc            = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(src + i), c));
+	}
+
+	float p[4];
+	_mm_storeu_ps(p, acc);
+	interpolateScalar_(src + vec * 2, rowA + vec * 2, rowB + vec * 2, t, frames - vec, out);
+	out[0] += p[0] + p[2];
+	out[1] += p[1] + p[3];
+}
+
+G_KERNEL_TARGET("sse2")
+void interpolateMonoSSE2_(const float* src, const float* rowA, const float* rowB, float t, int frames, float* out)
+{
+	/* Samples are spread as [a a b b], [c c d d] to match the duplicated
+	coefficients: both halves of each pair hold the same product, keep the
+	even lanes only. */
+
+	const __m128 vt  = _mm_set1_ps(t);
+	const int    vec = (frames / 4) * 4;
+	__m128       acc = _mm_setzero_ps();
+
+	for (int i = 0; i < vec; i += 4)
+	{
+		const __m128 x  = _mm_loadu_ps(src + i);
+		const __m128 a0 = _mm_loadu_ps(rowA + i * 2);
+		const __m128 a1 = _mm_loadu_ps(rowA + i * 2 + 4);
+		const __m128 c0 = _mm_add_ps(a0, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(rowB + i * 2), a0), vt));
+		const __m128 c1 = _mm_add_ps(a1, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(rowB + i * 2 + 4), a1), vt));
+		acc             = _mm_add_ps(acc, _mm_mul_ps(_mm_unpacklo_ps(x, x), c0));
+		acc             = _mm_add_ps(acc, _mm_mul_ps(_mm_unpackhi_ps(x, x), c1));
+	}
+
+	float p[4];
+	_mm_storeu_ps(p, acc);
+	interpolateMonoScalar_(src + vec, rowA + vec * 2, rowB + vec * 2, t, frames - vec, out);
+	out[0] += p[0] + p[2];
+}
+
+G_KERNEL_TARGET("sse2")
+void upmixSSE2_(const float* src, int frames, float* dest)
+{
+	const int vec = (frames / 4) * 4;
+	for (int i = 0; i < vec; i += 4)
+	{
+		const __m128 x = _mm_loadu_ps(src + i);
+		_mm_storeu_ps(dest + i * 2, _mm_unpacklo_ps(x, x));
+		_mm_storeu_ps(dest + i * 2 + 4, _mm_unpackhi_ps(x, x));
+	}
+	upmixScalar_(src + vec, frames - vec, dest + vec * 2);
+}
+
+G_KERNEL_TARGET("sse2")
+void pcm16ToFloatSSE2_(const int16_t* src, int samples, float* dest)
+{
+	const __m128 scale = _mm_set1_ps(PCM16_SCALE_);
+	const int    vec   = (samples / 8) * 8;
+	for (int i = 0; i < vec; i += 8)
+	{
+		/* Unpacking a register with itself puts each sample in the upper half
+		of a 32-bit word: shift it back down to extend the sign. */
+
+		const __m128i x  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+		const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16);
+		const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(x, x), 16);
+		_mm_storeu_ps(dest + i, _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+		_mm_storeu_ps(dest + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+	}
+	pcm16ToFloatScalar_(src + vec, samples - vec, dest + vec);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* AVX2: 4 stereo frames per register, as [L R L R L R L R]. */
+
+G_KERNEL_TARGET("avx2")
+void sumAVX2_(float* dest, const float* src, int frames, float gainL, float gainR)
+{
+	const __m256 gain = _mm256_setr_ps(gainL, gainR, gainL, gainR, gainL, gainR, gainL, gainR);
+	const int    vec  = (frames / 4) * 4;
+
+	for (int i = 0; i < vec * 2; i += 8)
+		_mm256_storeu_ps(dest + i, _mm256_add_ps(_mm256_loadu_ps(dest + i), _mm256_mul_ps(_mm256_loadu_ps(src + i), gain)));
+
+	sumScalar_(dest + vec * 2, src + vec * 2, frames - vec, gainL, gainR);
+}
+
+G_KERNEL_TARGET("avx2")
+Peak reducePeakAVX2_(__m256 peak, Peak tail)
+{
+	float p[8];
+	_mm256_storeu_ps(p, peak);
+	return {std::max({p[0], p[2], p[4], p[6], tail.left}), std::max({p[1], p[3], p[5], p[7], tail.right})};
+}
+
+G_KERNEL_TARGET("avx2")
+Peak peakAVX2_(const float* src, int frames)
+{
+	const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+	const int    vec     = (frames / 4) * 4;
+	__m256       peak    = _mm256_setzero_ps();
+
+	for (int i = 0; i < vec * 2; i += 8)
+		peak = _mm256_max_ps(peak, _mm256_and_ps(_mm256_loadu_ps(src + i), absMask));
+
+	return reducePeakAVX2_(peak, peakScalar_(src + vec * 2, frames - vec));
+}
+
+G_KERNEL_TARGET("avx2")
+Peak finalizeAVX2_(float* buf, const float* in, int frames, float gain, bool limit)
+{
+	const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+	const __m256 g       = _mm256_set1_ps(gain);
+	const __m256 lo      = _mm256_set1_ps(-1.0f);
+	const __m256 hi      = _mm256_set1_ps(1.0f);
+	const int    vec     = (frames / 4) * 4;
+	__m256       peak    = _mm256_setzero_ps();
+
+	for (int i = 0; i < vec * 2; i += 8)
+	{
+		__m256 x = _mm256_loadu_ps(buf + i);
+		x        = in != nullptr ? _mm256_add_ps(x, _mm256_mul_ps(_mm256_loadu_ps(in + i), g)) : _mm256_mul_ps(x, g);
+		if (limit)
+			x = _mm256_max_ps(lo, _mm256_min_ps(x, hi));
+		_mm256_storeu_ps(buf + i, x);
+		peak = _mm256_max_ps(peak, _mm256_and_ps(x, absMask));
+	}
+
+	const float* inTail = in != nullptr ? in + vec * 2 : nullptr;
+	return reducePeakAVX2_(peak, finalizeScalar_(buf + vec * 2, inTail, frames - vec, gain, limit));
+}
+
+G_KERNEL_TARGET("avx2")
+void interpolateAVX2_(const float* src, const float* rowA, const float* rowB, float t, int frames, float* out)
+{
+	const __m256 vt  = _mm256_set1_ps(t);
+	const int    vec = (frames / 4) * 4;
+	__m256       acc = _mm256_setzero_ps();
+
+	for (int i = 0; i < vec * 2; i += 8)
+	{
+		const __m256 a = _mm256_loadu_ps(rowA + i);
+		const __m256 c = _mm256_add_ps(a, _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(rowB + i), a), vt));
+		acc            = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_loadu_ps(src + i), c));
+	}
+
+	float p[8];
+	_mm256_storeu_ps(p, acc);
+	interpolateScalar_(src + vec * 2, rowA + vec * 2, rowB + vec * 2, t, frames - vec, out);
+	out[0] += p[0] + p[2] + p[4] + p[6];
+	out[1] += p[1] + p[3] + p[5] + p[7];
+}
+
+G_KERNEL_TARGET("avx2")
+void interpolateMonoAVX2_(const float* src, const float* rowA, const float* rowB, float t, int frames, float* out)
+{
+	/* Same spreading as upmixAVX2_, then keep the even lanes as in
+	interpolateMonoSSE2_. */
+
+	const __m256 vt  = _mm256_set1_ps(t);
+	const int    vec = (frames / 8) * 8;
+	__m256       acc = _mm256_setzero_ps();
+
+	for (int i = 0; i < vec; i += 8)
+	{
+		const __m256 x  = _mm256_loadu_ps(src + i);
+		const __m256 lo = _mm256_unpacklo_ps(x, x);
+		const __m256 hi = _mm256_unpackhi_ps(x, x);
+		const __m256 a0 = _mm256_loadu_ps(rowA + i * 2);
+		const __m256 a1 = _mm256_loadu_ps(rowA + i * 2 + 8);
+		const __m256 c0 = _mm256_add_ps(a0, _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(rowB + i * 2), a0), vt));
+		const __m256 c1 = _mm256_add_ps(a1, _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(rowB + i * 2 + 8), a1), vt));
+		acc             = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_permute2f128_ps(lo, hi, 0x20), c0));
+		acc             = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_permute2f128_ps(lo, hi, 0x31), c1));
+	}
+
+	float p[8];
+	_mm256_storeu_ps(p, acc);
+	interpolateMonoScalar_(src + vec, rowA + vec * 2, rowB + vec * 2, t, frames - vec, out);
+	out[0] += p[0] + p[2] + p[4] + p[6];
+}
+
+G_KERNEL_TARGET("avx2")
+void upmixAVX2_(const float* src, int frames, float* dest)
+{
+	const int vec = (frames / 8) * 8;
+	for (int i = 0; i < vec; i += 8)
+	{
+		/* Unpack works within 128-bit lanes: lo = [0 0 1 1 | 4 4 5 5] and
+		hi = [2 2 3 3 | 6 6 7 7]. Swap lanes to restore the frame order. */
+		const __m256 x  = _mm256_loadu_ps(src + i);
+		const __m256 lo = _mm256_unpacklo_ps(x, x);
+		const __m256 hi = _mm256_unpackhi_ps(x, x);
+		_mm256_storeu_ps(dest + i * 2, _mm256_permute2f128_ps(lo, hi, 0x20));
+		_mm256_storeu_ps(dest + i * 2 + 8, _mm256_permute2f128_ps(lo, hi, 0x31));
+	}
+	upmixScalar_(src + vec, frames - vec, dest + vec * 2);
+}
+
+G_KERNEL_TARGET("avx2")
+void pcm16ToFloatAVX2_(const int16_t* src, int samples, float* dest)
+{
+	const __m256 scale = _mm256_set1_ps(PCM16_SCALE_);
+	const int    vec   = (samples / 8) * 8;
+	for (int i = 0; i < vec; i += 8)
+	{
+		const __m256i x = _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)));
+		_mm256_storeu_ps(dest + i, _mm256_mul_ps(_mm256_cvtepi32_ps(x), scale));
+	}
+	pcm16ToFloatScalar_(src + vec, samples - vec, dest + vec);
+}
+
+G_KERNEL_TARGET("avx2")
+void pcm24ToFloatAVX2_(const uint8_t* src, int samples, float* dest)
+{
+	/* 4 samples (12 bytes) per 128-bit lane. The shuffle moves each sample to
+	the upper 24 bits of a 32-bit word, as in the scalar version. Loads are 16
+	bytes wide: stop earlier to never read past the end of 'src'. */
+
+	const __m256i shuffle = _mm256_setr_epi8(
+	    -1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11,
+	    -1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11);
+	const __m256 scale = _mm256_set1_ps(PCM24_SCALE_);
+
+	int i = 0;
+	for (; i + 10 <= samples; i += 8)
+	{
+		const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 3));
+		const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 3 + 12));
+		const __m256i x  = _mm256_shuffle_epi8(_mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1), shuffle);
+		_mm256_storeu_ps(dest + i, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srai_epi32(x, 8)), scale));
+	}
+	pcm24ToFloatScalar_(src + i * 3, samples - i, dest + i);
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool cpuSupports_(InstructionSet set)
+{
+#if defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 0);
+	const int maxLeaf = info[0];
+	__cpuid(info, 1);
+	const bool sse2    = (info[3] & (1 << 26)) != 0;
+	const bool osxsave = (info[2] & (1 << 27)) != 0;
+	const bool avx     = (info[2] & (1 << 28)) != 0;
+	bool       avx2    = false;
+	if (maxLeaf >= 7 && osxsave && avx && (_xgetbv(0) & 0x6) == 0x6)
+	{
+		__cpuidex(info, 7, 0);
+		avx2 = (info[1] & (1 << 5)) != 0;
+	}
+#else
+	__builtin_cpu_init();
+	const bool sse2 = __builtin_cpu_supports("sse2");
+	const bool avx2 = __builtin_cpu_supports("avx2");
+#endif
+	if (set == InstructionSet::SSE2)
+		return sse2;
+	if (set == InstructionSet::AVX2)
+		return avx2;
+	return false;
+}
+
+#endif // G_KERNELS_X86
+
+/* -------------------------------------------------------------------------- */
+
+#ifdef G_KERNELS_NEON
+
+/* NEON: 2 stereo frames per register, as [L R L R]. */
+
+void sumNEON_(float* dest, const float* src, int frames, float gainL, float gainR)
+{
+	const float       g[4] = {gainL, gainR, gainL, gainR};
+	const float32x4_t gain = vld1q_f32(g);
+	const int         vec  = (frames / 2) * 2;
+
+	for (int i = 0; i < vec * 2; i += 4)
+		vst1q_f32(dest + i, vaddq_f32(vld1q_f32(dest + i), vmulq_f32(vld1q_f32(src + i), gain)));
+
+	sumScalar_(dest + vec * 2, src + vec * 2, frames - vec, gainL, gainR);
+}
+
+Peak reducePeakNEON_(float32x4_t peak, Peak tail)
+{
+	float p[4];
+	vst1q_f32(p, peak);
+	return {std::max({p[0], p[2], tail.left}), std::max({p[1], p[3], tail.right})};
+}
+
+Peak peakNEON_(const float* src, int frames)
+{
+	const int   vec  = (frames / 2) * 2;
+	float32x4_t peak = vdupq_n_f32(0.0f);
+
+	for (int i = 0; i < vec * 2; i += 4)
+		peak = vmaxq_f32(peak, vabsq_f32(vld1q_f32(src + i)));
+
+	return reducePeakNEON_(peak, peakScalar_(src + vec * 2, frames - vec));
+}
+
+Peak finalizeNEON_(float* buf, const float* in, int frames, float gain, bool limit)
+{
+	const float32x4_t g    = vdupq_n_f32(gain);
+	const float32x4_t lo   = vdupq_n_f32(-1.0f);
+	const float32x4_t hi   = vdupq_n_f32(1.0f);
+	const int         vec  = (frames / 2) * 2;
+	float32x4_t       peak = vdupq_n_f32(0.0f);
+
+	for (int i = 0; i < vec * 2; i += 4)
+	{
+		float32x4_t x = vld1q_f32(buf + i);
+		x             = in != nullptr ? vaddq_f32(x, vmulq_f32(vld1q_f32(in + i), g)) : vmulq_f32(x, g);
+		if (limit)
+			x = vmaxq_f32(lo, vminq_f32(x, hi));
+		vst1q_f32(buf + i, x);
+		peak = vmaxq_f32(peak, vabsq_f32(x));
+	}
+
+	const float* inTail = in != nullptr ? in + vec * 2 : nullptr;
+	return reducePeakNEON_(peak, finalizeScalar_(buf + vec * 2, inTail, frames - vec, gain, limit));
+}
+
+void interpolateNEON_(const float* src, const float* rowA, const float* rowB, float t, int frames, float* out)
+{
+	const float32x4_t vt  = vdupq_n_f32(t);
+	const int         vec = (frames / 2) * 2;
+	float32x4_t       acc = vdupq_n_f32(0.0f);
+
+	for (int i = 0; i < vec * 2; i += 4)
+	{
+		const float32x4_t a = vld1q_f32(rowA + i);
+		const float32x4_t c = vaddq_f32(a, vmulq_f32(vsubq_f32(vld1q_f32(rowB + i), a), vt));
+		acc                 = vaddq_f32(acc, vmulq_f32(vld1q_f32(src + i), c));
+	}
+
+	float p[4];
+	vst1q_f32(p, acc);
+	interpolateScalar_(src + vec * 2, rowA + vec * 2, rowB + vec * 2, t, frames - vec, out);
+	out[0] += p[0] + p[2];
+	out[1] += p[1] + p[3];
+}
+
+void interpolateMonoNEON_(const float* src, const float* rowA, const float* rowB, float t, int frames, float* out)
+{
+	const float32x4_t vt  = vdupq_n_f32(t);
+	const int         vec = (frames / 4) * 4;
+	float32x4_t       acc = vdupq_n_f32(0.0f);
+
+	for (int i = 0; i < vec; i += 4)
+	{
+		const float32x4_t   x  = vld1q_f32(src + i);
+		const float32x4x2_t z  = vzipq_f32(x, x);
+		const float32x4_t   a0 = vld1q_f32(rowA + i * 2);
+		const float32x4_t   a1 = vld1q_f32(rowA + i * 2 + 4);
+		const float32x4_t   c0 = vaddq_f32(a0, vmulq_f32(vsubq_f32(vld1q_f32(rowB + i * 2), a0), vt));
+		const float32x4_t   c1 = vaddq_f32(a1, vmulq_f32(vsubq_f32(vld1q_f32(rowB + i * 2 + 4), a1), vt));
+		acc                    = vaddq_f32(acc, vmulq_f32(z.val[0], c0));
+		acc                    = vaddq_f32(acc, vmulq_f32(z.val[1], c1));
+	}
+
+	float p[4];
+	vst1q_f32(p, acc);
+	interpolateMonoScalar_(src + vec, rowA + vec * 2, rowB + vec * 2, t, frames - vec, out);
+	out[0] += p[0] + p[2];
+}
+
+void upmixNEON_(const float* src, int frames, float* dest)
+{
+	const int vec = (frames / 4) * 4;
+	for (int i = 0; i < vec; i += 4)
+	{
+		const float32x4_t   x = vld1q_f32(src + i);
+		const float32x4x2_t z = vzipq_f32(x, x);
+		vst1q_f32(dest + i * 2, z.val[0]);
+		vst1q_f32(dest + i * 2 + 4, z.val[1]);
+	}
+	upmixScalar_(src + vec, frames - vec, dest + vec * 2);
+}
+
+void pcm16ToFloatNEON_(const int16_t* src, int samples, float* dest)
+{
+	const int vec = (samples / 8) * 8;
+	for (int i = 0; i < vec; i += 8)
+	{
+		const int16x8_t x = vld1q_s16(src + i);
+		vst1q_f32(dest + i, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(x))), PCM16_SCALE_));
+		vst1q_f32(dest + i + 4, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(x))), PCM16_SCALE_));
+	}
+	pcm16ToFloatScalar_(src + vec, samples - vec, dest + vec);
+}
+
+void pcm24ToFloatNEON_(const uint8_t* src, int samples, float* dest)
+{
+	/* vld3 splits 8 samples in 3 planes, one per byte. The lower 16 bits are
+	joined as unsigned, the upper byte is sign-extended. */
+
+	const int vec = (samples / 8) * 8;
+	for (int i = 0; i < vec; i += 8)
+	{
+		const uint8x8x3_t b    = vld3_u8(src + i * 3);
+		const uint16x8_t  low  = vorrq_u16(vshll_n_u8(b.val[1], 8), vmovl_u8(b.val[0]));
+		const int16x8_t   high = vmovl_s8(vreinterpret_s8_u8(b.val[2]));
+
+		const int32x4_t x0 = vorrq_s32(vshlq_n_s32(vmovl_s16(vget_low_s16(high)), 16),
+		    vreinterpretq_s32_u32(vmovl_u16(vget_low_u16(low))));
+		const int32x4_t x1 = vorrq_s32(vshlq_n_s32(vmovl_s16(vget_high_s16(high)), 16),
+		    vreinterpretq_s32_u32(vmovl_u16(vget_high_u16(low))));
+
+		vst1q_f32(dest + i, vmulq_n_f32(vcvtq_f32_s32(x0), PCM24_SCALE_));
+		vst1q_f32(dest + i + 4, vmulq_n_f32(vcvtq_f32_s32(x1), PCM24_SCALE_));
+	}
+	pcm24ToFloatScalar_(src + vec * 3, samples - vec, dest + vec);
+}
+
+#endif // G_KERNELS_NEON
+
+/* -------------------------------------------------------------------------- */
+
+bool isSupported_(InstructionSet set)
+{
+	switch (set)
+	{
+	case InstructionSet::SCALAR:
+		return true;
+#ifdef G_KERNELS_X86
+	case InstructionSet::SSE2:
+	case InstructionSet::AVX2:
+		return cpuSupports_(set);
+#endif
+#ifdef G_KERNELS_NEON
+	case InstructionSet::NEON:
+		return true;
+#endif
+	default:
+		return false;
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+Table makeTable_(InstructionSet set)
+{
+	switch (set)
+	{
+#ifdef G_KERNELS_X86
+	case InstructionSet::SSE2: // No byte shuffles in SSE2: scalar 24-bit conversion
+		return {set, sumSSE2_, peakSSE2_, finalizeSSE2_, interpolateSSE2_, interpolateMonoSSE2_, upmixSSE2_,
+		    pcm16ToFloatSSE2_, pcm24ToFloatScalar_};
+	case InstructionSet::AVX2:
+		return {set, sumAVX2_, peakAVX2_, finalizeAVX2_, interpolateAVX2_, interpolateMonoAVX2_, upmixAVX2_,
+		    pcm16ToFloatAVX2_, pcm24ToFloatAVX2_};
+#endif
+#ifdef G_KERNELS_NEON
+	case InstructionSet::NEON:
+		return {set, sumNEON_, peakNEON_, finalizeNEON_, interpolateNEON_, interpolateMonoNEON_, upmixNEON_,
+		    pcm16ToFloatNEON_, pcm24ToFloatNEON_};
+#endif
+	default:
+		return {InstructionSet::SCALAR, sumScalar_, peakScalar_, finalizeScalar_, interpolateScalar_,
+		    interpolateMonoScalar_, upmixScalar_, pcm16ToFloatScalar_, pcm24ToFloatScalar_};
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+InstructionSet detect_()
+{
+	for (InstructionSet set : {InstructionSet::AVX2, InstructionSet::SSE2, InstructionSet::NEON})
+		if (isSupported_(set))
+			return set;
+	return InstructionSet::SCALAR;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* table_
+The kernels in use, selected once at startup. */
+
+Table table_ = makeTable_(detect_());
+
+/* -------------------------------------------------------------------------- */
+
+/* isStereo_
+Kernels work only on stereo buffers of the same length. Anything else falls
+back to the generic mcl::AudioBuffer implementation. */
+
+bool isStereo_(const mcl::AudioBuffer& a, const mcl::AudioBuffer& b)
+{
+	return a.countChannels() == G_MAX_IO_CHANS && b.countChannels() == G_MAX_IO_CHANS &&
+	       a.countFrames() == b.countFrames();
+}
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+InstructionSet getInstructionSet()
+{
+	return table_.set;
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool setInstructionSet(InstructionSet set)
+{
+	if (!isSupported_(set))
+		return false;
+	table_ = makeTable_(set);
+	return true;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void sum(mcl::AudioBuffer& dest, const mcl::AudioBuffer& src, float gain, float panL, float panR)
+{
+	if (!isStereo_(dest, src))
+	{
+		dest.sum(src, gain, {panL, panR});
+		return;
+	}
+	table_.sum(dest[0], src[0], dest.countFrames(), gain * panL, gain * panR);
+}
+
+/* -------------------------------------------------------------------------- */
+
+Peak getPeak(const mcl::AudioBuffer& b)
+{
+	if (!b.isAllocd())
+		return {0.0f, 0.0f};
+	if (b.countChannels() != G_MAX_IO_CHANS)
+		return {b.getPeak(0), b.getPeak(b.countChannels() == 1 ? 0 : 1)};
+	return table_.peak(b[0], b.countFrames());
+}
+
+/* -------------------------------------------------------------------------- */
+
+Peak finalize(mcl::AudioBuffer& buf, const mcl::AudioBuffer* in, float gain, bool limit)
+{
+	if (in != nullptr && !isStereo_(buf, *in))
+	{
+		buf.sum(*in, gain);
+		return finalize(buf, nullptr, 1.0f, limit);
+	}
+	if (buf.countChannels() != G_MAX_IO_CHANS)
+	{
+		buf.applyGain(gain);
+		if (limit)
+			for (int i = 0; i < buf.countFrames(); i++)
+				for (int j = 0; j < buf.countChannels(); j++)
+					buf[i][j] = std::max(-1.0f, std::min(buf[i][j], 1.0f));
+		return getPeak(buf);
+	}
+	return table_.finalize(buf[0], in != nullptr ? (*in)[0] : nullptr, buf.countFrames(), gain, limit);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void interpolate(const float* src, const float* rowA, const float* rowB, float t, int frames, float* out)
+{
+	table_.interpolate(src, rowA, rowB, t, frames, out);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void interpolateMono(const float* src, const float* rowA, const float* rowB, float t, int frames, float* out)
+{
+	table_.interpolateMono(src, rowA, rowB, t, frames, out);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void upmix(const float* src, int frames, float* dest)
+{
+	table_.upmix(src, frames, dest);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void pcm16ToFloat(const int16_t* src, int samples, float* dest)
+{
+	table_.pcm16ToFloat(src, samples, dest);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void pcm24ToFloat(const uint8_t* src, int samples, float* dest)
+{
+	table_.pcm24ToFloat(src, samples, dest);
+}
+} // namespace giada::m::kernels
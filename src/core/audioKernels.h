@@ -0,0 +1,113 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2023 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#ifndef G_AUDIO_KERNELS_H
+#define G_AUDIO_KERNELS_H
+
+#include "core/types.h"
+#include <cstdint>
+
+namespace mcl
+{
+class AudioBuffer;
+}
+
+namespace giada::m::kernels
+{
+/* InstructionSet
+The set of vector instructions used by the kernels below. The best one 
+available on the current CPU is picked at startup. */
+
+enum class InstructionSet
+{
+	SCALAR,
+	SSE2,
+	AVX2,
+	NEON
+};
+
+/* getInstructionSet
+Returns the instruction set currently in use. */
+
+InstructionSet getInstructionSet();
+
+/* setInstructionSet
+Forces a specific instruction set. Returns false if not supported by the
+current CPU. Useful for testing or benchmarking. */
+
+bool setInstructionSet(InstructionSet);
+
+/* sum
+Sums 'src' into 'dest' with gain and panning applied, i.e. 
+dest += src * gain * pan. Same as mcl::AudioBuffer::sum(src, gain, pan) but
+vectorized for stereo buffers. */
+
+void sum(mcl::AudioBuffer& dest, const mcl::AudioBuffer& src, float gain, float panL, float panR);
+
+/* getPeak
+Returns the peak of both left and right channels, in a single pass. */
+
+Peak getPeak(const mcl::AudioBuffer&);
+
+/* finalize
+Output stage in a single pass: applies 'gain' to 'buf' or, if 'in' is not 
+null, sums 'in' scaled by 'gain' to it; then hard-limits the result in range 
+[-1.0, 1.0] if 'limit' == true. Returns the final peak. */
+
+Peak finalize(mcl::AudioBuffer& buf, const mcl::AudioBuffer* in, float gain, bool limit);
+
+/* interpolate
+Computes a single stereo frame as the dot product between 'frames' interleaved
+stereo frames in 'src' and a filter obtained by blending rows 'rowA' and 'rowB'
+by 't', i.e. rowA + (rowB - rowA) * t. Rows store each coefficient twice
+([c0 c0 c1 c1 ...]) to match the interleaved layout. Result goes into out[0]
+(left) and out[1] (right). Used by the Resampler for polyphase filtering. */
+
+void interpolate(const float* src, const float* rowA, const float* rowB, float t, int frames, float* out);
+
+/* interpolateMono
+Same as interpolate, for 'frames' mono samples in 'src'. Rows keep the same
+duplicated layout. Result goes into out[0] only. */
+
+void interpolateMono(const float* src, const float* rowA, const float* rowB, float t, int frames, float* out);
+
+/* upmix
+Spreads 'frames' mono samples from 'src' into 'dest' as interleaved stereo
+frames, i.e. dest[i * 2] = dest[i * 2 + 1] = src[i]. Used to render mono Waves
+into stereo buffers. */
+
+void upmix(const float* src, int frames, float* dest);
+
+/* pcm16ToFloat, pcm24ToFloat
+Convert 'samples' integer samples from 'src' to float in range [-1.0, 1.0),
+into 'dest'. 24-bit samples are packed, 3 little-endian bytes each. Used to
+decode compact Waves while rendering. */
+
+void pcm16ToFloat(const int16_t* src, int samples, float* dest);
+void pcm24ToFloat(const uint8_t* src, int samples, float* dest);
+} // namespace giada::m::kernels
+
+#endif
@@ -26,15 +26,21 @@
 
 #include "core/channels/channel.h"
 #include "core/actions/actionRecorder.h"
+#include "core/audioKernels.h"
 #include "core/channels/sampleAdvancer.h"
 #include "core/conf.h"
 #include "core/engine.h"
 #include "core/midiMapper.h"
 #include "core/model/model.h"
+#include "core/plugins/plugin.h"
 #include "core/plugins/pluginHost.h"
 #include "core/plugins/pluginManager.h"
 #include "core/recorder.h"
+#include "core/renderPool.h"
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
+#include <limits>
 
 extern giada::m::Engine g_engine;
 
@@ -53,6 +59,45 @@ mcl::AudioBuffer::Pan calcPanning_(float pan)
 		return {1.0f, 1.0f};
 	return {1.0f - pan, pan};
 }
+
+/* -------------------------------------------------------------------------- */
+
+/* getPluginsVersion_
+Returns a fingerprint of the plug-in stack, which changes when plug-ins are
+added, removed, replaced or reordered, or when the state of any of them
+changes. */
+
+std::uint64_t getPluginsVersion_(const std::vector<Plugin*>& plugins)
+{
+	std::uint64_t version = plugins.size();
+	for (const Plugin* p : plugins)
+		version = version * 31 + ((static_cast<std::uint64_t>(p->id) << 32) | p->getStateVersion());
+	return version;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* fadeIn_
+Applies a linear fade-in, G_LAZY_LOAD_FADE_IN_FRAMES long, to the beginning of
+the buffer. 'left' holds the frames of fade-in still to go and is updated, so
+that the fade can span multiple blocks. */
+
+void fadeIn_(mcl::AudioBuffer& buf, WeakAtomic<Frame>& left)
+{
+	Frame frame = left.load();
+	if (frame <= 0)
+		return;
+
+	const int frames = std::min(frame, buf.countFrames());
+	for (int i = 0; i < frames; i++, frame--)
+	{
+		const float gain = 1.0f - frame / static_cast<float>(G_LAZY_LOAD_FADE_IN_FRAMES);
+		for (int j = 0; j < buf.countChannels(); j++)
+			buf[i][j] *= gain;
+	}
+
+	left.store(frame);
+}
 } // namespace
 
 /* -------------------------------------------------------------------------- */
@@ -81,14 +126,14 @@ Channel::Channel(ChannelType type, ID id, ID columnId, int position, ChannelShar
 	case ChannelType::SAMPLE:
 		samplePlayer.emplace(&(shared->resampler.value()));
 		sampleAdvancer.emplace();
-		sampleReactor.emplace(*shared, id);
+		sampleReactor.emplace(*shared);
 		audioReceiver.emplace();
 		sampleActionRecorder.emplace(g_engine.getActionRecorder());
 		break;
 
 	case ChannelType::PREVIEW:
 		samplePlayer.emplace(&(shared->resampler.value()));
-		sampleReactor.emplace(*shared, id);
+		sampleReactor.emplace(*shared);
 		break;
 
 	case ChannelType::MIDI:
@@ -129,20 +174,23 @@ Channel::Channel(const Patch::Channel& p, ChannelShared& s, float samplerateRati
 {
 	shared->readActions.store(p.readActions);
 	shared->recStatus.store(p.readActions ? ChannelStatus::PLAY : ChannelStatus::OFF);
+	shared->volume.store(p.volume);
+	shared->pan.store(p.pan);
+	shared->pitch.store(p.pitch);
 
 	switch (type)
 	{
 	case ChannelType::SAMPLE:
 		samplePlayer.emplace(p, samplerateRatio, &(shared->resampler.value()), wave);
 		sampleAdvancer.emplace();
-		sampleReactor.emplace(*shared, id);
+		sampleReactor.emplace(*shared);
 		audioReceiver.emplace(p);
 		sampleActionRecorder.emplace(g_engine.getActionRecorder());
 		break;
 
 	case ChannelType::PREVIEW:
 		samplePlayer.emplace(p, samplerateRatio, &(shared->resampler.value()), nullptr);
-		sampleReactor.emplace(*shared, id);
+		sampleReactor.emplace(*shared);
 		break;
 
 	case ChannelType::MIDI:
@@ -273,6 +321,39 @@ bool Channel::isPlaying() const
 	return s == ChannelStatus::PLAY || s == ChannelStatus::ENDING;
 }
 
+bool Channel::isActive(Frame pluginTailFrames) const
+{
+	if (plugins.size() > 0)
+	{
+		/* Any change in the plug-in stack restarts the tail: a plug-in just
+		added or tweaked might produce sound again. */
+
+		const std::uint64_t version = getPluginsVersion_(plugins);
+		if (version != shared->pluginsVersion)
+		{
+			shared->pluginsVersion = version;
+			shared->silentFrames   = 0;
+		}
+	}
+
+	if (isPlaying())
+		return true;
+	if (audioReceiver && armed && audioReceiver->inputMonitor)
+		return true;
+	if (midiReceiver && !shared->midiQueue.isEmpty())
+		return true;
+	if (plugins.size() == 0)
+		return false;
+
+	/* Plug-ins that take MIDI (synths, arpeggiators, drum machines, ...) might
+	play on their own, e.g. following the transport: never skip them. */
+
+	if (std::any_of(plugins.begin(), plugins.end(), [](const Plugin* p) { return p->acceptsMidi(); }))
+		return true;
+
+	return shared->silentFrames < pluginTailFrames;
+}
+
 /* -------------------------------------------------------------------------- */
 
 void Channel::setMute(bool v)
@@ -294,6 +375,11 @@ void Channel::setSolo(bool v)
 void Channel::initCallbacks()
 {
 	shared->playStatus.onChange = [this](ChannelStatus status) {
+		if (RenderPool::getThreadIndex() != 0)
+		{
+			shared->statusPending = true;
+			return;
+		}
 		midiLighter.sendStatus(status, isAudible(/*mixerHasSolos = TODO!*/ false));
 	};
 
@@ -313,19 +399,29 @@ void Channel::advance(const Sequencer::EventBuffer& events, Range<Frame> block,
 	if (shared->quantizer)
 		shared->quantizer->advance(block, quantizerStep);
 
-	for (const Sequencer::Event& e : events)
+	for (Sequencer::Event e : events)
 	{
+		/* Route actions: keep only the ones that belong to this channel, and
+		skip the event altogether if there are none. */
+
+		if (e.type == Sequencer::EventType::ACTIONS)
+		{
+			e.actions = model::Actions::Playback::getActionsOnChannel(e.actions, id);
+			if (e.actions.empty())
+				continue;
+		}
+
 		if (midiController)
 			midiController->advance(shared->playStatus, e);
 
 		if (samplePlayer)
-			sampleAdvancer->advance(id, *shared, e, samplePlayer->mode, samplePlayer->isAnyLoopMode());
+			sampleAdvancer->advance(*shared, e, samplePlayer->mode, samplePlayer->isAnyLoopMode());
 
 		if (midiSender && isPlaying() && !isMuted())
-			midiSender->advance(id, e);
+			midiSender->advance(e);
 
 		if (midiReceiver && isPlaying())
-			midiReceiver->advance(id, shared->midiQueue, e);
+			midiReceiver->advance(shared->midiQueue, e);
 	}
 }
 
@@ -338,7 +434,10 @@ void Channel::render(mcl::AudioBuffer* out, mcl::AudioBuffer* in, bool mixerHasS
 	else if (id == Mixer::MASTER_IN_CHANNEL_ID)
 		renderMasterIn(*in);
 	else
-		renderChannel(*out, *in, mixerHasSolos, seqIsRunning);
+	{
+		renderChannel(*in, seqIsRunning);
+		mixChannel(*out, mixerHasSolos);
+	}
 }
 
 /* -------------------------------------------------------------------------- */
@@ -348,7 +447,7 @@ void Channel::renderMasterOut(mcl::AudioBuffer& out) const
 	shared->audioBuffer.set(out, /*gain=*/1.0f);
 	if (plugins.size() > 0)
 		g_engine.getPluginsApi().process(shared->audioBuffer, plugins, nullptr);
-	out.set(shared->audioBuffer, volume);
+	out.set(shared->audioBuffer, shared->volume.load());
 }
 
 /* -------------------------------------------------------------------------- */
@@ -361,8 +460,10 @@ void Channel::renderMasterIn(mcl::AudioBuffer& in) const
 
 /* -------------------------------------------------------------------------- */
 
-void Channel::renderChannel(mcl::AudioBuffer& out, mcl::AudioBuffer& in, bool mixerHasSolos, bool seqIsRunning) const
+void Channel::renderChannel(const mcl::AudioBuffer& in, bool seqIsRunning) const
 {
+	const CpuMeter::Clock::time_point start = CpuMeter::Clock::now();
+
 	shared->audioBuffer.clear();
 
 	if (samplePlayer && isPlaying())
@@ -371,6 +472,7 @@ void Channel::renderChannel(mcl::AudioBuffer& out, mcl::AudioBuffer& in, bool mi
 		while (shared->renderQueue->pop(render))
 			;
 		samplePlayer->render(*shared, render, seqIsRunning);
+		fadeIn_(shared->audioBuffer, shared->fadeIn);
 	}
 
 	if (audioReceiver)
@@ -385,7 +487,41 @@ void Channel::renderChannel(mcl::AudioBuffer& out, mcl::AudioBuffer& in, bool mi
 	else if (plugins.size() > 0)
 		g_engine.getPluginsApi().process(shared->audioBuffer, plugins, nullptr);
 
-	if (isAudible(mixerHasSolos))
-		out.sum(shared->audioBuffer, volume * volume_i, calcPanning_(pan));
+	/* Keep track of silence coming out of the plug-in stack: the Mixer stops 
+	rendering an idle channel once its plug-in tail has died out. */
+
+	if (plugins.size() > 0)
+	{
+		const Peak peak = kernels::getPeak(shared->audioBuffer);
+		if (peak.left > G_PLUGIN_TAIL_SILENCE || peak.right > G_PLUGIN_TAIL_SILENCE)
+			shared->silentFrames = 0;
+		else
+			shared->silentFrames = std::min(shared->silentFrames, std::numeric_limits<Frame>::max() - shared->audioBuffer.countFrames()) + shared->audioBuffer.countFrames();
+	}
+
+	shared->cpuMeter.record(CpuMeter::Clock::now() - start);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Channel::mixChannel(mcl::AudioBuffer& out, bool mixerHasSolos) const
+{
+	if (!isAudible(mixerHasSolos))
+		return;
+
+	const mcl::AudioBuffer::Pan panning = calcPanning_(shared->pan.load());
+	kernels::sum(out, shared->audioBuffer, shared->volume.load() * volume_i, panning.left, panning.right);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Channel::sendPendingStatus() const
+{
+	assert(RenderPool::getThreadIndex() == 0);
+
+	if (!shared->statusPending)
+		return;
+	shared->statusPending = false;
+	midiLighter.sendStatus(shared->playStatus.load(), isAudible(/*mixerHasSolos = TODO!*/ false));
 }
 } // namespace giada::m
\ No newline at end of file
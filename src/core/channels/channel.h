@@ -76,7 +76,34 @@ public:
 
 	void render(mcl::AudioBuffer* out, mcl::AudioBuffer* in, bool mixerHasSolos, bool seqIsRunning) const;
 
+	/* renderChannel
+	Renders a regular (i.e. non-internal) channel into its own audio buffer in
+	ChannelShared, without touching the output. Different channels can be 
+	rendered concurrently. */
+
+	void renderChannel(const mcl::AudioBuffer& in, bool seqIsRunning) const;
+
+	/* mixChannel
+	Sums the audio rendered by renderChannel() into the 'out' buffer, with 
+	volume and panning applied, if the channel is audible. */
+
+	void mixChannel(mcl::AudioBuffer& out, bool mixerHasSolos) const;
+
+	/* sendPendingStatus
+	Sends the MIDI lighting message for a status change that happened while the
+	channel was rendered by a RenderPool worker, if any. Audio thread only. */
+
+	void sendPendingStatus() const;
+
 	bool isPlaying() const;
+
+	/* isActive
+	True if this channel has something to render in the current block: it's
+	playing, monitoring its input, receiving MIDI events, it has plug-ins that
+	accept MIDI or its plug-ins are still producing a tail, 'pluginTailFrames'
+	long at most. Audio thread only. */
+
+	bool isActive(Frame pluginTailFrames) const;
 	bool isInternal() const;
 	bool isMuted() const;
 	bool isSoloed() const;
@@ -124,7 +151,6 @@ public:
 private:
 	void renderMasterOut(mcl::AudioBuffer&) const;
 	void renderMasterIn(mcl::AudioBuffer&) const;
-	void renderChannel(mcl::AudioBuffer& out, mcl::AudioBuffer& in, bool mixerHasSolos, bool seqIsRunning) const;
 
 	void initCallbacks();
 
@@ -102,6 +102,11 @@ Data create(const Channel& o, int bufferSize, Resampler::Quality quality)
 	ch.id     = channelId_.generate();
 	ch.shared = shared.get();
 
+	shared->volume.store(o.volume);
+	shared->pan.store(o.pan);
+	if (o.samplePlayer)
+		shared->pitch.store(o.samplePlayer->pitch);
+
 	c::channel::setCallbacks(ch); // UI callbacks
 
 	return {ch, std::move(shared)};
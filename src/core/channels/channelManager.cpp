@@ -30,8 +30,10 @@
 #include "core/midiEvent.h"
 #include "core/model/model.h"
 #include "core/waveFactory.h"
+#include "core/waveFx.h"
 #include "deps/mcl-audio-buffer/src/audioBuffer.hpp"
 #include "utils/log.h"
+#include "utils/vector.h"
 
 namespace giada::m
 {
@@ -109,10 +111,14 @@ Channel& ChannelManager::addChannel(ChannelType type, ID columnId, int position,
 
 int ChannelManager::loadSampleChannel(ID channelId, const std::string& fname, int sampleRate, Resampler::Quality quality)
 {
-	waveFactory::Result res = waveFactory::createFromFile(fname, /*id=*/0, sampleRate, quality);
+	const int           streamingThreshold = m_model.get().kernelAudio.streamingThreshold;
+	waveFactory::Result res                = waveFactory::createFromFile(fname, /*id=*/0, sampleRate, quality, streamingThreshold);
 	if (res.status != G_RES_OK)
 		return res.status;
 
+	const model::KernelAudio& kernelAudio = m_model.get().kernelAudio;
+	waveFactory::compact(*res.wave, kernelAudio.compactSamples, kernelAudio.sampleMemoryBudget, m_model.getAllWaves());
+
 	loadSampleChannel(channelId, m_model.addWave(std::move(res.wave)));
 
 	return G_RES_OK;
@@ -140,6 +146,46 @@ void ChannelManager::loadSampleChannel(ID channelId, Wave& wave)
 
 /* -------------------------------------------------------------------------- */
 
+std::vector<ID> ChannelManager::loadLazySampleChannels(std::unique_ptr<Wave> wave, const std::vector<ID>& channelIds, float samplerateRatio)
+{
+	std::vector<Channel*> channels = m_model.get().channels.getIf([&channelIds](const Channel& c) {
+		return u::vector::has(channelIds, [&c](ID id) { return id == c.id; }) &&
+		       c.shared->playStatus.load() == ChannelStatus::LOADING;
+	});
+
+	if (channels.empty())
+		return {};
+
+	/* No need to lock the shared data here as in Model::addWave(): the audio
+	thread never goes through the Wave vector, and the Wave object stays where
+	it is even if the vector grows. Loading samples in the background must not
+	silence the audio, even for one block. */
+
+	Wave* w = nullptr;
+	if (wave != nullptr)
+	{
+		const model::KernelAudio& kernelAudio = m_model.get().kernelAudio;
+		waveFactory::compact(*wave, kernelAudio.compactSamples, kernelAudio.sampleMemoryBudget, m_model.getAllWaves());
+		w = m_model.getAllWaves().emplace_back(std::move(wave)).get();
+	}
+
+	std::vector<ID> out;
+	for (Channel* ch : channels)
+	{
+		ch->samplePlayer->setWave(w, samplerateRatio);
+		ch->shared->playStatus.store(ChannelStatus::OFF);
+		out.push_back(ch->id);
+	}
+
+	m_model.swap(model::SwapType::HARD);
+
+	triggerOnChannelsAltered();
+
+	return out;
+}
+
+/* -------------------------------------------------------------------------- */
+
 void ChannelManager::cloneChannel(ID channelId, int bufferSize, const std::vector<Plugin*>& plugins)
 {
 	const Channel&           oldChannel     = m_model.get().channels.get(channelId);
@@ -286,7 +332,7 @@ void ChannelManager::keyPress(ID channelId, int velocity, bool canRecordActions,
 	if (ch.sampleActionRecorder && ch.hasWave() && canRecordActions && !ch.samplePlayer->isAnyLoopMode())
 		ch.sampleActionRecorder->keyPress(channelId, *ch.shared, currentFrameQuantized, ch.samplePlayer->mode, ch.hasActions);
 	if (ch.sampleReactor && ch.hasWave())
-		ch.sampleReactor->keyPress(channelId, *ch.shared, ch.samplePlayer->mode, velocity, canQuantize, ch.samplePlayer->isAnyLoopMode(), ch.samplePlayer->velocityAsVol, ch.volume_i);
+		ch.sampleReactor->keyPress(*ch.shared, ch.samplePlayer->mode, velocity, canQuantize, ch.samplePlayer->isAnyLoopMode(), ch.samplePlayer->velocityAsVol, ch.volume_i);
 
 	m_model.swap(model::SwapType::SOFT);
 }
@@ -327,6 +373,80 @@ void ChannelManager::keyKill(ID channelId, bool canRecordActions, Frame currentF
 
 /* -------------------------------------------------------------------------- */
 
+void ChannelManager::keyPressLate(ID channelId, int velocity, Frame pressFrame, bool canQuantize, bool seqIsRunning,
+    Frame currentFrame, Frame currentFrameQuantized)
+{
+	Channel& ch = m_model.get().channels.get(channelId);
+
+	if (!ch.samplePlayer || !ch.hasWave())
+		return;
+
+	const SamplePlayer& player = ch.samplePlayer.value();
+	const Frame         length = player.end - player.begin;
+
+	if (!seqIsRunning || !player.isAnyLoopMode() || length <= 0 || ch.shared->playStatus.load() != ChannelStatus::OFF)
+	{
+		keyPress(channelId, velocity, /*canRecordActions=*/false, canQuantize, currentFrameQuantized);
+		return;
+	}
+
+	/* Had the Wave been there, the press would have put the loop on hold until
+	the first beat (the next bar for LOOP_ONCE_BAR). If no such boundary has
+	been crossed since the press, the loop is still on hold: press it as usual.
+	The sequencer frame wraps around, so a replay coming more than a whole loop
+	after the press is seen as one coming within the loop. */
+
+	const SamplePlayerMode mode        = player.mode;
+	const Frame            framesInBar = m_model.get().sequencer.framesInBar;
+	const Frame            barStart    = framesInBar > 0 ? currentFrame - currentFrame % framesInBar : 0;
+	const Frame            kickStart   = mode == SamplePlayerMode::LOOP_ONCE_BAR ? barStart : 0;
+
+	if (pressFrame >= kickStart && pressFrame <= currentFrame)
+	{
+		keyPress(channelId, velocity, /*canRecordActions=*/false, canQuantize, currentFrameQuantized);
+		return;
+	}
+
+	/* Otherwise join the loop from its latest (re)start, scaled by pitch:
+	LOOP_REPEAT and LOOP_ONCE_BAR rewind on each bar, the others on the first
+	beat. */
+
+	const bool  onBar   = mode == SamplePlayerMode::LOOP_REPEAT || mode == SamplePlayerMode::LOOP_ONCE_BAR;
+	const Frame restart = onBar ? barStart : 0;
+	const Frame offset  = static_cast<Frame>((currentFrame - restart) * ch.shared->pitch.load()) % length;
+
+	ch.shared->fadeIn.store(G_LAZY_LOAD_FADE_IN_FRAMES);
+	ch.samplePlayer->kickIn(*ch.shared, player.begin + offset);
+
+	m_model.swap(model::SwapType::SOFT);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void ChannelManager::recordKeyPress(ID channelId, Frame currentFrameQuantized)
+{
+	Channel& ch = m_model.get().channels.get(channelId);
+
+	if (!ch.sampleActionRecorder || ch.samplePlayer->isAnyLoopMode())
+		return;
+
+	ch.sampleActionRecorder->keyPress(channelId, *ch.shared, currentFrameQuantized, ch.samplePlayer->mode, ch.hasActions);
+	m_model.swap(model::SwapType::SOFT);
+}
+
+void ChannelManager::recordKeyRelease(ID channelId, Frame currentFrameQuantized)
+{
+	Channel& ch = m_model.get().channels.get(channelId);
+
+	if (!ch.sampleActionRecorder || ch.samplePlayer->isAnyLoopMode())
+		return;
+
+	ch.sampleActionRecorder->keyRelease(channelId, /*canRecordActions=*/true, currentFrameQuantized, ch.samplePlayer->mode, ch.hasActions);
+	m_model.swap(model::SwapType::SOFT);
+}
+
+/* -------------------------------------------------------------------------- */
+
 void ChannelManager::processMidiEvent(ID channelId, const MidiEvent& e, bool canRecordActions, Frame currentFrameQuantized)
 {
 	Channel& ch = m_model.get().channels.get(channelId);
@@ -349,26 +469,35 @@ void ChannelManager::setInputMonitor(ID channelId, bool value)
 
 void ChannelManager::setVolume(ID channelId, float value)
 {
-	m_model.get().channels.get(channelId).volume = std::clamp(value, 0.0f, G_MAX_VOLUME);
-	m_model.swap(model::SwapType::SOFT);
+	Channel& ch = m_model.get().channels.get(channelId);
+
+	/* No model swap here: the audio thread reads the value from the shared
+	state. See ChannelShared. */
+
+	ch.volume = std::clamp(value, 0.0f, G_MAX_VOLUME);
+	ch.shared->volume.store(ch.volume);
 }
 
 /* -------------------------------------------------------------------------- */
 
 void ChannelManager::setPitch(ID channelId, float value)
 {
-	assert(m_model.get().channels.get(channelId).samplePlayer);
+	Channel& ch = m_model.get().channels.get(channelId);
 
-	m_model.get().channels.get(channelId).samplePlayer->pitch = std::clamp(value, G_MIN_PITCH, G_MAX_PITCH);
-	m_model.swap(model::SwapType::SOFT);
+	assert(ch.samplePlayer);
+
+	ch.samplePlayer->pitch = std::clamp(value, G_MIN_PITCH, G_MAX_PITCH);
+	ch.shared->pitch.store(ch.samplePlayer->pitch);
 }
 
 /* -------------------------------------------------------------------------- */
 
 void ChannelManager::setPan(ID channelId, float value)
 {
-	m_model.get().channels.get(channelId).pan = std::clamp(value, 0.0f, G_MAX_PAN);
-	m_model.swap(model::SwapType::SOFT);
+	Channel& ch = m_model.get().channels.get(channelId);
+
+	ch.pan = std::clamp(value, 0.0f, G_MAX_PAN);
+	ch.shared->pan.store(ch.pan);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -550,6 +679,45 @@ void ChannelManager::rewindAll()
 
 /* -------------------------------------------------------------------------- */
 
+void ChannelManager::resetPlayback()
+{
+	for (Channel& ch : m_model.get().channels.getAll())
+	{
+		ChannelShared&      shared = *ch.shared;
+		const ChannelStatus status = shared.playStatus.load();
+
+		/* Skip channels with nothing to play (empty, missing, loading, ...). */
+
+		if (status != ChannelStatus::OFF && status != ChannelStatus::PLAY &&
+		    status != ChannelStatus::WAIT && status != ChannelStatus::ENDING)
+			continue;
+
+		const bool isLoop  = ch.midiController || (ch.samplePlayer && ch.samplePlayer->isAnyLoopMode());
+		const bool restart = isLoop && (status == ChannelStatus::PLAY || status == ChannelStatus::WAIT);
+
+		if (ch.midiSender && ch.isPlaying() && !ch.isMuted())
+			ch.midiSender->stop();
+		if (ch.midiReceiver)
+			ch.midiReceiver->stop(shared.midiQueue);
+		if (ch.samplePlayer)
+		{
+			SamplePlayer::Render render;
+			while (shared.renderQueue->pop(render))
+				;
+			ch.samplePlayer->waveReader.last();
+			shared.tracker.store(ch.samplePlayer->begin);
+			shared.fadeIn.store(0);
+		}
+		if (shared.quantizer)
+			shared.quantizer->clear();
+
+		shared.playStatus.store(restart ? ChannelStatus::WAIT : ChannelStatus::OFF);
+	}
+	m_model.swap(model::SwapType::SOFT);
+}
+
+/* -------------------------------------------------------------------------- */
+
 bool ChannelManager::saveSample(ID channelId, const std::string& filePath)
 {
 	Channel& ch = m_model.get().channels.get(channelId);
@@ -632,7 +800,7 @@ std::vector<Channel*> ChannelManager::getRecordableChannels()
 
 std::vector<Channel*> ChannelManager::getOverdubbableChannels()
 {
-	return m_model.get().channels.getIf([](const Channel& c) { return c.canInputRec() && c.hasWave(); });
+	return m_model.get().channels.getIf([](const Channel& c) { return c.canInputRec() && c.hasWave() && !c.samplePlayer->hasStreamedWave(); });
 }
 
 /* -------------------------------------------------------------------------- */
@@ -659,7 +827,7 @@ void ChannelManager::recordChannel(Channel& ch, const mcl::AudioBuffer& buffer,
 
 	/* Copy up to wave.getSize() from the mixer's input buffer into wave's. */
 
-	wave->getBuffer().set(buffer, wave->getBuffer().countFrames());
+	wave->getWritableBuffer().set(buffer, wave->getBuffer().countFrames());
 
 	/* Update channel with the new Wave. */
 
@@ -680,7 +848,12 @@ void ChannelManager::overdubChannel(Channel& ch, const mcl::AudioBuffer& buffer,
 
 	model::DataLock lock = m_model.lockData();
 
-	wave->getBuffer().sum(buffer, /*gain=*/1.0f);
+	/* Compact Waves are expanded back to float and mono Waves are upmixed
+	first, so that the stereo input is recorded on both channels. */
+
+	wave->expand();
+	wfx::monoToStereo(*wave);
+	wave->getWritableBuffer().sum(buffer, /*gain=*/1.0f);
 	wave->setLogical(true);
 
 	setupChannelPostRecording(ch, currentFrame);
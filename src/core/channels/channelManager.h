@@ -120,6 +120,15 @@ public:
 
 	void loadSampleChannel(ID channelId, Wave&);
 
+	/* loadLazySampleChannels
+	Hands a Wave loaded in the background (see WaveLoader) to the channels in
+	'channelIds' still waiting for it in LOADING status, i.e. not removed or
+	loaded with another sample in the meantime. A nullptr Wave just brings them
+	out of LOADING status. Begin/end points come from the patch and are adjusted
+	with 'samplerateRatio'. Returns the IDs of the channels updated. */
+
+	std::vector<ID> loadLazySampleChannels(std::unique_ptr<Wave>, const std::vector<ID>& channelIds, float samplerateRatio);
+
 	/* freeChannel
     Unloads existing Wave from a Sample Channel. */
 
@@ -144,6 +153,25 @@ public:
 	void keyPress(ID channelId, int velocity, bool canRecordActions, bool canQuantize, Frame currentFrameQuantized);
 	void keyRelease(ID channelId, bool canRecordActions, Frame currentFrameQuantized);
 	void keyKill(ID channelId, bool canRecordActions, Frame currentFrameQuantized);
+
+	/* keyPressLate
+	Replays a key press received at sequencer frame 'pressFrame' while the
+	channel's Wave was still loading. A loop that would have started by now
+	joins the running sequencer right away, from the point it would have
+	reached if started on time, with a short fade-in. Anything else is pressed
+	as usual. Not recorded as an action: see recordKeyPress(). */
+
+	void keyPressLate(ID channelId, int velocity, Frame pressFrame, bool canQuantize, bool seqIsRunning,
+	    Frame currentFrame, Frame currentFrameQuantized);
+
+	/* recordKeyPress, recordKeyRelease
+	Record a key press or release as an action, without playing anything. Used
+	while the channel's Wave is still loading, so that the action lands where
+	the key was actually pressed. */
+
+	void recordKeyPress(ID channelId, Frame currentFrameQuantized);
+	void recordKeyRelease(ID channelId, Frame currentFrameQuantized);
+
 	void processMidiEvent(ID channelId, const MidiEvent&, bool canRecordActions, Frame currentFrameQuantized);
 	void setInputMonitor(ID channelId, bool value);
 	void setVolume(ID channelId, float value);
@@ -164,6 +192,15 @@ public:
 	void setPreviewTracker(Frame f);
 	void stopAll();
 	void rewindAll();
+
+	/* resetPlayback
+	Brings all channels back to a clean starting point: pending quantized and
+	render requests are dropped and trackers go back to the beginning. Loops and
+	MIDI channels that were playing or waiting will start over on the next first
+	beat, everything else is stopped. Must be called only when the mixer is
+	disabled. */
+
+	void resetPlayback();
 	bool saveSample(ID channelId, const std::string& filePath);
 
 	/* consolidateChannels
@@ -29,11 +29,13 @@
 
 #include "core/channels/samplePlayer.h"
 #include "core/const.h"
+#include "core/cpuMeter.h"
 #include "core/midiEvent.h"
 #include "core/queue.h"
 #include "core/resampler.h"
 #include "deps/mcl-audio-buffer/src/audioBuffer.hpp"
 #include <juce_audio_basics/juce_audio_basics.h>
+#include <cstdint>
 #include <optional>
 
 namespace giada::m
@@ -61,6 +63,55 @@ struct ChannelShared final
 	WeakAtomic<ChannelStatus> recStatus   = ChannelStatus::OFF;
 	WeakAtomic<bool>          readActions = false;
 
+	/* Continuous parameters, changed by the user while audio is running. They
+	are written in place without a model swap and read by the audio thread. The
+	Channel (and SamplePlayer) copies in the Layout are kept in sync and remain
+	the reference values for UI and serialization. */
+
+	WeakAtomic<float> volume = G_DEFAULT_VOL;
+	WeakAtomic<float> pan    = G_DEFAULT_PAN;
+	WeakAtomic<float> pitch  = G_DEFAULT_PITCH;
+
+	/* fadeIn
+	Frames of fade-in still to be applied to the sample being played. Set when
+	a channel starts halfway through its sample, written by the audio thread
+	afterwards. */
+
+	WeakAtomic<Frame> fadeIn = 0;
+
+	/* active
+	Whether the channel is rendered in the current block or skipped. Set by the
+	Mixer at the beginning of each block. */
+
+	bool active = false;
+
+	/* silentFrames
+	Number of consecutive silent frames produced by the channel's plug-in stack.
+	Used to figure out when a plug-in tail has died out. Touched only by the
+	thread rendering the channel. */
+
+	Frame silentFrames = 0;
+
+	/* pluginsVersion
+	Fingerprint of the plug-in stack as seen in the last block: when it changes,
+	the plug-in tail starts over (see Channel::isActive()). Touched only by the
+	audio thread. */
+
+	std::uint64_t pluginsVersion = 0;
+
+	/* statusPending
+	Set when playStatus changes while the channel is being rendered by a
+	RenderPool worker: the MIDI lighting message is sent later on by the audio
+	thread (see Channel::sendPendingStatus()), as KernelMidi accepts messages
+	only from a fixed number of threads. */
+
+	bool statusPending = false;
+
+	/* cpuMeter
+	Time spent rendering the channel on each audio block, plug-ins included. */
+
+	CpuMeter cpuMeter;
+
 	std::optional<Quantizer> quantizer;
 
 	/* Optional render queue for sample-based channels. Used by SampleReactor
@@ -68,10 +119,11 @@ struct ChannelShared final
 
 	std::optional<RenderQueue> renderQueue = {};
 
-	/* Optional resampler for sample-based channels. Unfortunately a Resampler
-	object (based on libsamplerate) doesn't like to get copied while rendering
-	audio, so can't live inside WaveReader object (which is copied on model 
-	changes by the Swapper mechanism). Let's put it in the shared state here. */
+	/* Optional resampler for sample-based channels. A Resampler object keeps
+	the fractional read position across audio blocks, so it can't live inside
+	WaveReader object (which is copied on model changes by the Swapper 
+	mechanism): a stale copy would make the playback jump. Let's put it in the
+	shared state here. */
 
 	std::optional<Resampler> resampler = {};
 };
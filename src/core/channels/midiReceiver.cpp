@@ -30,13 +30,12 @@
 
 namespace giada::m
 {
-void MidiReceiver::advance(ID channelId, ChannelShared::MidiQueue& midiQueue, const Sequencer::Event& e) const
+void MidiReceiver::advance(ChannelShared::MidiQueue& midiQueue, const Sequencer::Event& e) const
 {
 	if (e.type != Sequencer::EventType::ACTIONS)
 		return;
-	for (const Action& action : *e.actions)
-		if (action.channelId == channelId)
-			sendToPlugins(midiQueue, action.event, e.delta);
+	for (const Action& action : e.actions)
+		sendToPlugins(midiQueue, action.event, e.delta);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -37,7 +37,7 @@ class Plugin;
 class MidiReceiver final
 {
 public:
-	void advance(ID channelId, ChannelShared::MidiQueue&, const Sequencer::Event&) const;
+	void advance(ChannelShared::MidiQueue&, const Sequencer::Event&) const;
 	void render(ChannelShared&, const std::vector<Plugin*>&, PluginHost&) const;
 
 	void parseMidi(ChannelShared::MidiQueue&, const MidiEvent&) const;
@@ -49,12 +49,12 @@ MidiSender::MidiSender(const Patch::Channel& p, KernelMidi& k)
 
 /* -------------------------------------------------------------------------- */
 
-void MidiSender::advance(ID channelId, const Sequencer::Event& e) const
+void MidiSender::advance(const Sequencer::Event& e) const
 {
 	if (!enabled)
 		return;
 	if (e.type == Sequencer::EventType::ACTIONS)
-		parseActions(channelId, *e.actions);
+		parseActions(e.actions);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -78,10 +78,9 @@ void MidiSender::send(MidiEvent e) const
 
 /* -------------------------------------------------------------------------- */
 
-void MidiSender::parseActions(ID channelId, const std::vector<Action>& as) const
+void MidiSender::parseActions(std::span<const Action> as) const
 {
 	for (const Action& a : as)
-		if (a.channelId == channelId)
-			send(a.event);
+		send(a.event);
 }
 } // namespace giada::m
\ No newline at end of file
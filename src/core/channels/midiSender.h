@@ -40,7 +40,7 @@ public:
 	MidiSender(const Patch::Channel& p, KernelMidi&);
 	MidiSender(const MidiSender& o) = default;
 
-	void advance(ID channelId, const Sequencer::Event& e) const;
+	void advance(const Sequencer::Event& e) const;
 
 	void stop();
 
@@ -63,7 +63,7 @@ public:
 
 private:
 	void send(MidiEvent e) const;
-	void parseActions(ID channelId, const std::vector<Action>& as) const;
+	void parseActions(std::span<const Action> as) const;
 };
 } // namespace giada::m
 
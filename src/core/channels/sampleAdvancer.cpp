@@ -59,7 +59,7 @@ void SampleAdvancer::onLastFrame(ChannelShared& shared, bool seqIsRunning, bool
 
 /* -------------------------------------------------------------------------- */
 
-void SampleAdvancer::advance(ID channelId, ChannelShared& shared,
+void SampleAdvancer::advance(ChannelShared& shared,
     const Sequencer::Event& e, SamplePlayerMode mode, bool isLoop) const
 {
 	switch (e.type)
@@ -79,7 +79,7 @@ void SampleAdvancer::advance(ID channelId, ChannelShared& shared,
 
 	case Sequencer::EventType::ACTIONS:
 		if (!isLoop && shared.isReadingActions())
-			parseActions(channelId, shared, *e.actions, e.delta, mode);
+			parseActions(shared, e.actions, e.delta, mode);
 		break;
 
 	default:
@@ -190,14 +190,11 @@ void SampleAdvancer::onNoteOn(ChannelShared& shared, Frame localFrame, SamplePla
 
 /* -------------------------------------------------------------------------- */
 
-void SampleAdvancer::parseActions(ID channelId, ChannelShared& shared,
-    const std::vector<Action>& as, Frame localFrame, SamplePlayerMode mode) const
+void SampleAdvancer::parseActions(ChannelShared& shared, std::span<const Action> as,
+    Frame localFrame, SamplePlayerMode mode) const
 {
 	for (const Action& a : as)
 	{
-		if (a.channelId != channelId)
-			continue;
-
 		switch (a.event.getStatus())
 		{
 		case MidiEvent::CHANNEL_NOTE_ON:
@@ -64,6 +64,7 @@ SamplePlayer::SamplePlayer(const Patch::Channel& p, float samplerateRatio, Resam
 bool SamplePlayer::hasWave() const { return waveReader.wave != nullptr; }
 bool SamplePlayer::hasLogicalWave() const { return hasWave() && waveReader.wave->isLogical(); }
 bool SamplePlayer::hasEditedWave() const { return hasWave() && waveReader.wave->isEdited(); }
+bool SamplePlayer::hasStreamedWave() const { return hasWave() && waveReader.wave->isStreamed(); }
 
 /* -------------------------------------------------------------------------- */
 
@@ -93,7 +94,7 @@ ID SamplePlayer::getWaveId() const
 
 Frame SamplePlayer::getWaveSize() const
 {
-	return hasWave() ? waveReader.wave->getBuffer().countFrames() : 0;
+	return hasWave() ? waveReader.wave->getSize() : 0;
 }
 
 /* -------------------------------------------------------------------------- */
@@ -106,10 +107,13 @@ void SamplePlayer::render(ChannelShared& shared, Render renderInfo, bool seqIsRu
 	mcl::AudioBuffer&   buf     = shared.audioBuffer;
 	Frame               tracker = std::clamp(shared.tracker.load(), begin, end); /* Make sure tracker stays within begin-end range. */
 	const ChannelStatus status  = shared.playStatus.load();
+	const float         pitch   = shared.pitch.load();
+
+	waveReader.prefetch(begin, end);
 
 	if (renderInfo.mode == Render::Mode::NORMAL)
 	{
-		tracker = render(buf, tracker, renderInfo.offset, status, seqIsRunning);
+		tracker = render(buf, tracker, renderInfo.offset, pitch, status, seqIsRunning);
 	}
 	else
 	{
@@ -119,14 +123,14 @@ void SamplePlayer::render(ChannelShared& shared, Render renderInfo, bool seqIsRu
 		might stop the rendering): fillBuffer() is just enough. Just notify 
 		waveReader this is the last read before rewind. */
 
-		tracker = fillBuffer(buf, tracker, 0).used;
+		tracker = fillBuffer(buf, tracker, 0, pitch).used;
 		waveReader.last();
 
 		/* Mode::REWIND: 2nd = [abcdefghi|abcdfefg]
 		   Mode::STOP:   2nd = [abcdefghi|--------] */
 
 		if (renderInfo.mode == Render::Mode::REWIND)
-			tracker = render(buf, begin, renderInfo.offset, status, seqIsRunning);
+			tracker = render(buf, begin, renderInfo.offset, pitch, status, seqIsRunning);
 		else
 			tracker = stop(buf, renderInfo.offset, seqIsRunning);
 	}
@@ -136,11 +140,11 @@ void SamplePlayer::render(ChannelShared& shared, Render renderInfo, bool seqIsRu
 
 /* -------------------------------------------------------------------------- */
 
-Frame SamplePlayer::render(mcl::AudioBuffer& buf, Frame tracker, Frame offset, ChannelStatus status, bool seqIsRunning) const
+Frame SamplePlayer::render(mcl::AudioBuffer& buf, Frame tracker, Frame offset, float pitch, ChannelStatus status, bool seqIsRunning) const
 {
 	/* First pass rendering. */
 
-	WaveReader::Result res = fillBuffer(buf, tracker, offset);
+	WaveReader::Result res = fillBuffer(buf, tracker, offset, pitch);
 	tracker += res.used;
 
 	/* Second pass rendering: if tracker has looped, special care is needed. If 
@@ -156,7 +160,7 @@ Frame SamplePlayer::render(mcl::AudioBuffer& buf, Frame tracker, Frame offset, C
 		onLastFrame(/*natural=*/true, seqIsRunning);
 
 		if (shouldLoop(status) && res.generated < buf.countFrames())
-			tracker += fillBuffer(buf, tracker, res.generated).used;
+			tracker += fillBuffer(buf, tracker, res.generated, pitch).used;
 	}
 
 	return tracker;
@@ -192,7 +196,7 @@ void SamplePlayer::loadWave(ChannelShared& shared, Wave* w, Frame newBegin, Fram
 	{
 		shift = newShift == -1 ? 0 : newShift;
 		begin = newBegin == -1 ? 0 : newBegin;
-		end   = newEnd == -1 ? w->getBuffer().countFrames() - 1 : newEnd;
+		end   = newEnd == -1 ? w->getSize() - 1 : newEnd;
 	}
 }
 
@@ -226,7 +230,7 @@ void SamplePlayer::kickIn(ChannelShared& shared, Frame f)
 
 /* -------------------------------------------------------------------------- */
 
-WaveReader::Result SamplePlayer::fillBuffer(mcl::AudioBuffer& buf, Frame start, Frame offset) const
+WaveReader::Result SamplePlayer::fillBuffer(mcl::AudioBuffer& buf, Frame start, Frame offset, float pitch) const
 {
 	return waveReader.fill(buf, start, end, offset, pitch);
 }
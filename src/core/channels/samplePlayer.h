@@ -68,6 +68,7 @@ public:
 	bool  hasWave() const;
 	bool  hasLogicalWave() const;
 	bool  hasEditedWave() const;
+	bool  hasStreamedWave() const;
 	bool  isAnyLoopMode() const;
 	ID    getWaveId() const;
 	Frame getWaveSize() const;
@@ -93,7 +94,7 @@ public:
 
 	void kickIn(ChannelShared&, Frame f);
 
-	float            pitch;
+	float            pitch; // Non-realtime copy, see ChannelShared::pitch
 	SamplePlayerMode mode;
 	Frame            shift;
 	Frame            begin;
@@ -115,7 +116,7 @@ private:
 	into the audio buffer at position 'offset'. May fire 'onLastFrame' callback
 	if the sample end is reached. */
 
-	Frame render(mcl::AudioBuffer&, Frame tracker, Frame offset, ChannelStatus, bool seqIsRunning) const;
+	Frame render(mcl::AudioBuffer&, Frame tracker, Frame offset, float pitch, ChannelStatus, bool seqIsRunning) const;
 
 	/* stop
 	Silences the last part of the audio buffer, starting at 'offset'. Used to
@@ -123,7 +124,7 @@ private:
 
 	Frame stop(mcl::AudioBuffer&, Frame offset, bool seqIsRunning) const;
 
-	WaveReader::Result fillBuffer(mcl::AudioBuffer&, Frame start, Frame offset) const;
+	WaveReader::Result fillBuffer(mcl::AudioBuffer&, Frame start, Frame offset, float pitch) const;
 	bool               shouldLoop(ChannelStatus) const;
 };
 } // namespace giada::m
@@ -33,36 +33,40 @@ namespace giada::m
 namespace
 {
 constexpr int Q_ACTION_PLAY   = 0;
-constexpr int Q_ACTION_REWIND = 10000; // Avoid clash with Q_ACTION_PLAY + channelId
+constexpr int Q_ACTION_REWIND = 1;
 } // namespace
 
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
 
-SampleReactor::SampleReactor(ChannelShared& shared, ID channelId)
+SampleReactor::SampleReactor(ChannelShared& shared)
 {
-	shared.quantizer->schedule(Q_ACTION_PLAY + channelId, [this, &shared](Frame delta) {
-		play(shared, delta);
+	/* The quantizer lives in the channel's shared state, which has a stable 
+	address: pass it along as callback context. */
+
+	shared.quantizer->schedule(Q_ACTION_PLAY, &shared, [](void* ctx, Frame delta) {
+		play(*static_cast<ChannelShared*>(ctx), delta);
 	});
 
-	shared.quantizer->schedule(Q_ACTION_REWIND + channelId, [this, &shared](Frame delta) {
-		const ChannelStatus status = shared.playStatus.load();
+	shared.quantizer->schedule(Q_ACTION_REWIND, &shared, [](void* ctx, Frame delta) {
+		ChannelShared&      channelShared = *static_cast<ChannelShared*>(ctx);
+		const ChannelStatus status        = channelShared.playStatus.load();
 		if (status == ChannelStatus::OFF)
-			play(shared, delta);
+			play(channelShared, delta);
 		else if (status == ChannelStatus::PLAY || status == ChannelStatus::ENDING)
-			rewind(shared, delta);
+			rewind(channelShared, delta);
 	});
 }
 
-void SampleReactor::rewind(ChannelShared& shared, Frame localFrame) const
+void SampleReactor::rewind(ChannelShared& shared, Frame localFrame)
 {
 	shared.renderQueue->push({SamplePlayer::Render::Mode::REWIND, localFrame});
 }
 
 /* -------------------------------------------------------------------------- */
 
-void SampleReactor::play(ChannelShared& shared, Frame localFrame) const
+void SampleReactor::play(ChannelShared& shared, Frame localFrame)
 {
 	shared.playStatus.store(ChannelStatus::PLAY);
 	shared.renderQueue->push({SamplePlayer::Render::Mode::NORMAL, localFrame});
@@ -70,14 +74,14 @@ void SampleReactor::play(ChannelShared& shared, Frame localFrame) const
 
 /* -------------------------------------------------------------------------- */
 
-void SampleReactor::stop(ChannelShared& shared) const
+void SampleReactor::stop(ChannelShared& shared)
 {
 	shared.renderQueue->push({SamplePlayer::Render::Mode::STOP, 0});
 }
 
 /* -------------------------------------------------------------------------- */
 
-ChannelStatus SampleReactor::pressWhileOff(ID channelId, ChannelShared& shared,
+ChannelStatus SampleReactor::pressWhileOff(ChannelShared& shared,
     int velocity, bool canQuantize, bool velocityAsVol, float& volume_i) const
 {
 	if (velocityAsVol)
@@ -85,7 +89,7 @@ ChannelStatus SampleReactor::pressWhileOff(ID channelId, ChannelShared& shared,
 
 	if (canQuantize)
 	{
-		shared.quantizer->trigger(Q_ACTION_PLAY + channelId);
+		shared.quantizer->trigger(Q_ACTION_PLAY);
 		return ChannelStatus::OFF;
 	}
 	else
@@ -94,14 +98,14 @@ ChannelStatus SampleReactor::pressWhileOff(ID channelId, ChannelShared& shared,
 
 /* -------------------------------------------------------------------------- */
 
-ChannelStatus SampleReactor::pressWhilePlay(ID channelId, ChannelShared& shared,
+ChannelStatus SampleReactor::pressWhilePlay(ChannelShared& shared,
     SamplePlayerMode mode, bool canQuantize) const
 {
 	switch (mode)
 	{
 	case SamplePlayerMode::SINGLE_RETRIG:
 		if (canQuantize)
-			shared.quantizer->trigger(Q_ACTION_REWIND + channelId);
+			shared.quantizer->trigger(Q_ACTION_REWIND);
 		else
 			rewind(shared, /*localFrame=*/0);
 		return ChannelStatus::PLAY;
@@ -120,7 +124,7 @@ ChannelStatus SampleReactor::pressWhilePlay(ID channelId, ChannelShared& shared,
 
 /* -------------------------------------------------------------------------- */
 
-void SampleReactor::keyPress(ID channelId, ChannelShared& shared, SamplePlayerMode mode,
+void SampleReactor::keyPress(ChannelShared& shared, SamplePlayerMode mode,
     int velocity, bool canQuantize, bool isLoop, bool velocityAsVol, float& volume_i) const
 {
 	ChannelStatus playStatus = shared.playStatus.load();
@@ -131,14 +135,14 @@ void SampleReactor::keyPress(ID channelId, ChannelShared& shared, SamplePlayerMo
 		if (isLoop)
 			playStatus = ChannelStatus::WAIT;
 		else
-			playStatus = pressWhileOff(channelId, shared, velocity, canQuantize, velocityAsVol, volume_i);
+			playStatus = pressWhileOff(shared, velocity, canQuantize, velocityAsVol, volume_i);
 		break;
 
 	case ChannelStatus::PLAY:
 		if (isLoop)
 			playStatus = ChannelStatus::ENDING;
 		else
-			playStatus = pressWhilePlay(channelId, shared, mode, canQuantize);
+			playStatus = pressWhilePlay(shared, mode, canQuantize);
 		break;
 
 	case ChannelStatus::WAIT:
@@ -52,19 +52,20 @@ public:
 		Frame offset;
 	};
 
-	SampleReactor(ChannelShared&, ID channelId);
+	SampleReactor(ChannelShared&);
 
 	void stopBySeq(ChannelShared&, bool chansStopOnSeqHalt, bool isLoop) const;
-	void keyPress(ID channelId, ChannelShared&, SamplePlayerMode, int velocity, bool canQuantize, bool isLoop, bool velocityAsVol, float& volume_i) const;
+	void keyPress(ChannelShared&, SamplePlayerMode, int velocity, bool canQuantize, bool isLoop, bool velocityAsVol, float& volume_i) const;
 	void keyRelease(ChannelShared&, SamplePlayerMode) const;
 	void keyKill(ChannelShared&, SamplePlayerMode) const;
 
 private:
-	ChannelStatus pressWhilePlay(ID channelId, ChannelShared&, SamplePlayerMode, bool canQuantize) const;
-	ChannelStatus pressWhileOff(ID channelId, ChannelShared&, int velocity, bool canQuantize, bool velocityAsVol, float& volume_i) const;
-	void          rewind(ChannelShared&, Frame localFrame) const;
-	void          play(ChannelShared&, Frame localFrame) const;
-	void          stop(ChannelShared&) const;
+	static void rewind(ChannelShared&, Frame localFrame);
+	static void play(ChannelShared&, Frame localFrame);
+	static void stop(ChannelShared&);
+
+	ChannelStatus pressWhilePlay(ChannelShared&, SamplePlayerMode, bool canQuantize) const;
+	ChannelStatus pressWhileOff(ChannelShared&, int velocity, bool canQuantize, bool velocityAsVol, float& volume_i) const;
 };
 
 } // namespace giada::m
@@ -25,9 +25,12 @@
  * -------------------------------------------------------------------------- */
 
 #include "waveReader.h"
+#include "core/audioKernels.h"
 #include "core/const.h"
 #include "core/model/model.h"
+#include "core/resampler.h"
 #include "core/wave.h"
+#include "core/waveStream.h"
 #include "deps/mcl-audio-buffer/src/audioBuffer.hpp"
 #include "utils/log.h"
 #include <algorithm>
@@ -36,6 +39,21 @@
 
 namespace giada::m
 {
+namespace
+{
+/* PADDING_
+Input frames gathered on each side of a chunk by fillChunked(), so that the
+resampler never reads past the gathered data. Scratch buffers must leave room
+for some actual data besides. */
+
+constexpr Frame PADDING_ = Resampler::maxHalfTaps();
+
+static_assert(G_COMPACT_SCRATCH_FRAMES >= PADDING_ * 2 * G_MAX_PITCH);
+static_assert(WaveStream::SCRATCH_FRAMES >= PADDING_ * 2 * G_MAX_PITCH);
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+
 WaveReader::WaveReader(Resampler* r)
 : wave(nullptr)
 , m_resampler(r)
@@ -49,9 +67,13 @@ WaveReader::Result WaveReader::fill(mcl::AudioBuffer& out, Frame start, Frame ma
 {
 	assert(wave != nullptr);
 	assert(start >= 0);
-	assert(max <= wave->getBuffer().countFrames());
+	assert(max <= wave->getSize());
 	assert(offset < out.countFrames());
 
+	if (wave->isStreamed())
+		return fillStreamed(out, start, max, offset, pitch);
+	if (wave->isCompact())
+		return fillCompact(out, start, max, offset, pitch);
 	if (pitch == 1.0f)
 		return fillCopy(out, start, max, offset);
 	else
@@ -67,6 +89,7 @@ WaveReader::Result WaveReader::fillResampled(mcl::AudioBuffer& dest, Frame start
 	    /*input=*/wave->getBuffer()[0],
 	    /*inputPos=*/start,
 	    /*inputLen=*/max,
+	    /*inputChannels=*/wave->getBuffer().countChannels(),
 	    /*output=*/dest[offset],
 	    /*outputLen=*/dest.countFrames() - offset,
 	    /*pitch=*/pitch);
@@ -85,11 +108,110 @@ WaveReader::Result WaveReader::fillCopy(mcl::AudioBuffer& dest, Frame start,
 	if (used > max - start)
 		used = max - start;
 
-	dest.set(wave->getBuffer(), used, start, offset);
+	if (used <= 0)
+		return {0, 0};
+
+	/* Mono Waves are kept mono in memory and spread over the two output
+	channels here, on the fly. */
+
+	if (wave->getBuffer().countChannels() == 1)
+		kernels::upmix(wave->getBuffer()[start], used, dest[offset]);
+	else
+		dest.set(wave->getBuffer(), used, start, offset);
 
 	return {used, used};
 }
 
+/* -------------------------------------------------------------------------- */
+
+template <typename F>
+WaveReader::Result WaveReader::fillChunked(mcl::AudioBuffer& dest, Frame start,
+    Frame max, Frame offset, float pitch, float* scratch, Frame scratchFrames, F gather) const
+{
+	/* Gather input data in the scratch buffer first, with some padding on both
+	sides for the resampler's filter taps, then resample from there. Work in
+	chunks if the scratch buffer is too small for the whole block. */
+
+	const Frame frames = dest.countFrames() - offset;
+	const Frame chunk  = std::max(1, static_cast<Frame>((scratchFrames - PADDING_ * 2 - 2) / pitch));
+
+	Result res = {0, 0};
+	while (res.generated < frames)
+	{
+		const Frame first  = start + res.used - PADDING_;
+		const Frame count  = std::min(scratchFrames, max - first);
+		const Frame output = std::min(chunk, frames - res.generated);
+
+		gather(scratch, first, count);
+
+		const Resampler::Result r = m_resampler->process(
+		    /*input=*/scratch,
+		    /*inputPos=*/PADDING_,
+		    /*inputLen=*/count,
+		    /*inputChannels=*/G_MAX_IO_CHANS,
+		    /*output=*/dest[offset + res.generated],
+		    /*outputLen=*/output,
+		    /*pitch=*/pitch);
+
+		res.used += static_cast<Frame>(r.used);
+		res.generated += static_cast<Frame>(r.generated);
+
+		if (r.generated < output) // End of data reached
+			break;
+	}
+
+	return res;
+}
+
+/* -------------------------------------------------------------------------- */
+
+WaveReader::Result WaveReader::fillStreamed(mcl::AudioBuffer& dest, Frame start,
+    Frame max, Frame offset, float pitch) const
+{
+	WaveStream&             stream = *wave->getStream();
+	const mcl::AudioBuffer& head   = wave->getBuffer();
+
+	if (pitch == 1.0f)
+	{
+		const Frame used = std::min(dest.countFrames() - offset, max - start);
+		stream.read(head, dest[offset], start, used);
+		return {used, used};
+	}
+
+	return fillChunked(dest, start, max, offset, pitch, stream.getScratch(), WaveStream::SCRATCH_FRAMES,
+	    [&stream, &head](float* out, Frame first, Frame count) {
+		    stream.read(head, out, first, count);
+	    });
+}
+
+/* -------------------------------------------------------------------------- */
+
+WaveReader::Result WaveReader::fillCompact(mcl::AudioBuffer& dest, Frame start,
+    Frame max, Frame offset, float pitch) const
+{
+	const CompactBuffer& compact = *wave->getCompact();
+
+	if (pitch == 1.0f)
+	{
+		const Frame used = std::min(dest.countFrames() - offset, max - start);
+		compact.read(dest[offset], start, used);
+		return {used, used};
+	}
+
+	/* Compact data is decoded on the stack: no shared scratch buffer, so that
+	the same Wave can be rendered by multiple threads at once (e.g. the preview
+	channel). */
+
+	float scratch[G_COMPACT_SCRATCH_FRAMES * G_MAX_IO_CHANS];
+
+	return fillChunked(dest, start, max, offset, pitch, scratch, G_COMPACT_SCRATCH_FRAMES,
+	    [&compact](float* out, Frame first, Frame count) {
+		    compact.read(out, first, count);
+	    });
+}
+
+/* -------------------------------------------------------------------------- */
+
 void WaveReader::last() const
 {
 	if (m_resampler != nullptr)
@@ -98,6 +220,14 @@ void WaveReader::last() const
 
 /* -------------------------------------------------------------------------- */
 
+void WaveReader::prefetch(Frame begin, Frame end) const
+{
+	if (wave != nullptr && wave->isStreamed())
+		wave->getStream()->setLoopPoints(begin, end);
+}
+
+/* -------------------------------------------------------------------------- */
+
 void WaveReader::setResampler(Resampler* r)
 {
 	m_resampler = r;
@@ -69,6 +69,12 @@ public:
 
 	void last() const;
 
+	/* prefetch
+	Tells the disk streamer where the loop points are, so that audio around
+	them is read ahead of time. Ignored if Wave is not streamed. */
+
+	void prefetch(Frame begin, Frame end) const;
+
 	/* setResampler
 	Sets a pointer to another Resampler object. Might be needed when copy-assigning
 	objects containing this class. */
@@ -84,6 +90,19 @@ private:
 	Result fillResampled(mcl::AudioBuffer& out, Frame start, Frame max, Frame offset,
 	    float pitch) const;
 	Result fillCopy(mcl::AudioBuffer& out, Frame start, Frame max, Frame offset) const;
+	Result fillStreamed(mcl::AudioBuffer& out, Frame start, Frame max, Frame offset,
+	    float pitch) const;
+	Result fillCompact(mcl::AudioBuffer& out, Frame start, Frame max, Frame offset,
+	    float pitch) const;
+
+	/* fillChunked
+	Resamples Wave data that the Resampler can't read directly: 'gather'
+	decodes it into 'scratch', 'scratchFrames' stereo frames long, a chunk at a
+	time. */
+
+	template <typename F>
+	Result fillChunked(mcl::AudioBuffer& out, Frame start, Frame max, Frame offset,
+	    float pitch, float* scratch, Frame scratchFrames, F gather) const;
 
 	Resampler* m_resampler;
 };
@@ -0,0 +1,180 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2023 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#include "core/compactBuffer.h"
+#include "core/audioKernels.h"
+#include "core/const.h"
+#include "deps/mcl-audio-buffer/src/audioBuffer.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace giada::m
+{
+namespace
+{
+/* quantize_
+Converts float sample 'x' to a signed integer with 'bits' bits, rounded and
+clamped to the valid range. */
+
+int32_t quantize_(float x, int bits)
+{
+	const float scale = static_cast<float>(1 << (bits - 1));
+	const long  v     = std::lrint(x * scale);
+	return static_cast<int32_t>(std::clamp(v, static_cast<long>(-scale), static_cast<long>(scale) - 1));
+}
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+bool CompactBuffer::canCompact(int bits)
+{
+	return bits > 0 && bits <= 24;
+}
+
+/* -------------------------------------------------------------------------- */
+
+CompactBuffer::CompactBuffer(const mcl::AudioBuffer& b, int bits)
+: m_frames(b.countFrames())
+, m_channels(b.countChannels())
+, m_bits(bits <= 16 ? 16 : 24)
+{
+	assert(canCompact(bits));
+
+	const std::size_t samples = static_cast<std::size_t>(m_frames) * m_channels;
+	const float*      src     = b[0];
+
+	if (m_bits == 16)
+	{
+		m_pcm16.resize(samples);
+		for (std::size_t i = 0; i < samples; i++)
+			m_pcm16[i] = static_cast<int16_t>(quantize_(src[i], 16));
+	}
+	else
+	{
+		m_pcm24.resize(samples * 3);
+		for (std::size_t i = 0; i < samples; i++)
+		{
+			const int32_t v    = quantize_(src[i], 24);
+			m_pcm24[i * 3]     = static_cast<uint8_t>(v);
+			m_pcm24[i * 3 + 1] = static_cast<uint8_t>(v >> 8);
+			m_pcm24[i * 3 + 2] = static_cast<uint8_t>(v >> 16);
+		}
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+Frame       CompactBuffer::countFrames() const { return m_frames; }
+int         CompactBuffer::countChannels() const { return m_channels; }
+int         CompactBuffer::getBits() const { return m_bits; }
+std::size_t CompactBuffer::getBytes() const { return m_pcm16.size() * sizeof(int16_t) + m_pcm24.size(); }
+
+/* -------------------------------------------------------------------------- */
+
+void CompactBuffer::decode(float* out, Frame start, Frame count) const
+{
+	assert(start >= 0 && start + count <= m_frames);
+
+	const int samples = count * m_channels;
+	if (m_bits == 16)
+		kernels::pcm16ToFloat(m_pcm16.data() + start * m_channels, samples, out);
+	else
+		kernels::pcm24ToFloat(m_pcm24.data() + start * m_channels * 3, samples, out);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void CompactBuffer::decodeInt(int32_t* out, Frame start, Frame count) const
+{
+	assert(start >= 0 && start + count <= m_frames);
+
+	const std::size_t first   = static_cast<std::size_t>(start) * m_channels;
+	const std::size_t samples = static_cast<std::size_t>(count) * m_channels;
+
+	for (std::size_t i = 0; i < samples; i++)
+	{
+		if (m_bits == 16)
+			out[i] = static_cast<int32_t>(static_cast<uint32_t>(m_pcm16[first + i]) << 16);
+		else
+		{
+			const uint8_t* s = m_pcm24.data() + (first + i) * 3;
+			out[i]           = static_cast<int32_t>((uint32_t(s[0]) << 8) | (uint32_t(s[1]) << 16) | (uint32_t(s[2]) << 24));
+		}
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+void CompactBuffer::read(float* out, Frame start, Frame count) const
+{
+	/* Silence outside the valid range, on both sides. */
+
+	const Frame first = std::max(start, 0);
+	const Frame last  = std::min(start + count, m_frames);
+
+	if (last <= first)
+	{
+		std::fill(out, out + count * G_MAX_IO_CHANS, 0.0f);
+		return;
+	}
+
+	std::fill(out, out + (first - start) * G_MAX_IO_CHANS, 0.0f);
+	std::fill(out + (last - start) * G_MAX_IO_CHANS, out + count * G_MAX_IO_CHANS, 0.0f);
+
+	out += (first - start) * G_MAX_IO_CHANS;
+
+	if (m_channels == G_MAX_IO_CHANS)
+	{
+		decode(out, first, last - first);
+		return;
+	}
+
+	/* Mono: decode to a small temporary buffer first, then upmix. */
+
+	constexpr Frame CHUNK = 256;
+	float           mono[CHUNK];
+
+	for (Frame f = first; f < last; f += CHUNK)
+	{
+		const Frame n = std::min(CHUNK, last - f);
+		decode(mono, f, n);
+		kernels::upmix(mono, n, out + (f - first) * G_MAX_IO_CHANS);
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+mcl::AudioBuffer CompactBuffer::toAudioBuffer() const
+{
+	mcl::AudioBuffer b(m_frames, m_channels);
+	if (m_frames > 0)
+		decode(b[0], 0, m_frames);
+	return b;
+}
+} // namespace giada::m
@@ -0,0 +1,101 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2023 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#ifndef G_COMPACT_BUFFER_H
+#define G_COMPACT_BUFFER_H
+
+#include "core/types.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace mcl
+{
+class AudioBuffer;
+}
+
+namespace giada::m
+{
+/* CompactBuffer
+Interleaved audio data stored as 16 or 24-bit integer PCM instead of 32-bit
+float: half or three quarters of the memory of a mcl::AudioBuffer, at the cost
+of a conversion while reading. Immutable once created, so it can be read by
+multiple threads at the same time. */
+
+class CompactBuffer final
+{
+public:
+	/* canCompact
+	True if audio data with 'bits' bits per sample can be compacted with no
+	loss, i.e. comes from an integer format up to 24 bits. */
+
+	static bool canCompact(int bits);
+
+	/* CompactBuffer
+	Quantizes float buffer 'b' to 16 bits per sample if 'bits' <= 16, to 24
+	bits otherwise. */
+
+	CompactBuffer(const mcl::AudioBuffer& b, int bits);
+
+	Frame       countFrames() const;
+	int         countChannels() const;
+	int         getBits() const;
+	std::size_t getBytes() const;
+
+	/* decode
+	Converts 'count' frames starting from 'start' to float, with the original
+	channel layout. The range must be valid. Real-time safe. */
+
+	void decode(float* out, Frame start, Frame count) const;
+
+	/* decodeInt
+	Same as decode(), but to 32-bit integers holding the sample in their most
+	significant bits, as expected by libsndfile's sf_writef_int(). */
+
+	void decodeInt(int32_t* out, Frame start, Frame count) const;
+
+	/* read
+	Same as decode(), but produces G_MAX_IO_CHANS interleaved channels (mono
+	data is upmixed) and frames outside [0, countFrames()) are silent. This is
+	what WaveReader needs. Real-time safe. */
+
+	void read(float* out, Frame start, Frame count) const;
+
+	/* toAudioBuffer
+	Decodes the whole content into a new float buffer. */
+
+	mcl::AudioBuffer toAudioBuffer() const;
+
+private:
+	std::vector<int16_t> m_pcm16;
+	std::vector<uint8_t> m_pcm24; // 3 bytes per sample, little-endian
+	Frame                m_frames;
+	int                  m_channels;
+	int                  m_bits;
+};
+} // namespace giada::m
+
+#endif
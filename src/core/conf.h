@@ -40,21 +40,27 @@ namespace giada::m
 {
 struct Conf final
 {
-	bool               valid            = false;
-	int                logMode          = LOG_MODE_MUTE;
-	bool               showTooltips     = true;
-	std::string        langMap          = "";
-	RtAudio::Api       soundSystem      = G_DEFAULT_SOUNDSYS;
-	int                soundDeviceOut   = G_DEFAULT_SOUNDDEV_OUT;
-	int                soundDeviceIn    = G_DEFAULT_SOUNDDEV_IN;
-	int                channelsOutCount = G_MAX_IO_CHANS;
-	int                channelsOutStart = 0;
-	int                channelsInCount  = 1;
-	int                channelsInStart  = 0;
-	int                samplerate       = G_DEFAULT_SAMPLERATE;
-	int                buffersize       = G_DEFAULT_BUFSIZE;
-	bool               limitOutput      = false;
-	Resampler::Quality rsmpQuality      = Resampler::Quality::SINC_BEST;
+	bool               valid              = false;
+	int                logMode            = LOG_MODE_MUTE;
+	bool               showTooltips       = true;
+	std::string        langMap            = "";
+	RtAudio::Api       soundSystem        = G_DEFAULT_SOUNDSYS;
+	int                soundDeviceOut     = G_DEFAULT_SOUNDDEV_OUT;
+	int                soundDeviceIn      = G_DEFAULT_SOUNDDEV_IN;
+	int                channelsOutCount   = G_MAX_IO_CHANS;
+	int                channelsOutStart   = 0;
+	int                channelsInCount    = 1;
+	int                channelsInStart    = 0;
+	int                samplerate         = G_DEFAULT_SAMPLERATE;
+	int                buffersize         = G_DEFAULT_BUFSIZE;
+	bool               limitOutput        = false;
+	Resampler::Quality rsmpQuality        = Resampler::Quality::SINC_BEST;
+	int                renderThreads      = G_DEFAULT_RENDER_THREADS;
+	int                streamingThreshold = G_DEFAULT_STREAMING_THRESHOLD;
+	int                sampleMemoryBudget = G_DEFAULT_SAMPLE_BUDGET;
+	bool               lazyWaveLoading    = false;
+	std::string        nullAudioOutFile   = ""; // Runtime only, not serialized
+	std::string        nullAudioInFile    = ""; // Runtime only, not serialized
 
 	RtMidi::Api midiSystem  = G_DEFAULT_MIDI_API;
 	int         midiPortOut = G_DEFAULT_MIDI_PORT_OUT;
@@ -42,6 +42,7 @@ void sanitize_(Conf& conf)
 	conf.channelsOutStart = std::max(0, conf.channelsOutStart);
 	conf.channelsInCount  = std::max(1, conf.channelsInCount);
 	conf.channelsInStart  = std::max(0, conf.channelsInStart);
+	conf.renderThreads    = std::clamp(conf.renderThreads, G_DEFAULT_RENDER_THREADS, G_MAX_RENDER_THREADS);
 
 	conf.midiPortOut = std::max(-1, conf.midiPortOut);
 	conf.midiPortIn  = std::max(-1, conf.midiPortIn);
@@ -76,6 +77,10 @@ bool serialize(const Conf& conf)
 	j[CONF_KEY_BUFFER_SIZE]                   = conf.buffersize;
 	j[CONF_KEY_LIMIT_OUTPUT]                  = conf.limitOutput;
 	j[CONF_KEY_RESAMPLE_QUALITY]              = conf.rsmpQuality;
+	j[CONF_KEY_RENDER_THREADS]                = conf.renderThreads;
+	j[CONF_KEY_STREAMING_THRESHOLD]           = conf.streamingThreshold;
+	j[CONF_KEY_SAMPLE_MEMORY_BUDGET]          = conf.sampleMemoryBudget;
+	j[CONF_KEY_LAZY_WAVE_LOADING]             = conf.lazyWaveLoading;
 	j[CONF_KEY_MIDI_SYSTEM]                   = conf.midiSystem;
 	j[CONF_KEY_MIDI_PORT_OUT]                 = conf.midiPortOut;
 	j[CONF_KEY_MIDI_PORT_IN]                  = conf.midiPortIn;
@@ -190,6 +195,10 @@ Conf deserialize()
 	conf.buffersize                 = j.value(CONF_KEY_BUFFER_SIZE, conf.buffersize);
 	conf.limitOutput                = j.value(CONF_KEY_LIMIT_OUTPUT, conf.limitOutput);
 	conf.rsmpQuality                = j.value(CONF_KEY_RESAMPLE_QUALITY, conf.rsmpQuality);
+	conf.renderThreads              = j.value(CONF_KEY_RENDER_THREADS, conf.renderThreads);
+	conf.streamingThreshold         = j.value(CONF_KEY_STREAMING_THRESHOLD, conf.streamingThreshold);
+	conf.sampleMemoryBudget         = j.value(CONF_KEY_SAMPLE_MEMORY_BUDGET, conf.sampleMemoryBudget);
+	conf.lazyWaveLoading            = j.value(CONF_KEY_LAZY_WAVE_LOADING, conf.lazyWaveLoading);
 	conf.midiSystem                 = j.value(CONF_KEY_MIDI_SYSTEM, conf.midiSystem);
 	conf.midiPortOut                = j.value(CONF_KEY_MIDI_PORT_OUT, conf.midiPortOut);
 	conf.midiPortIn                 = j.value(CONF_KEY_MIDI_PORT_IN, conf.midiPortIn);
@@ -70,6 +70,93 @@ The rate at which KernelMidi spits out MIDI events. Note: this value will
 obviously increase the MIDI output latency, keep it small!*/
 constexpr int G_KERNEL_MIDI_OUTPUT_RATE_MS = 3;
 
+/* G_HEADLESS_LOOP_RATE_MS
+How often the main loop wakes up in headless mode, to check for quit requests
+and dispatch JUCE messages. */
+constexpr int G_HEADLESS_LOOP_RATE_MS = 50;
+
+/* G_RENDER_POOL_MIN_CHANNELS
+Minimum number of active channels required to render them in parallel on the
+RenderPool. Below this value channels are rendered by the audio thread alone, 
+as the cost of waking up workers would outweigh the gain. */
+constexpr int G_RENDER_POOL_MIN_CHANNELS = 4;
+
+/* G_RENDER_POOL_SPIN_LIMIT
+How many times the audio thread polls the RenderPool for jobs still running on
+worker threads before sleeping for a moment, so that a preempted worker sharing
+the same core, with a lower priority, can complete its job. */
+constexpr int G_RENDER_POOL_SPIN_LIMIT = 1024;
+
+/* G_RENDER_POOL_SPIN_TIME_US
+How long RenderPool workers keep polling for the next batch of jobs before going
+to sleep. Just enough to catch a batch dispatched right after the previous one:
+spinning longer would burn CPU time that other threads could use. */
+constexpr int G_RENDER_POOL_SPIN_TIME_US = 5;
+
+/* G_RENDER_POOL_AUTO_WORKERS
+Maximum number of RenderPool workers spawned in auto mode (see
+G_DEFAULT_RENDER_THREADS). More workers must be requested explicitly. */
+constexpr int G_RENDER_POOL_AUTO_WORKERS = 2;
+
+/* G_REALTIME_PRIORITY
+The maximum priority level when instructing RtAudio to work in real-time mode
+(with RTAUDIO_SCHEDULE_REALTIME flag). This is actually the maximum value allowed
+on Unix, however RtAudio has some magic hardcoded values when it comes to Windows
+implementation, so it's safe to pass it as is. RenderPool workers run just below
+the audio thread. */
+constexpr int G_REALTIME_PRIORITY = 99;
+
+/* G_PLUGIN_TAIL_SECONDS, G_PLUGIN_TAIL_SILENCE
+An idle channel with plug-ins keeps being rendered until its output stays below
+G_PLUGIN_TAIL_SILENCE for G_PLUGIN_TAIL_SECONDS in a row, so that reverbs,
+delays and the like can ring out before the channel is skipped. */
+constexpr float G_PLUGIN_TAIL_SECONDS = 2.0f;
+constexpr float G_PLUGIN_TAIL_SILENCE = 0.0001f; // -80 dB
+
+/* G_CPU_METER_WINDOW
+Aggregation window in milliseconds for per-channel and per-plugin CPU meters.
+Long enough to smooth out block-to-block jitter in the UI. */
+constexpr int G_CPU_METER_WINDOW = 500;
+
+/* G_STREAMING_*
+Disk streaming of long samples. The first G_STREAMING_RESIDENT_MS of audio,
+plus the same amount after the loop start point, are always kept in memory; the
+rest is read ahead of the playhead into a ring buffer G_STREAMING_RING_MS long,
+G_STREAMING_CHUNK_FRAMES at a time, by a background thread waking up every
+G_STREAMING_RATE_MS. */
+constexpr int G_STREAMING_RESIDENT_MS  = 1000;
+constexpr int G_STREAMING_RING_MS      = 2000;
+constexpr int G_STREAMING_CHUNK_FRAMES = 8192;
+constexpr int G_STREAMING_RATE_MS      = 5;
+
+/* G_COMPACT_SCRATCH_FRAMES
+Compact Waves (see CompactBuffer) are decoded for the resampler in chunks of
+G_COMPACT_SCRATCH_FRAMES frames at most, on the stack of the audio thread. */
+constexpr int G_COMPACT_SCRATCH_FRAMES = 1024;
+
+/* G_RESAMPLE_CACHE_MAX_MB
+Maximum size of the on-disk cache of resampled samples (see resampleCache), in
+megabytes. Oldest entries are removed first. */
+constexpr int G_RESAMPLE_CACHE_MAX_MB = 2048;
+
+/* G_LOAD_CHUNK_*
+Long samples are decoded and resampled on load in chunks of about
+G_LOAD_CHUNK_FRAMES frames, processed in parallel. Resampled chunks overlap
+by G_LOAD_CHUNK_PADDING input frames on each side, so that the converter sees
+real audio around chunk boundaries. */
+constexpr int G_LOAD_CHUNK_FRAMES  = 262144;
+constexpr int G_LOAD_CHUNK_PADDING = 4096;
+
+/* G_LOAD_PROGRESS_RATE_MS
+How often project loading reports its progress while waiting for samples to be
+decoded in the background. */
+constexpr int G_LOAD_PROGRESS_RATE_MS = 50;
+
+/* G_LAZY_LOAD_FADE_IN_FRAMES
+Length of the fade-in applied to a channel triggered while its sample was still
+being loaded in the background, when it joins a running loop halfway through. */
+constexpr int G_LAZY_LOAD_FADE_IN_FRAMES = 2048;
+
 /* -- GUI ------------------------------------------------------------------- */
 constexpr int   G_GUI_FPS            = 30;
 constexpr float G_GUI_REFRESH_RATE   = 1 / static_cast<float>(G_GUI_FPS);
@@ -110,6 +197,8 @@ constexpr int   G_MAX_VELOCITY          = 0x7F;
 constexpr int   G_MAX_MIDI_CHANS        = 16;
 constexpr int   G_MAX_DISPATCHER_EVENTS = 32;
 constexpr int   G_MAX_SEQUENCER_EVENTS  = 128;  // Per block
+constexpr int   G_MAX_QUANTIZER_SLOTS   = 4;
+constexpr int   G_MAX_RENDER_THREADS    = 16;
 constexpr float G_MIN_UI_SCALING        = 0.0f; // Auto: FLTK will figure it out
 constexpr float G_MAX_UI_SCALING        = 4.0f;
 
@@ -140,6 +229,9 @@ constexpr int          G_DEFAULT_SUBWINDOW_W         = 640;
 constexpr int          G_DEFAULT_SUBWINDOW_H         = 480;
 constexpr int          G_DEFAULT_VST_MIDIBUFFER_SIZE = 1024; // TODO - not 100% sure about this size
 constexpr float        G_DEFAULT_UI_SCALING          = G_MIN_UI_SCALING;
+constexpr int          G_DEFAULT_RENDER_THREADS      = -1; // auto
+constexpr int          G_DEFAULT_STREAMING_THRESHOLD = 300; // seconds, 0 = disabled
+constexpr int          G_DEFAULT_SAMPLE_BUDGET       = 0; // megabytes, 0 = unlimited
 
 /* -- responses and return codes -------------------------------------------- */
 constexpr int G_RES_ERR_PROCESSING    = -6;
@@ -243,6 +335,7 @@ constexpr auto PATCH_KEY_MASTER_VOL_IN                = "master_vol_in";
 constexpr auto PATCH_KEY_MASTER_VOL_OUT               = "master_vol_out";
 constexpr auto PATCH_KEY_METRONOME                    = "metronome";
 constexpr auto PATCH_KEY_SAMPLERATE                   = "samplerate";
+constexpr auto PATCH_KEY_COMPACT_SAMPLES              = "compact_samples";
 constexpr auto PATCH_KEY_COLUMNS                      = "columns";
 constexpr auto PATCH_KEY_PLUGINS                      = "plugins";
 constexpr auto PATCH_KEY_MASTER_OUT_PLUGINS           = "master_out_plugins";
@@ -332,6 +425,10 @@ constexpr auto CONF_KEY_BUFFER_SIZE                   = "buffer_size";
 constexpr auto CONF_KEY_DELAY_COMPENSATION            = "delay_compensation";
 constexpr auto CONF_KEY_LIMIT_OUTPUT                  = "limit_output";
 constexpr auto CONF_KEY_RESAMPLE_QUALITY              = "resample_quality";
+constexpr auto CONF_KEY_RENDER_THREADS                = "render_threads";
+constexpr auto CONF_KEY_STREAMING_THRESHOLD           = "streaming_threshold";
+constexpr auto CONF_KEY_SAMPLE_MEMORY_BUDGET          = "sample_memory_budget";
+constexpr auto CONF_KEY_LAZY_WAVE_LOADING             = "lazy_wave_loading";
 constexpr auto CONF_KEY_MIDI_SYSTEM                   = "midi_system";
 constexpr auto CONF_KEY_MIDI_PORT_OUT                 = "midi_port_out";
 constexpr auto CONF_KEY_MIDI_PORT_IN                  = "midi_port_in";
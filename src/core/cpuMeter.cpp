@@ -0,0 +1,88 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2023 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#include "core/cpuMeter.h"
+#include "core/const.h"
+
+namespace giada::m
+{
+namespace
+{
+constexpr auto RELAXED = std::memory_order_relaxed;
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+CpuMeter::CpuMeter()
+: m_time(0)
+, m_blocks(0)
+, m_peak(0)
+, m_lastTime(0)
+, m_lastBlocks(0)
+, m_lastCollect(Clock::now())
+{
+}
+
+/* -------------------------------------------------------------------------- */
+
+void CpuMeter::record(Clock::duration d)
+{
+	const std::uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+
+	/* Single writer: plain load/store pairs are enough and avoid locked
+	instructions on the audio thread. The peak might get lost if a collect()
+	happens in between, which is harmless. */
+
+	m_time.store(m_time.load(RELAXED) + ns, RELAXED);
+	m_blocks.store(m_blocks.load(RELAXED) + 1, RELAXED);
+	if (ns > m_peak.load(RELAXED))
+		m_peak.store(ns, RELAXED);
+}
+
+/* -------------------------------------------------------------------------- */
+
+CpuMeter::Stats CpuMeter::collect()
+{
+	const Clock::time_point now = Clock::now();
+
+	if (now - m_lastCollect < std::chrono::milliseconds(G_CPU_METER_WINDOW))
+		return m_stats;
+
+	const std::uint64_t blocks = m_blocks.load(RELAXED);
+	const std::uint64_t time   = m_time.load(RELAXED);
+
+	m_stats.avg  = blocks > m_lastBlocks ? (time - m_lastTime) / 1000.0f / (blocks - m_lastBlocks) : 0.0f;
+	m_stats.peak = m_peak.exchange(0, RELAXED) / 1000.0f;
+
+	m_lastTime    = time;
+	m_lastBlocks  = blocks;
+	m_lastCollect = now;
+
+	return m_stats;
+}
+} // namespace giada::m
@@ -0,0 +1,83 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2023 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#ifndef G_CPU_METER_H
+#define G_CPU_METER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace giada::m
+{
+/* CpuMeter
+Lock-free accounting of the time spent by a single processing unit (a channel,
+a plug-in) on each audio block. The rendering thread records timings into
+plain counters; a non-realtime thread periodically collects them into average
+and peak values over the last aggregation window. */
+
+class CpuMeter final
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	struct Stats
+	{
+		float avg  = 0.0f; // Microseconds per block
+		float peak = 0.0f; // Microseconds per block
+	};
+
+	CpuMeter();
+
+	/* record
+	Records the time spent on a block. Rendering thread only. */
+
+	void record(Clock::duration);
+
+	/* collect
+	Returns average and peak time per block over the last aggregation window,
+	re-aggregating the counters if the window has expired. Non-realtime thread
+	only. */
+
+	Stats collect();
+
+private:
+	/* Written by the rendering thread. */
+
+	std::atomic<std::uint64_t> m_time;   // Cumulative, nanoseconds
+	std::atomic<std::uint64_t> m_blocks; // Cumulative
+	std::atomic<std::uint64_t> m_peak;   // Nanoseconds, reset on each collect
+
+	/* Touched by the collecting thread only. */
+
+	std::uint64_t     m_lastTime;
+	std::uint64_t     m_lastBlocks;
+	Clock::time_point m_lastCollect;
+	Stats             m_stats;
+};
+} // namespace giada::m
+
+#endif
@@ -25,12 +25,15 @@
  * -------------------------------------------------------------------------- */
 
 #include "core/engine.h"
+#include "core/audioKernels.h"
 #include "core/conf.h"
 #include "core/confFactory.h"
 #include "core/model/model.h"
 #include "utils/fs.h"
 #include "utils/log.h"
 #include "utils/string.h"
+#include <cassert>
+#include <chrono>
 #include <fmt/core.h>
 #include <memory>
 
@@ -51,18 +54,21 @@ Engine::Engine()
 , m_actionRecorder(m_model)
 , m_recorder(m_sequencer, m_channelManager, m_mixer, m_actionRecorder)
 , m_midiDispatcher(m_model)
-, m_mainApi(m_kernelAudio, m_mixer, m_sequencer, m_midiSynchronizer, m_channelManager, m_recorder)
-, m_channelsApi(m_model, m_kernelAudio, m_mixer, m_sequencer, m_channelManager, m_recorder, m_actionRecorder, m_pluginHost, m_pluginManager)
+, m_mainApi(m_kernelAudio, m_mixer, m_sequencer, m_midiSynchronizer, m_channelManager, m_recorder, m_loadMonitor)
+, m_channelsApi(m_model, m_kernelAudio, m_mixer, m_sequencer, m_channelManager, m_recorder, m_actionRecorder, m_pluginHost, m_pluginManager, m_waveLoader)
 , m_pluginsApi(m_kernelAudio, m_pluginManager, m_pluginHost, m_model)
 , m_sampleEditorApi(m_kernelAudio, m_model, m_channelManager)
 , m_actionEditorApi(*this, m_sequencer, m_actionRecorder)
 , m_ioApi(m_model, m_midiDispatcher)
-, m_storageApi(*this, m_model, m_pluginManager, m_midiSynchronizer, m_mixer, m_channelManager, m_kernelAudio, m_sequencer, m_actionRecorder)
+, m_storageApi(*this, m_model, m_pluginManager, m_midiSynchronizer, m_mixer, m_channelManager, m_kernelAudio, m_sequencer, m_actionRecorder, m_waveLoader)
 , m_configApi(m_model, m_kernelAudio, m_kernelMidi, m_midiMapper, m_midiSynchronizer)
 {
 	m_kernelAudio.onAudioCallback = [this](mcl::AudioBuffer& out, const mcl::AudioBuffer& in) {
 		return audioCallback(out, in);
 	};
+	m_kernelAudio.onXrun = [this](bool inputOverflow, bool outputUnderflow) {
+		m_loadMonitor.recordXrun(inputOverflow, outputUnderflow);
+	};
 	m_kernelAudio.onStreamAboutToOpen = [this]() {
 		m_mixer.disable();
 	};
@@ -210,12 +216,15 @@ void Engine::init(const Conf& conf)
 
 	m_kernelAudio.init();
 
+	u::log::print("[Engine::init] Audio kernels: {}\n", u::string::toString(kernels::getInstructionSet()));
+
 	m_mixer.reset(m_sequencer.getMaxFramesInLoop(m_kernelAudio.getSampleRate()), m_kernelAudio.getBufferSize());
 	m_channelManager.reset(m_kernelAudio.getBufferSize());
 	m_sequencer.reset(m_kernelAudio.getSampleRate());
 	m_pluginHost.reset(m_kernelAudio.getBufferSize());
 	m_pluginManager.reset(conf.pluginSortMethod);
 
+	m_mixer.startRenderPool(layout.kernelAudio.renderThreads);
 	m_mixer.enable();
 	m_kernelAudio.startStream();
 
@@ -234,6 +243,10 @@ void Engine::init(const Conf& conf)
 
 void Engine::reset(PluginManager::SortMethod pluginSortMethod)
 {
+	/* Samples still loading in background belong to the old project. */
+
+	m_waveLoader.stop();
+
 	/* Managers first, due to the internal ID numbering. */
 
 	channelFactory::reset();
@@ -262,7 +275,9 @@ void Engine::shutdown(Conf& conf)
 		m_kernelAudio.shutdown();
 		u::log::print("[Engine::shutdown] KernelAudio closed\n");
 		m_mixer.disable();
+		m_mixer.stopRenderPool();
 		u::log::print("[Engine::shutdown] Mixer closed\n");
+		m_loadMonitor.dump();
 	}
 
 	m_model.store(conf);
@@ -281,6 +296,8 @@ int Engine::audioCallback(mcl::AudioBuffer& out, const mcl::AudioBuffer& in) con
 {
 	registerThread(Thread::AUDIO, /*realtime=*/true);
 
+	const auto startTime = std::chrono::steady_clock::now();
+
 	/* Clean up output buffer before any rendering. Do this even if mixer is
 	disabled to avoid audio leftovers during a temporary suspension (e.g. when
 	loading a new patch). */
@@ -294,14 +311,10 @@ int Engine::audioCallback(mcl::AudioBuffer& out, const mcl::AudioBuffer& in) con
 	const model::LayoutLock   layoutLock  = m_model.get_RT();
 	const model::Layout&      layout_RT   = layoutLock.get();
 	const model::KernelAudio& kernelAudio = layout_RT.kernelAudio;
-	const model::Mixer&       mixer       = layout_RT.mixer;
-	const model::Sequencer&   sequencer   = layout_RT.sequencer;
-	const model::Channels&    channels    = layout_RT.channels;
-	const model::Actions&     actions     = layout_RT.actions;
 
 	/* Mixer disabled or Kernel Audio not ready: nothing to do here. */
 
-	if (!mixer.a_isActive())
+	if (!layout_RT.mixer.a_isActive())
 		return 0;
 
 #ifdef WITH_AUDIO_JACK
@@ -309,6 +322,41 @@ int Engine::audioCallback(mcl::AudioBuffer& out, const mcl::AudioBuffer& in) con
 		m_jackSynchronizer.recvJackSync(m_jackTransport.getState());
 #endif
 
+	render(out, in, m_model.getLayoutToRender_RT(layout_RT, out.countFrames()));
+
+	/* Measure the DSP load, i.e. the time spent here vs. the block period. */
+
+	const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+	m_loadMonitor.record(elapsed.count(), out.countFrames() / static_cast<double>(kernelAudio.samplerate));
+
+	return 0;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Engine::renderOffline(mcl::AudioBuffer& out, const mcl::AudioBuffer& in) const
+{
+	/* No realtime thread is running: the Layout can be read directly, as no one
+	else is going to swap it in the meantime. There must be no preloaded Layout
+	around, which Model::getLayoutToRender_RT() would pick instead (see
+	StorageApi::renderProject). */
+
+	assert(m_model.getPreloaded_RT() == nullptr);
+
+	out.clear();
+	render(out, in, m_model.get());
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Engine::render(mcl::AudioBuffer& out, const mcl::AudioBuffer& in, const model::Layout& layout_RT) const
+{
+	const model::KernelAudio& kernelAudio = layout_RT.kernelAudio;
+	const model::Mixer&       mixer       = layout_RT.mixer;
+	const model::Sequencer&   sequencer   = layout_RT.sequencer;
+	const model::Channels&    channels    = layout_RT.channels;
+	const model::Actions&     actions     = layout_RT.actions;
+
 	/* If the m_sequencer is running, advance it first (i.e. parse it for events).
 	Also advance channels (i.e. let them react to m_sequencer events), only if the
 	layout is not locked: another thread might altering channel's data in the
@@ -331,8 +379,6 @@ int Engine::audioCallback(mcl::AudioBuffer& out, const mcl::AudioBuffer& in) con
 
 	const int maxFramesToRec = mixer.inputRecMode == InputRecMode::FREE ? sequencer.getMaxFramesInLoop(kernelAudio.samplerate) : sequencer.framesInLoop;
 	m_mixer.render(out, in, layout_RT, maxFramesToRec);
-
-	return 0;
 }
 
 /* -------------------------------------------------------------------------- */
@@ -353,6 +399,7 @@ void Engine::resume()
 void Engine::debug()
 {
 	m_model.debug();
+	m_loadMonitor.dump();
 }
 #endif
 
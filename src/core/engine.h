@@ -43,6 +43,7 @@
 #include "core/jackTransport.h"
 #include "core/kernelAudio.h"
 #include "core/kernelMidi.h"
+#include "core/loadMonitor.h"
 #include "core/midiDispatcher.h"
 #include "core/midiMapper.h"
 #include "core/midiSynchronizer.h"
@@ -53,6 +54,7 @@
 #include "core/recorder.h"
 #include "core/sequencer.h"
 #include "core/waveFactory.h"
+#include "core/waveLoader.h"
 #ifdef WITH_AUDIO_JACK
 #include "core/jackSynchronizer.h"
 #endif
@@ -94,6 +96,14 @@ public:
 	void suspend();
 	void resume();
 
+	/* renderOffline
+	Renders a block of audio on the calling thread, bypassing KernelAudio. Used
+	to render the project faster than realtime: the audio stream must be stopped
+	in the meantime, so that no other thread renders concurrently. Any preloaded
+	project must be committed or discarded first. */
+
+	void renderOffline(mcl::AudioBuffer& out, const mcl::AudioBuffer& in) const;
+
 #ifdef G_DEBUG_MODE
 	void debug();
 #endif
@@ -129,6 +139,8 @@ public:
 
 private:
 	int  audioCallback(mcl::AudioBuffer& out, const mcl::AudioBuffer& in) const;
+	void render(mcl::AudioBuffer& out, const mcl::AudioBuffer& in, const model::Layout&) const;
+
 	void registerThread(Thread, bool isRealtime) const;
 
 	model::Model           m_model;
@@ -146,6 +158,8 @@ private:
 	PluginManager          m_pluginManager;
 	EventDispatcher        m_eventDispatcher;
 	MidiDispatcher         m_midiDispatcher;
+	WaveLoader             m_waveLoader;
+	mutable LoadMonitor    m_loadMonitor;
 #ifdef WITH_AUDIO_JACK
 	JackSynchronizer m_jackSynchronizer;
 #endif
@@ -29,28 +29,44 @@
 #endif
 #include "core/confFactory.h"
 #include "core/engine.h"
+#include "core/init.h"
 #include "gui/elems/mainWindow/mainIO.h"
 #include "gui/ui.h"
 #include "gui/updater.h"
 #include "utils/log.h"
+#include "utils/string.h"
 #include "utils/ver.h"
 #ifdef WITH_TESTS
 #define CATCH_CONFIG_RUNNER
 #include "tests/actionRecorder.cpp"
+#include "tests/actions.cpp"
+#include "tests/audioKernels.cpp"
 #include "tests/channelFactory.cpp"
+#include "tests/loadMonitor.cpp"
 #include "tests/midiEvent.cpp"
 #include "tests/midiLighter.cpp"
+#include "tests/model.cpp"
+#include "tests/renderPool.cpp"
+#include "tests/resampleCache.cpp"
+#include "tests/resampler.cpp"
 #include "tests/samplePlayer.cpp"
 #include "tests/utils.cpp"
 #include "tests/wave.cpp"
 #include "tests/waveFactory.cpp"
 #include "tests/waveFx.cpp"
+#include "tests/waveLoader.cpp"
 #include "tests/waveReader.cpp"
+#include "tests/waveStream.cpp"
 #include <catch2/catch.hpp>
 #include <string>
 #include <vector>
 #endif
 #include <FL/Fl.H>
+#include <algorithm>
+#include <atomic>
+#include <csignal>
+#include <cstdlib>
+#include <string>
 
 extern giada::m::Engine g_engine;
 extern giada::v::Ui     g_ui;
@@ -59,6 +75,169 @@ namespace giada::m::init
 {
 namespace
 {
+/* Options_
+Command line options. See init::startup() for the documentation. */
+
+struct Options_
+{
+	bool        headless  = false;
+	bool        play      = false;
+	bool        nullAudio = false;
+	std::string projectPath;
+	std::string renderPath;
+	std::string audioOutFile;
+	std::string audioInFile;
+	int         loops = 1;
+};
+
+Options_          options_;
+std::atomic<bool> quitRequested_(false);
+
+/* -------------------------------------------------------------------------- */
+
+Options_ parseOptions_(int argc, char** argv)
+{
+	Options_ options;
+
+	for (int i = 1; i < argc; i++)
+	{
+		const std::string arg     = argv[i];
+		const bool        hasNext = i + 1 < argc;
+
+		if (arg == "--headless")
+			options.headless = true;
+		else if (arg == "--play")
+			options.play = true;
+		else if (arg == "--project" && hasNext)
+			options.projectPath = argv[++i];
+		else if (arg == "--render" && hasNext)
+			options.renderPath = argv[++i];
+		else if (arg == "--loops" && hasNext)
+			options.loops = std::max(1, u::string::toInt(argv[++i]));
+		else if (arg == "--null-audio")
+			options.nullAudio = true;
+		else if (arg == "--audio-out-file" && hasNext)
+			options.audioOutFile = argv[++i];
+		else if (arg == "--audio-in-file" && hasNext)
+			options.audioInFile = argv[++i];
+	}
+
+	return options;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* overridesAudio_
+Tells whether the command line options replace the configured audio system. */
+
+bool overridesAudio_(const Options_& options)
+{
+	return options.nullAudio || !options.audioOutFile.empty() || !options.audioInFile.empty();
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* applyOptions_
+Overrides the audio configuration with the command line options, if any. The
+null audio backend kicks in when the dummy API is selected. File output and
+input imply it. */
+
+void applyOptions_(const Options_& options, Conf& conf)
+{
+	if (overridesAudio_(options))
+		conf.soundSystem = RtAudio::Api::RTAUDIO_DUMMY;
+
+	conf.nullAudioOutFile = options.audioOutFile;
+	conf.nullAudioInFile  = options.audioInFile;
+
+	if (!options.audioInFile.empty() && conf.soundDeviceIn == -1)
+		conf.soundDeviceIn = 0;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void onQuitSignal_(int)
+{
+	quitRequested_.store(true);
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool loadProject_(const std::string& projectPath, PluginManager::SortMethod pluginSortMethod)
+{
+	const model::LoadState state = g_engine.getStorageApi().loadProject(projectPath, pluginSortMethod, [](float) {});
+
+	if (state.patch.status != G_FILE_OK)
+	{
+		u::log::print("[init::loadProject_] Can't load project {}!\n", projectPath);
+		return false;
+	}
+
+	for (const std::string& w : state.missingWaves)
+		u::log::print("[init::loadProject_] Missing sample: {}\n", w);
+	for (const std::string& p : state.missingPlugins)
+		u::log::print("[init::loadProject_] Missing plug-in: {}\n", p);
+
+	return true;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* publishLoadedWaves_
+Brings online the samples loaded in background so far, if any. */
+
+void publishLoadedWaves_()
+{
+	for (const std::string& w : g_engine.getStorageApi().publishLoadedWaves())
+		u::log::print("[init::publishLoadedWaves_] Missing sample: {}\n", w);
+}
+
+/* -------------------------------------------------------------------------- */
+
+int runHeadless_()
+{
+	if (!options_.projectPath.empty() && !loadProject_(options_.projectPath, g_ui.model.pluginChooserSortMethod))
+	{
+		shutdown();
+		return EXIT_FAILURE;
+	}
+
+	/* Batch rendering: bounce the project and quit. Samples loaded in background
+	must all be in place first. */
+
+	if (!options_.renderPath.empty())
+	{
+		g_engine.getStorageApi().waitForWaves();
+		publishLoadedWaves_();
+
+		const bool success = g_engine.getStorageApi().renderProject(options_.renderPath, options_.loops, [](float) {});
+		shutdown();
+		return success ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
+	if (options_.play)
+		g_engine.getMainApi().startSequencer();
+
+	/* Keep running until SIGINT or SIGTERM. In the meantime, dispatch JUCE 
+	messages, needed by some plug-ins to work properly. */
+
+	std::signal(SIGINT, onQuitSignal_);
+	std::signal(SIGTERM, onQuitSignal_);
+
+	u::log::print("[init::runHeadless_] Running headless, send SIGINT or SIGTERM to quit\n");
+
+	while (!quitRequested_.load())
+	{
+		juce::MessageManager::getInstance()->runDispatchLoopUntil(G_HEADLESS_LOOP_RATE_MS);
+		publishLoadedWaves_();
+	}
+
+	shutdown();
+	return EXIT_SUCCESS;
+}
+
+/* -------------------------------------------------------------------------- */
+
 void printBuildInfo_()
 {
 	u::log::print("[init] Giada {}\n", G_VERSION_STR);
@@ -106,26 +285,39 @@ int tests(int argc, char** argv)
 
 void startup(int argc, char** argv)
 {
+	options_ = parseOptions_(argc, argv);
+
 	g_ui.dispatcher.onEventOccured = []() {
 		g_engine.getMainApi().startActionRecOnCallback();
 	};
 
-	g_engine.onMidiReceived = []() {
-		g_ui.pumpEvent([] { g_ui.mainWindow->mainIO->setMidiInActivity(); });
-	};
+	if (options_.headless)
+	{
+		/* No UI to notify in headless mode: Engine callbacks are no-ops. */
 
-	g_engine.onMidiSent = []() {
-		g_ui.pumpEvent([] { g_ui.mainWindow->mainIO->setMidiOutActivity(); });
-	};
+		g_engine.onMidiReceived = []() {};
+		g_engine.onMidiSent     = []() {};
+		g_engine.onModelSwap    = [](model::SwapType) {};
+	}
+	else
+	{
+		g_engine.onMidiReceived = []() {
+			g_ui.pumpEvent([] { g_ui.mainWindow->mainIO->setMidiInActivity(); });
+		};
 
-	g_engine.onModelSwap = [](model::SwapType type) {
-		/* Rebuild or refresh the UI accoring to the swap type. Note: the onSwap
-		callback might be performed by a non-main thread, which must talk to the 
-		UI (main thread) through the UI queue by pumping an event in it. */
-		if (type == model::SwapType::NONE)
-			return;
-		g_ui.pumpEvent([type]() { type == model::SwapType::HARD ? g_ui.rebuild() : g_ui.refresh(); });
-	};
+		g_engine.onMidiSent = []() {
+			g_ui.pumpEvent([] { g_ui.mainWindow->mainIO->setMidiOutActivity(); });
+		};
+
+		g_engine.onModelSwap = [](model::SwapType type) {
+			/* Rebuild or refresh the UI accoring to the swap type. Note: the onSwap
+			callback might be performed by a non-main thread, which must talk to the 
+			UI (main thread) through the UI queue by pumping an event in it. */
+			if (type == model::SwapType::NONE)
+				return;
+			g_ui.pumpEvent([type]() { type == model::SwapType::HARD ? g_ui.rebuild() : g_ui.refresh(); });
+		};
+	}
 
 	Conf conf = confFactory::deserialize();
 
@@ -135,18 +327,27 @@ void startup(int argc, char** argv)
 	if (!u::log::init(conf.logMode))
 		u::log::print("[init::startup] log init failed! Using default stdout\n");
 
+	applyOptions_(options_, conf);
+
 	juce::initialiseJuce_GUI();
 	g_engine.init(conf);
-	g_ui.init(argc, argv, conf, G_DEFAULT_PATCH_NAME, g_engine.isAudioReady());
+	if (options_.headless)
+		g_ui.initHeadless(conf);
+	else
+		g_ui.init(argc, argv, conf, G_DEFAULT_PATCH_NAME, g_engine.isAudioReady());
 
 	printBuildInfo_();
 }
 
 /* -------------------------------------------------------------------------- */
 
-void run()
+int run()
 {
+	if (options_.headless)
+		return runHeadless_();
+
 	g_ui.run();
+	return EXIT_SUCCESS;
 }
 
 /* -------------------------------------------------------------------------- */
@@ -159,7 +360,22 @@ void shutdown()
 	g_engine.shutdown(conf);
 	juce::shutdownJuce_GUI();
 
-	if (!confFactory::serialize(conf))
+	/* Audio settings overridden from the command line are temporary: put back
+	the ones from the configuration file. */
+
+	if (overridesAudio_(options_))
+	{
+		const Conf original = confFactory::deserialize();
+		conf.soundSystem    = original.soundSystem;
+		conf.soundDeviceIn  = original.soundDeviceIn;
+	}
+
+	/* Headless mode doesn't own the UI settings: don't overwrite them with
+	default values. */
+
+	if (options_.headless)
+		u::log::print("[init::shutdown] headless mode, configuration not saved\n");
+	else if (!confFactory::serialize(conf))
 		u::log::print("[init::shutdown] error while saving configuration file!\n");
 	else
 		u::log::print("[init::shutdown] configuration saved\n");
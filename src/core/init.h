@@ -35,8 +35,28 @@ Performs tests, if requested. Returns -1 if no tests are available or the
 
 int tests(int argc, char** argv);
 
+/* startup
+Initializes Engine and UI. Pass '--headless' to run the Engine alone without
+any window, for server and batch use. Headless options:
+	--project <path>  loads the project at startup;
+	--play            starts the sequencer right away;
+	--render <path>   renders the project to a WAV file and quits;
+	--loops <n>       number of loops to render (default 1).
+Audio options, available in any mode:
+	--null-audio             drives the Engine with a clock thread instead of
+	                         an audio device;
+	--audio-out-file <path>  writes the audio output to a WAV file (implies
+	                         --null-audio);
+	--audio-in-file <path>   reads the audio input from a file, looping it
+	                         (implies --null-audio). */
+
 void startup(int argc, char** argv);
-void run();
+
+/* run
+Runs the main loop until Giada is closed. Returns the process exit code. */
+
+int run();
+
 void shutdown();
 } // namespace giada::m::init
 
@@ -39,23 +39,13 @@
 
 namespace giada::m
 {
-namespace
-{
-/* RTAUDIO_MAX_PRIORITY
-The maximum priority level when instructing RtAudio to work in real-time mode
-(with RTAUDIO_SCHEDULE_REALTIME flag). This is actually the maximum value allowed
-on Unix, however RtAudio has some magic hardcoded values when it comes to Windows
-implementation, so we can safely pass this value below in the options struct.*/
-
-constexpr int RTAUDIO_MAX_PRIORITY = 99;
-} // namespace
-
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
 
 KernelAudio::KernelAudio(model::Model& model)
 : onAudioCallback(nullptr)
+, onXrun(nullptr)
 , onStreamAboutToOpen(nullptr)
 , onStreamOpened(nullptr)
 , m_model(model)
@@ -126,6 +116,12 @@ bool KernelAudio::openStream(
 
 bool KernelAudio::startStream()
 {
+	if (m_nullAudio.isOpen())
+	{
+		m_nullAudio.start();
+		u::log::print("[KA] Start null stream\n");
+		return true;
+	}
 	if (m_rtAudio->startStream() == RtAudioErrorType::RTAUDIO_NO_ERROR)
 	{
 		u::log::print("[KA] Start stream - latency = {}\n", m_rtAudio->getStreamLatency());
@@ -138,6 +134,12 @@ bool KernelAudio::startStream()
 
 bool KernelAudio::stopStream()
 {
+	if (m_nullAudio.isOpen())
+	{
+		m_nullAudio.stop();
+		u::log::print("[KA] Stop null stream\n");
+		return true;
+	}
 	if (m_rtAudio->stopStream() == RtAudioErrorType::RTAUDIO_NO_ERROR)
 	{
 		u::log::print("[KA] Stop stream\n");
@@ -150,6 +152,7 @@ bool KernelAudio::stopStream()
 
 void KernelAudio::shutdown()
 {
+	m_nullAudio.close();
 	if (m_rtAudio->isStreamRunning())
 		m_rtAudio->stopStream();
 	if (m_rtAudio->isStreamOpen())
@@ -161,6 +164,8 @@ void KernelAudio::shutdown()
 
 bool KernelAudio::isReady() const
 {
+	if (m_nullAudio.isOpen())
+		return m_nullAudio.isRunning();
 	return m_rtAudio != nullptr && m_rtAudio->isStreamOpen() && m_rtAudio->isStreamRunning();
 }
 
@@ -332,18 +337,21 @@ KernelAudio::OpenStreamResult KernelAudio::openStream_(
 
 	const RtAudio::Api api = m_model.get().kernelAudio.api;
 
-	/* Abort here if devices found are zero, both devices are disabled or 
-	current API is dummy. */
-
-	if (m_rtAudio->getDeviceCount() == 0 || (in.index == -1 && out.index == -1) || api == RtAudio::Api::RTAUDIO_DUMMY)
-		return {};
-
-	/* Close stream before opening another one. Closing a stream frees any
+	/* Close streams before opening another one. Closing a stream frees any
 	associated stream memory. */
 
+	m_nullAudio.close();
 	if (m_rtAudio->isStreamOpen())
 		m_rtAudio->closeStream();
 
+	/* Fall back to the built-in null backend if devices found are zero or
+	current API is dummy. Abort here if both devices are disabled. */
+
+	if (m_rtAudio->getDeviceCount() == 0 || api == RtAudio::Api::RTAUDIO_DUMMY)
+		return openNullStream_(out, in, sampleRate, bufferSize);
+	if (in.index == -1 && out.index == -1)
+		return {};
+
 	RtAudio::StreamParameters outParams;
 	RtAudio::StreamParameters inParams;
 
@@ -364,7 +372,7 @@ KernelAudio::OpenStreamResult KernelAudio::openStream_(
 
 	RtAudio::StreamOptions options;
 	options.flags           = RTAUDIO_SCHEDULE_REALTIME;
-	options.priority        = RTAUDIO_MAX_PRIORITY;
+	options.priority        = G_REALTIME_PRIORITY;
 	options.streamName      = G_APP_NAME;
 	options.numberOfBuffers = 4; // TODO - wtf?
 
@@ -416,11 +424,42 @@ KernelAudio::OpenStreamResult KernelAudio::openStream_(
 
 /* -------------------------------------------------------------------------- */
 
+KernelAudio::OpenStreamResult KernelAudio::openNullStream_(
+    const model::KernelAudio::Device& out,
+    const model::KernelAudio::Device& in,
+    unsigned int                      sampleRate,
+    unsigned int                      bufferSize)
+{
+	const model::KernelAudio& kernelAudio = m_model.get().kernelAudio;
+
+	/* There is no real device to query here: always provide an output and
+	enable the input only if requested. */
+
+	const int channelsOut = out.channelsCount > 0 ? out.channelsCount : G_MAX_IO_CHANS;
+	const int channelsIn  = in.index != -1 ? in.channelsCount : 0;
+
+	m_nullAudio.onAudioCallback = onAudioCallback;
+	m_nullAudio.onXrun          = onXrun;
+
+	if (!m_nullAudio.open(sampleRate, bufferSize, channelsOut, channelsIn,
+	        kernelAudio.nullAudioOutFile, kernelAudio.nullAudioInFile))
+		return {};
+
+	u::log::print("[KA] Null device opened successfully\n");
+
+	return {true, sampleRate, bufferSize};
+}
+
+/* -------------------------------------------------------------------------- */
+
 int KernelAudio::audioCallback(void* outBuf, void* inBuf, unsigned bufferSize,
-    double /*streamTime*/, RtAudioStreamStatus /*status*/, void*   data)
+    double /*streamTime*/, RtAudioStreamStatus status, void*   data)
 {
 	const CallbackInfo& info = *static_cast<CallbackInfo*>(data);
 
+	if (status != 0 && info.kernelAudio->onXrun != nullptr)
+		info.kernelAudio->onXrun(status & RTAUDIO_INPUT_OVERFLOW, status & RTAUDIO_OUTPUT_UNDERFLOW);
+
 	mcl::AudioBuffer out(static_cast<float*>(outBuf), bufferSize, info.channelsOutCount);
 	mcl::AudioBuffer in;
 	if (info.channelsInCount > 0)
@@ -28,6 +28,7 @@
 #define G_KERNELAUDIO_H
 
 #include "core/model/model.h"
+#include "core/nullAudioBackend.h"
 #include "core/weakAtomic.h"
 #include "deps/rtaudio/RtAudio.h"
 #include <cstddef>
@@ -132,6 +133,12 @@ public:
 
 	std::function<int(mcl::AudioBuffer& out, const mcl::AudioBuffer& in)> onAudioCallback;
 
+	/* onXrun
+	Callback fired by the audio thread when the audio driver reports an input
+	overflow or an output underflow. */
+
+	std::function<void(bool inputOverflow, bool outputUnderflow)> onXrun;
+
 	/* onStreamAboutToOpen
 	Callback fired before opening a new stream. */
 
@@ -167,6 +174,16 @@ private:
 
 	static int audioCallback(void*, void*, unsigned, double, RtAudioStreamStatus, void*);
 
+	/* openNullStream_
+	Opens the built-in clock-driven backend, used when the current API is dummy
+	or no audio devices are available. */
+
+	OpenStreamResult openNullStream_(
+	    const model::KernelAudio::Device& out,
+	    const model::KernelAudio::Device& in,
+	    unsigned int                      sampleRate,
+	    unsigned int                      bufferSize);
+
 	Device fetchDevice(size_t deviceIndex) const;
 	void   printDevices(const std::vector<Device>& devices) const;
 
@@ -174,6 +191,7 @@ private:
 	JackTransport m_jackTransport;
 #endif
 	std::unique_ptr<RtAudio> m_rtAudio;
+	NullAudioBackend         m_nullAudio;
 	CallbackInfo             m_callbackInfo;
 	model::Model&            m_model;
 };
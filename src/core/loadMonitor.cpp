@@ -0,0 +1,161 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2023 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#include "core/loadMonitor.h"
+#include "utils/log.h"
+#include <algorithm>
+#include <limits>
+
+namespace giada::m
+{
+namespace
+{
+constexpr auto RELAXED = std::memory_order_relaxed;
+
+/* -------------------------------------------------------------------------- */
+
+/* increment_
+Adds one to an atomic counter written by a single thread. Cheaper than
+fetch_add, which is a locked instruction on most architectures. */
+
+void increment_(std::atomic<std::uint64_t>& a)
+{
+	a.store(a.load(RELAXED) + 1, RELAXED);
+}
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+LoadMonitor::LoadMonitor()
+: m_resetRequested(false)
+{
+	clear();
+}
+
+/* -------------------------------------------------------------------------- */
+
+LoadMonitor::Stats LoadMonitor::getStats() const
+{
+	Stats stats;
+
+	stats.blocks     = m_blocks.load(RELAXED);
+	stats.load       = m_load.load(RELAXED);
+	stats.minLoad    = m_minLoad.load(RELAXED);
+	stats.maxLoad    = m_maxLoad.load(RELAXED);
+	stats.avgLoad    = stats.blocks > 0 ? m_sumLoad.load(RELAXED) / stats.blocks : 0.0f;
+	stats.overloads  = m_overloads.load(RELAXED);
+	stats.underflows = m_underflows.load(RELAXED);
+	stats.overflows  = m_overflows.load(RELAXED);
+
+	for (int i = 0; i < HISTOGRAM_SIZE; i++)
+		stats.histogram[i] = m_histogram[i].load(RELAXED);
+
+	if (stats.blocks == 0)
+		stats.minLoad = 0.0f;
+
+	return stats;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void LoadMonitor::record(double elapsed, double period)
+{
+	if (m_resetRequested.exchange(false, RELAXED))
+		clear();
+
+	if (period <= 0.0)
+		return;
+
+	const float load   = static_cast<float>(elapsed / period);
+	const int   bucket = std::min(static_cast<int>(load * 10), HISTOGRAM_SIZE - 1);
+
+	m_load.store(load, RELAXED);
+	m_minLoad.store(std::min(m_minLoad.load(RELAXED), load), RELAXED);
+	m_maxLoad.store(std::max(m_maxLoad.load(RELAXED), load), RELAXED);
+	m_sumLoad.store(m_sumLoad.load(RELAXED) + load, RELAXED);
+	increment_(m_histogram[bucket]);
+	increment_(m_blocks);
+
+	if (load > 1.0f)
+		increment_(m_overloads);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void LoadMonitor::recordXrun(bool inputOverflow, bool outputUnderflow)
+{
+	if (inputOverflow)
+		increment_(m_overflows);
+	if (outputUnderflow)
+		increment_(m_underflows);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void LoadMonitor::reset()
+{
+	m_resetRequested.store(true, RELAXED);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void LoadMonitor::dump() const
+{
+	const Stats stats = getStats();
+
+	u::log::print("[LoadMonitor] blocks={}, DSP load min/avg/max={:.1f}%/{:.1f}%/{:.1f}%\n",
+	    stats.blocks, stats.minLoad * 100, stats.avgLoad * 100, stats.maxLoad * 100);
+	u::log::print("[LoadMonitor] overloads={}, underflows={}, overflows={}\n",
+	    stats.overloads, stats.underflows, stats.overflows);
+
+	for (int i = 0; i < HISTOGRAM_SIZE; i++)
+	{
+		if (i < HISTOGRAM_SIZE - 1)
+			u::log::print("[LoadMonitor]   {:>3}-{:>3}%: {}\n", i * 10, (i + 1) * 10, stats.histogram[i]);
+		else
+			u::log::print("[LoadMonitor]   >= 100%: {}\n", stats.histogram[i]);
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+void LoadMonitor::clear()
+{
+	m_blocks.store(0, RELAXED);
+	m_load.store(0.0f, RELAXED);
+	m_minLoad.store(std::numeric_limits<float>::max(), RELAXED);
+	m_maxLoad.store(0.0f, RELAXED);
+	m_sumLoad.store(0.0, RELAXED);
+	m_overloads.store(0, RELAXED);
+	m_underflows.store(0, RELAXED);
+	m_overflows.store(0, RELAXED);
+
+	for (std::atomic<std::uint64_t>& h : m_histogram)
+		h.store(0, RELAXED);
+}
+} // namespace giada::m
@@ -0,0 +1,111 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2023 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#ifndef G_LOAD_MONITOR_H
+#define G_LOAD_MONITOR_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace giada::m
+{
+/* LoadMonitor
+Lock-free instrumentation of the audio callback. The audio thread records the
+time spent on each block against the block period (i.e. the DSP load) and any
+xrun reported by the audio driver, while other threads can read a snapshot of
+the statistics at any time. */
+
+class LoadMonitor final
+{
+public:
+	/* HISTOGRAM_SIZE
+	Number of DSP load histogram buckets. Each bucket covers 10% of load, the
+	last one collects all blocks that took longer than the period. */
+
+	static constexpr int HISTOGRAM_SIZE = 11;
+
+	struct Stats
+	{
+		std::uint64_t                             blocks     = 0;
+		float                                     load       = 0.0f; // Last block
+		float                                     minLoad    = 0.0f;
+		float                                     avgLoad    = 0.0f;
+		float                                     maxLoad    = 0.0f;
+		std::uint64_t                             overloads  = 0; // Blocks over the deadline
+		std::uint64_t                             underflows = 0; // Output xruns
+		std::uint64_t                             overflows  = 0; // Input xruns
+		std::array<std::uint64_t, HISTOGRAM_SIZE> histogram  = {};
+	};
+
+	LoadMonitor();
+
+	/* getStats
+	Returns a snapshot of the current statistics. Values are read one by one, so
+	the snapshot might be slightly inconsistent while the audio thread runs. */
+
+	Stats getStats() const;
+
+	/* record
+	Records the time spent rendering a block, given the block period. Both 
+	values in seconds. Audio thread only. */
+
+	void record(double elapsed, double period);
+
+	/* recordXrun
+	Records xruns reported by the audio driver. Audio thread only. */
+
+	void recordXrun(bool inputOverflow, bool outputUnderflow);
+
+	/* reset
+	Clears all statistics. The actual reset is performed by the audio thread on
+	the next recorded block. */
+
+	void reset();
+
+	/* dump
+	Prints current statistics to log. */
+
+	void dump() const;
+
+private:
+	void clear();
+
+	std::atomic<std::uint64_t> m_blocks;
+	std::atomic<float>         m_load;
+	std::atomic<float>         m_minLoad;
+	std::atomic<float>         m_maxLoad;
+	std::atomic<double>        m_sumLoad;
+	std::atomic<std::uint64_t> m_overloads;
+	std::atomic<std::uint64_t> m_underflows;
+	std::atomic<std::uint64_t> m_overflows;
+	std::atomic<bool>          m_resetRequested;
+
+	std::array<std::atomic<std::uint64_t>, HISTOGRAM_SIZE> m_histogram;
+};
+} // namespace giada::m
+
+#endif
@@ -25,20 +25,35 @@
  * -------------------------------------------------------------------------- */
 
 #include "core/mixer.h"
+#include "core/audioKernels.h"
 #include "core/const.h"
 #include "core/model/model.h"
 #include "utils/log.h"
 #include "utils/math.h"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <thread>
 
 namespace giada::m
 {
 namespace
 {
-/* CH_LEFT, CH_RIGHT
-Channels identifiers. */
+/* updateActiveChannels_
+Marks regular channels that have actual work to do in the current block as 
+active, and returns how many they are. */
 
-constexpr int CH_LEFT  = 0;
-constexpr int CH_RIGHT = 1;
+int updateActiveChannels_(const std::vector<Channel>& channels, Frame pluginTailFrames)
+{
+	int count = 0;
+	for (const Channel& c : channels)
+	{
+		c.shared->active = !c.isInternal() && c.isActive(pluginTailFrames);
+		if (c.shared->active)
+			count++;
+	}
+	return count;
+}
 } // namespace
 
 /* -------------------------------------------------------------------------- */
@@ -86,6 +101,28 @@ void Mixer::disable()
 
 /* -------------------------------------------------------------------------- */
 
+void Mixer::startRenderPool(int numThreads)
+{
+	assert(!m_model.get().mixer.a_isActive());
+
+	/* Auto mode: a few workers at most, leaving one core to the audio thread,
+	which takes part in the rendering as well. */
+
+	if (numThreads == G_DEFAULT_RENDER_THREADS)
+		numThreads = std::min(static_cast<int>(std::thread::hardware_concurrency()) - 1, G_RENDER_POOL_AUTO_WORKERS);
+
+	m_renderPool.start(std::clamp(numThreads, 0, G_MAX_RENDER_THREADS), std::chrono::microseconds(G_RENDER_POOL_SPIN_TIME_US));
+}
+
+void Mixer::stopRenderPool()
+{
+	assert(!m_model.get().mixer.a_isActive());
+
+	m_renderPool.stop();
+}
+
+/* -------------------------------------------------------------------------- */
+
 void Mixer::allocRecBuffer(int frames)
 {
 	m_model.get().mixer.getRecBuffer().alloc(frames, G_MAX_IO_CHANS);
@@ -154,15 +191,16 @@ void Mixer::render(mcl::AudioBuffer& out, const mcl::AudioBuffer& in, const mode
 	const Channel& masterInCh  = channels.get(Mixer::MASTER_IN_CHANNEL_ID);
 	const Channel& previewCh   = channels.get(Mixer::PREVIEW_CHANNEL_ID);
 
-	const bool  hasInput        = in.isAllocd();
-	const bool  inToOut         = mixer.inToOut;
-	const bool  seqIsActive     = sequencer.isActive();
-	const bool  seqIsRunning    = sequencer.isRunning();
-	const bool  hasSolos        = mixer.hasSolos;
-	const bool  shouldLineInRec = seqIsActive && mixer.isRecordingInput && hasInput;
-	const float recTriggerLevel = kernelAudio.recTriggerLevel;
-	const bool  allowsOverdub   = mixer.inputRecMode == InputRecMode::RIGID;
-	const bool  limitOutput     = kernelAudio.limitOutput;
+	const bool  hasInput         = in.isAllocd();
+	const bool  inToOut          = mixer.inToOut;
+	const bool  seqIsActive      = sequencer.isActive();
+	const bool  seqIsRunning     = sequencer.isRunning();
+	const bool  hasSolos         = mixer.hasSolos;
+	const bool  shouldLineInRec  = seqIsActive && mixer.isRecordingInput && hasInput;
+	const float recTriggerLevel  = kernelAudio.recTriggerLevel;
+	const bool  allowsOverdub    = mixer.inputRecMode == InputRecMode::RIGID;
+	const bool  limitOutput      = kernelAudio.limitOutput;
+	const Frame pluginTailFrames = static_cast<Frame>(kernelAudio.samplerate * G_PLUGIN_TAIL_SECONDS);
 
 	mixer.getInBuffer().clear();
 
@@ -173,14 +211,14 @@ void Mixer::render(mcl::AudioBuffer& out, const mcl::AudioBuffer& in, const mode
 
 	if (hasInput)
 	{
-		processLineIn(mixer, in, masterInCh.volume, recTriggerLevel, seqIsActive);
+		processLineIn(mixer, in, masterInCh.shared->volume.load(), recTriggerLevel, seqIsActive);
 		renderMasterIn(masterInCh, mixer.getInBuffer(), seqIsRunning);
 	}
 
 	if (shouldLineInRec)
 	{
 		const Frame newTrackerPos = lineInRec(in, mixer.getRecBuffer(),
-		    mixer.a_getInputTracker(), maxFramesToRec, masterInCh.volume,
+		    mixer.a_getInputTracker(), maxFramesToRec, masterInCh.shared->volume.load(),
 		    allowsOverdub);
 		mixer.a_setInputTracker(newTrackerPos);
 	}
@@ -189,7 +227,7 @@ void Mixer::render(mcl::AudioBuffer& out, const mcl::AudioBuffer& in, const mode
 	changing data (e.g. Plugins or Waves). */
 
 	if (!layout_RT.locked)
-		renderChannels(channels.getAll(), out, mixer.getInBuffer(), hasSolos, seqIsRunning);
+		renderChannels(channels.getAll(), out, mixer.getInBuffer(), hasSolos, seqIsRunning, pluginTailFrames);
 
 	/* Render remaining internal channels. */
 
@@ -198,7 +236,7 @@ void Mixer::render(mcl::AudioBuffer& out, const mcl::AudioBuffer& in, const mode
 
 	/* Post processing. */
 
-	finalizeOutput(mixer, out, inToOut, limitOutput, masterOutCh.volume);
+	finalizeOutput(mixer, out, inToOut, limitOutput, masterOutCh.shared->volume.load());
 }
 
 /* -------------------------------------------------------------------------- */
@@ -289,9 +327,7 @@ bool Mixer::thresholdReached(Peak p, float threshold) const
 
 Peak Mixer::makePeak(const mcl::AudioBuffer& b) const
 {
-	if (!b.isAllocd())
-		return {0.0f, 0.0f};
-	return {b.getPeak(CH_LEFT), b.getPeak(b.countChannels() == 1 ? CH_LEFT : CH_RIGHT)};
+	return kernels::getPeak(b);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -345,11 +381,44 @@ void Mixer::processLineIn(const model::Mixer& mixer, const mcl::AudioBuffer& inB
 /* -------------------------------------------------------------------------- */
 
 void Mixer::renderChannels(const std::vector<Channel>& channels, mcl::AudioBuffer& out,
-    mcl::AudioBuffer& in, bool hasSolos, bool seqIsRunning) const
+    mcl::AudioBuffer& in, bool hasSolos, bool seqIsRunning, Frame pluginTailFrames) const
 {
+	/* Idle channels (stopped, not monitoring input, plug-in tails died out) are
+	skipped entirely, both in rendering and in mixing. The active set is 
+	computed once here, so that it stays consistent for the whole block. */
+
+	const int activeChannels = updateActiveChannels_(channels, pluginTailFrames);
+
+	if (activeChannels == 0)
+		return;
+
+	/* Each channel renders into its own audio buffer first. This is done in
+	parallel on the RenderPool if there are enough active channels, or by the 
+	audio thread alone otherwise. */
+
+	auto renderJob = [&channels, &in, seqIsRunning](std::size_t i) {
+		const Channel& c = channels[i];
+		if (c.shared->active)
+			c.renderChannel(in, seqIsRunning);
+	};
+
+	if (m_renderPool.countWorkers() > 0 && activeChannels >= G_RENDER_POOL_MIN_CHANNELS)
+		m_renderPool.run(channels.size(), renderJob);
+	else
+		for (std::size_t i = 0; i < channels.size(); i++)
+			renderJob(i);
+
+	/* Then sum all channels into the output buffer, always in the same order
+	so that the final mix doesn't depend on the threads scheduling. Status
+	changes that happened on worker threads are notified from here. */
+
 	for (const Channel& c : channels)
-		if (!c.isInternal())
-			c.render(&out, &in, hasSolos, seqIsRunning);
+	{
+		if (!c.shared->active)
+			continue;
+		c.sendPendingStatus();
+		c.mixChannel(out, hasSolos);
+	}
 }
 
 /* -------------------------------------------------------------------------- */
@@ -371,26 +440,13 @@ void Mixer::renderPreview(const Channel& ch, mcl::AudioBuffer& out, bool seqIsRu
 
 /* -------------------------------------------------------------------------- */
 
-void Mixer::limit(mcl::AudioBuffer& outBuf) const
-{
-	for (int i = 0; i < outBuf.countFrames(); i++)
-		for (int j = 0; j < outBuf.countChannels(); j++)
-			outBuf[i][j] = std::max(-1.0f, std::min(outBuf[i][j], 1.0f));
-}
-
-/* -------------------------------------------------------------------------- */
-
 void Mixer::finalizeOutput(const model::Mixer& mixer, mcl::AudioBuffer& buf,
     bool inToOut, bool shouldLimit, float vol) const
 {
-	if (inToOut)
-		buf.sum(mixer.getInBuffer(), vol);
-	else
-		buf.applyGain(vol);
-
-	if (shouldLimit)
-		limit(buf);
+	/* Gain, inToOut, limiter and peak computation are all performed in a 
+	single pass over the buffer. */
 
-	mixer.a_setPeakOut({buf.getPeak(CH_LEFT), buf.getPeak(CH_RIGHT)});
+	const mcl::AudioBuffer* in = inToOut ? &mixer.getInBuffer() : nullptr;
+	mixer.a_setPeakOut(kernels::finalize(buf, in, vol, shouldLimit));
 }
 } // namespace giada::m
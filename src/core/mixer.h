@@ -29,6 +29,7 @@
 
 #include "core/midiEvent.h"
 #include "core/queue.h"
+#include "core/renderPool.h"
 #include "core/ringBuffer.h"
 #include "core/sequencer.h"
 #include "core/types.h"
@@ -103,6 +104,20 @@ public:
 	void enable();
 	void disable();
 
+	/* startRenderPool
+	Spawns the worker threads used to render channels in parallel. 
+	G_DEFAULT_RENDER_THREADS (-1) picks a small value based on the number of
+	available CPU cores, 0 disables parallel rendering. Must be called only when
+	mixer is disabled. */
+
+	void startRenderPool(int numThreads);
+
+	/* stopRenderPool
+	Stops all render worker threads. Must be called only when mixer is 
+	disabled. */
+
+	void stopRenderPool();
+
 	/* allocRecBuffer
 	Allocates new memory for the virtual input channel. */
 
@@ -190,25 +205,26 @@ private:
 	    float inVol, float recTriggerLevel, bool isSeqActive) const;
 
 	void renderChannels(const std::vector<Channel>& channels, mcl::AudioBuffer& out,
-	    mcl::AudioBuffer& in, bool hasSolos, bool seqIsRunning) const;
+	    mcl::AudioBuffer& in, bool hasSolos, bool seqIsRunning, Frame pluginTailFrames) const;
 	void renderMasterIn(const Channel&, mcl::AudioBuffer& in, bool seqIsRunning) const;
 	void renderMasterOut(const Channel&, mcl::AudioBuffer& out, bool seqIsRunning) const;
 	void renderPreview(const Channel&, mcl::AudioBuffer& out, bool seqIsRunning) const;
 
-	/* limit
-	Applies a very dumb hard limiter. */
-
-	void limit(mcl::AudioBuffer& outBuf) const;
-
 	/* finalizeOutput
 	Last touches after the output has been rendered: apply inToOut if any, apply
-	output volume, compute peak. */
+	output volume, apply a very dumb hard limiter if requested, compute peak. */
 
 	void finalizeOutput(const model::Mixer&, mcl::AudioBuffer&, bool inToOut,
 	    bool limit, float vol) const;
 
 	model::Model& m_model;
 
+	/* m_renderPool
+	Worker threads that help the audio thread rendering channels. Mutable: 
+	strictly for internal use only. */
+
+	mutable RenderPool m_renderPool;
+
 	/* m_signalCbFired, m_endOfRecCbFired
 	Boolean guards to determine whether the callbacks have been fired or not, 
 	to avoid retriggering. Mutable: strictly for internal use only. */
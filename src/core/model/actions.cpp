@@ -36,14 +36,58 @@
 
 namespace giada::m::model
 {
+namespace
+{
+/* ChannelCompare_
+Heterogeneous comparator for actions grouped by channel ID. */
+
+struct ChannelCompare_
+{
+	bool operator()(const Action& a, ID id) const { return a.channelId < id; }
+	bool operator()(ID id, const Action& a) const { return id < a.channelId; }
+	bool operator()(const Action& a, const Action& b) const { return a.channelId < b.channelId; }
+};
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+std::span<const Action> Actions::Playback::getActions(const KeyFrame& k) const
+{
+	return {actions.data() + k.begin, k.end - k.begin};
+}
+
+/* -------------------------------------------------------------------------- */
+
+std::span<const Action> Actions::Playback::getActionsOnChannel(std::span<const Action> as, ID channelId)
+{
+	const auto [first, last] = std::equal_range(as.begin(), as.end(), channelId, ChannelCompare_{});
+	return {first, last};
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+Actions::Actions()
+: m_actions(std::make_shared<Map>())
+, m_playback(std::make_shared<Playback>())
+{
+}
+
+/* -------------------------------------------------------------------------- */
+
 void Actions::set(model::Actions::Map&& actions)
 {
-	m_actions = std::move(actions);
+	m_actions = std::make_shared<Map>(std::move(actions));
+	compile();
 }
 
 void Actions::clearAll()
 {
-	m_actions.clear();
+	m_actions = std::make_shared<Map>();
+	compile();
 }
 
 /* -------------------------------------------------------------------------- */
@@ -83,7 +127,7 @@ void Actions::updateKeyFrames(std::function<Frame(Frame old)> f)
 	/* Copy all existing actions in local map by cloning them, with just a
 	difference: they have a new frame value. */
 
-	for (const auto& [oldFrame, actions] : m_actions)
+	for (const auto& [oldFrame, actions] : *m_actions)
 	{
 		Frame newFrame = f(oldFrame);
 		for (const Action& a : actions)
@@ -95,23 +139,26 @@ void Actions::updateKeyFrames(std::function<Frame(Frame old)> f)
 		G_DEBUG("{} -> {}", oldFrame, newFrame);
 	}
 
-	m_actions = std::move(temp);
+	m_actions = std::make_shared<Map>(std::move(temp));
+	compile();
 }
 
 /* -------------------------------------------------------------------------- */
 
 void Actions::updateEvent(ID id, MidiEvent e)
 {
-	findAction(m_actions, id)->event = e;
+	findAction(edit(), id)->event = e;
+	compile();
 }
 
 /* -------------------------------------------------------------------------- */
 
 void Actions::updateSiblings(ID id, ID prevId, ID nextId)
 {
-	Action* pcurr = findAction(m_actions, id);
-	Action* pprev = findAction(m_actions, prevId);
-	Action* pnext = findAction(m_actions, nextId);
+	Map&    map   = edit();
+	Action* pcurr = findAction(map, id);
+	Action* pprev = findAction(map, prevId);
+	Action* pnext = findAction(map, nextId);
 
 	pcurr->prevId = pprev->id;
 	pcurr->nextId = pnext->id;
@@ -124,13 +171,15 @@ void Actions::updateSiblings(ID id, ID prevId, ID nextId)
 	{
 		pnext->prevId = pcurr->id;
 	}
+
+	compile();
 }
 
 /* -------------------------------------------------------------------------- */
 
 bool Actions::hasActions(ID channelId, int type) const
 {
-	for (const auto& [frame, actions] : m_actions)
+	for (const auto& [frame, actions] : *m_actions)
 		for (const Action& a : actions)
 			if (a.channelId == channelId && (type == 0 || type == a.event.getStatus()))
 				return true;
@@ -139,11 +188,15 @@ bool Actions::hasActions(ID channelId, int type) const
 
 /* -------------------------------------------------------------------------- */
 
-const Actions::Map& Actions::getAll() const { return m_actions; }
+const Actions::Map& Actions::getAll() const { return *m_actions; }
 
 /* -------------------------------------------------------------------------- */
 
-const Action* Actions::findAction(ID id) const { return findAction(m_actions, id); }
+const Actions::Playback& Actions::getPlayback() const { return *m_playback; }
+
+/* -------------------------------------------------------------------------- */
+
+const Action* Actions::findAction(ID id) const { return findAction(*m_actions, id); }
 
 /* -------------------------------------------------------------------------- */
 
@@ -153,7 +206,7 @@ void Actions::debug() const
 {
 	puts("model::actions");
 
-	for (const auto& [frame, actions] : m_actions)
+	for (const auto& [frame, actions] : *m_actions)
 	{
 		fmt::print("\tframe: {}\n", frame);
 		for (const Action& a : actions)
@@ -178,7 +231,8 @@ Action Actions::rec(ID channelId, Frame frame, MidiEvent event)
 	/* If key frame doesn't exist yet, the [] operator in std::map is smart 
 	enough to insert a new item first. No plug-in data for now. */
 
-	m_actions[frame].push_back(a);
+	edit()[frame].push_back(a);
+	compile();
 
 	return a;
 }
@@ -190,31 +244,39 @@ void Actions::rec(std::vector<Action>& actions)
 	if (actions.size() == 0)
 		return;
 
+	Map& map = edit();
+
 	for (const Action& a : actions)
-		if (!exists(a.channelId, a.frame, a.event, m_actions))
-			m_actions[a.frame].push_back(a);
+		if (!exists(a.channelId, a.frame, a.event, map))
+			map[a.frame].push_back(a);
+
+	compile();
 }
 
 /* -------------------------------------------------------------------------- */
 
 void Actions::rec(ID channelId, Frame f1, Frame f2, MidiEvent e1, MidiEvent e2)
 {
-	m_actions[f1].push_back(actionFactory::makeAction(0, channelId, f1, e1));
-	m_actions[f2].push_back(actionFactory::makeAction(0, channelId, f2, e2));
+	Map& map = edit();
 
-	Action* a1 = findAction(m_actions, m_actions[f1].back().id);
-	Action* a2 = findAction(m_actions, m_actions[f2].back().id);
+	map[f1].push_back(actionFactory::makeAction(0, channelId, f1, e1));
+	map[f2].push_back(actionFactory::makeAction(0, channelId, f2, e2));
+
+	Action* a1 = findAction(map, map[f1].back().id);
+	Action* a2 = findAction(map, map[f2].back().id);
 	a1->nextId = a2->id;
 	a2->prevId = a1->id;
+
+	compile();
 }
 
 /* -------------------------------------------------------------------------- */
 
 const std::vector<Action>* Actions::getActionsOnFrame(Frame frame) const
 {
-	if (m_actions.count(frame) == 0)
+	if (m_actions->count(frame) == 0)
 		return nullptr;
-	return &m_actions.at(frame);
+	return &m_actions->at(frame);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -247,7 +309,7 @@ std::vector<Action> Actions::getActionsOnChannel(ID channelId) const
 
 void Actions::forEachAction(std::function<void(const Action&)> f) const
 {
-	for (auto& [_, actions] : m_actions)
+	for (const auto& [_, actions] : *m_actions)
 		for (const Action& action : actions)
 			f(action);
 }
@@ -272,6 +334,50 @@ Action* Actions::findAction(Map& src, ID id)
 
 /* -------------------------------------------------------------------------- */
 
+Actions::Map& Actions::edit()
+{
+	/* Model swaps copy the Layout (and its Actions) on the non-realtime side
+	only, so the reference count can't change behind our back here. */
+
+	if (m_actions.use_count() > 1)
+		m_actions = std::make_shared<Map>(*m_actions);
+	return *m_actions;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Actions::compile()
+{
+	/* Build the new index aside and replace the old one: the audio thread might
+	still be reading it through another Layout copy. */
+
+	std::shared_ptr<Playback> playback = std::make_shared<Playback>();
+
+	std::size_t count = 0;
+	for (const auto& [_, actions] : *m_actions)
+		count += actions.size();
+	playback->actions.reserve(count);
+	playback->keyFrames.reserve(m_actions->size());
+
+	for (const auto& [frame, actions] : *m_actions)
+	{
+		if (actions.empty())
+			continue;
+		const std::size_t begin = playback->actions.size();
+		playback->actions.insert(playback->actions.end(), actions.begin(), actions.end());
+		playback->keyFrames.push_back({frame, begin, playback->actions.size()});
+
+		/* Group actions by channel, so that each channel can quickly find its 
+		own ones. Stable sort to preserve the recording order. */
+
+		std::stable_sort(playback->actions.begin() + begin, playback->actions.end(), ChannelCompare_{});
+	}
+
+	m_playback = std::move(playback);
+}
+
+/* -------------------------------------------------------------------------- */
+
 void Actions::optimize(Map& map)
 {
 	for (auto it = map.cbegin(); it != map.cend();)
@@ -282,9 +388,12 @@ void Actions::optimize(Map& map)
 
 void Actions::removeIf(std::function<bool(const Action&)> f)
 {
-	for (auto& [frame, actions] : m_actions)
+	Map& map = edit();
+
+	for (auto& [frame, actions] : map)
 		actions.erase(std::remove_if(actions.begin(), actions.end(), f), actions.end());
-	optimize(m_actions);
+	optimize(map);
+	compile();
 }
 
 /* -------------------------------------------------------------------------- */
@@ -302,6 +411,6 @@ bool Actions::exists(ID channelId, Frame frame, const MidiEvent& event, const Ma
 
 bool Actions::exists(ID channelId, Frame frame, const MidiEvent& event) const
 {
-	return exists(channelId, frame, event, m_actions);
+	return exists(channelId, frame, event, *m_actions);
 }
 } // namespace giada::m::model
@@ -33,15 +33,55 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <span>
 #include <vector>
 
 namespace giada::m::model
 {
+/* Actions
+The map of recorded actions is stored behind a shared pointer, so that copying
+an Actions object (i.e. on every model swap) is just a reference count bump. 
+The map is shared among copies until one of them is modified: the first write
+clones it (copy-on-write). Each change also recompiles the Playback index, 
+which is what the audio thread reads during sequencer playback. */
+
 class Actions
 {
 public:
 	using Map = std::map<Frame, std::vector<Action>>;
 
+	/* Playback
+	Flat, read-only copy of the whole map for the audio thread. 'actions' holds
+	all actions in a contiguous array sorted by frame and grouped by channel 
+	within each frame, 'keyFrames' holds one entry for each frame with actions,
+	pointing to its range in 'actions'. */
+
+	struct Playback
+	{
+		struct KeyFrame
+		{
+			Frame       frame = 0;
+			std::size_t begin = 0;
+			std::size_t end   = 0;
+		};
+
+		/* getActions
+		Returns the actions recorded on key frame 'k'. */
+
+		std::span<const Action> getActions(const KeyFrame& k) const;
+
+		/* getActionsOnChannel
+		Given the actions of a key frame, returns the ones that belong to channel
+		'channelId'. */
+
+		static std::span<const Action> getActionsOnChannel(std::span<const Action>, ID channelId);
+
+		std::vector<Action>   actions;
+		std::vector<KeyFrame> keyFrames;
+	};
+
+	Actions();
+
 	/* forEachAction
     Applies a read-only callback on each action recorded. NEVER do anything
     inside the callback that might alter the ActionMap. */
@@ -74,6 +114,11 @@ public:
 
 	const Map& getAll() const;
 
+	/* getPlayback
+	Returns a reference to the compiled playback index. */
+
+	const Playback& getPlayback() const;
+
 	/* findAction
 	Finds action given ID. Returns nullptr if not found. */
 
@@ -154,6 +199,18 @@ private:
 	Action*       findAction(Map& src, ID id);
 	const Action* findAction(const Map& src, ID id) const;
 
+	/* edit
+	Returns a writable reference to the map of actions. Clones the map first if
+	it is shared with other Actions objects. */
+
+	Map& edit();
+
+	/* compile
+	Rebuilds the Playback index from the current map. Must be called after any
+	change to the map. */
+
+	void compile();
+
 	/* optimize
     Removes frames without actions. */
 
@@ -161,7 +218,8 @@ private:
 
 	void removeIf(std::function<bool(const Action&)> f);
 
-	Actions::Map m_actions;
+	std::shared_ptr<Map>            m_actions;
+	std::shared_ptr<const Playback> m_playback;
 };
 } // namespace giada::m::model
 
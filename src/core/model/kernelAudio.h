@@ -30,6 +30,7 @@
 #include "core/resampler.h"
 #include "core/types.h"
 #include "deps/rtaudio/RtAudio.h"
+#include <string>
 
 namespace giada::m::model
 {
@@ -42,14 +43,21 @@ struct KernelAudio
 		int channelsStart = 0;
 	};
 
-	RtAudio::Api       api             = G_DEFAULT_SOUNDSYS;
-	Device             deviceOut       = {G_DEFAULT_SOUNDDEV_OUT, G_MAX_IO_CHANS, 0};
-	Device             deviceIn        = {G_DEFAULT_SOUNDDEV_IN, 1, 0};
-	unsigned int       samplerate      = G_DEFAULT_SAMPLERATE;
-	unsigned int       buffersize      = G_DEFAULT_BUFSIZE;
-	bool               limitOutput     = false;
-	Resampler::Quality rsmpQuality     = Resampler::Quality::LINEAR;
-	float              recTriggerLevel = 0.0f;
+	RtAudio::Api       api                = G_DEFAULT_SOUNDSYS;
+	Device             deviceOut          = {G_DEFAULT_SOUNDDEV_OUT, G_MAX_IO_CHANS, 0};
+	Device             deviceIn           = {G_DEFAULT_SOUNDDEV_IN, 1, 0};
+	unsigned int       samplerate         = G_DEFAULT_SAMPLERATE;
+	unsigned int       buffersize         = G_DEFAULT_BUFSIZE;
+	bool               limitOutput        = false;
+	Resampler::Quality rsmpQuality        = Resampler::Quality::LINEAR;
+	float              recTriggerLevel    = 0.0f;
+	int                renderThreads      = G_DEFAULT_RENDER_THREADS;
+	int                streamingThreshold = G_DEFAULT_STREAMING_THRESHOLD;
+	int                sampleMemoryBudget = G_DEFAULT_SAMPLE_BUDGET;
+	bool               lazyWaveLoading    = false;
+	bool               compactSamples     = false; // Per project, from Patch
+	std::string        nullAudioOutFile   = "";
+	std::string        nullAudioInFile    = "";
 };
 } // namespace giada::m::model
 
@@ -32,7 +32,12 @@
 #include "core/waveFactory.h"
 #include "utils/log.h"
 #include "utils/string.h"
+#include "utils/vector.h"
+#include <atomic>
 #include <cassert>
+#include <chrono>
+#include <cmath>
+#include <future>
 #include <memory>
 #ifdef G_DEBUG_MODE
 #include <fmt/core.h>
@@ -87,12 +92,46 @@ void clear_(std::vector<T>& dest, Model& model)
 	DataLock lock = model.lockData(SwapType::NONE);
 	dest.clear();
 }
+
+/* -------------------------------------------------------------------------- */
+
+/* withProject_
+Returns a copy of 'base' with the parts owned by the project (channels,
+actions, sequencer and patch properties) taken from 'project'. Everything else
+(audio and MIDI configuration, behaviors, mixer state) stays as in 'base'. */
+
+Layout withProject_(Layout base, const Layout& project)
+{
+	base.channels                   = project.channels;
+	base.actions                    = project.actions;
+	base.sequencer                  = project.sequencer;
+	base.mixer.hasSolos             = project.mixer.hasSolos;
+	base.kernelAudio.compactSamples = project.kernelAudio.compactSamples;
+	return base;
+}
 } // namespace
 
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
 
+bool isCloseToSwitchPoint(const Sequencer& sequencer, SwitchPoint switchPoint, Frame bufferSize)
+{
+	const Frame period = switchPoint == SwitchPoint::BAR ? sequencer.framesInBar : sequencer.framesInLoop;
+
+	if (period <= 0)
+		return true;
+
+	const Frame sinceBoundary = sequencer.a_getCurrentFrame() % period;
+	const Frame untilBoundary = period - sinceBoundary;
+
+	return sinceBoundary <= bufferSize / 2 || untilBoundary <= bufferSize / 2;
+}
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
 #ifdef G_DEBUG_MODE
 
 void Layout::debug() const
@@ -137,6 +176,7 @@ bool LoadState::isGood() const
 
 Model::Model()
 : onSwap(nullptr)
+, m_preloadStatus(PreloadStatus::NONE)
 {
 }
 
@@ -158,6 +198,8 @@ void Model::init()
 
 void Model::reset()
 {
+	discardPreload();
+
 	m_shared = {};
 
 	Layout& layout          = get();
@@ -167,6 +209,8 @@ void Model::reset()
 	layout.mixer.shared     = &m_shared.mixerShared;
 	layout.channels         = {};
 
+	layout.kernelAudio.compactSamples = false;
+
 	swap(SwapType::NONE);
 }
 
@@ -188,6 +232,12 @@ void Model::load(const Conf& conf)
 	layout.kernelAudio.limitOutput             = conf.limitOutput;
 	layout.kernelAudio.rsmpQuality             = conf.rsmpQuality;
 	layout.kernelAudio.recTriggerLevel         = conf.recTriggerLevel;
+	layout.kernelAudio.renderThreads           = conf.renderThreads;
+	layout.kernelAudio.streamingThreshold      = conf.streamingThreshold;
+	layout.kernelAudio.sampleMemoryBudget      = conf.sampleMemoryBudget;
+	layout.kernelAudio.lazyWaveLoading         = conf.lazyWaveLoading;
+	layout.kernelAudio.nullAudioOutFile        = conf.nullAudioOutFile;
+	layout.kernelAudio.nullAudioInFile         = conf.nullAudioInFile;
 
 	layout.kernelMidi.api         = conf.midiSystem;
 	layout.kernelMidi.portOut     = conf.midiPortOut;
@@ -220,53 +270,363 @@ void Model::load(const Conf& conf)
 
 /* -------------------------------------------------------------------------- */
 
-LoadState Model::load(const Patch& patch, PluginManager& pluginManager, int sampleRate, int bufferSize, Resampler::Quality rsmpQuality)
+LoadState Model::load(const Patch& patch, PluginManager& pluginManager, int sampleRate, int bufferSize,
+    Resampler::Quality rsmpQuality, bool lazyWaves, std::function<void(float)> progress)
 {
-	const float sampleRateRatio = sampleRate / static_cast<float>(patch.samplerate);
-
 	/* Lock the shared data. Real-time thread can't read from it until this method
 	goes out of scope. */
 
-	DataLock  lock   = lockData(SwapType::NONE);
-	Layout&   layout = get();
-	LoadState state{patch};
+	DataLock lock = lockData(SwapType::NONE);
 
 	/* Clear and re-initialize stuff first. */
 
-	layout.channels = {};
+	get().channels = {};
 	getAllChannelsShared().clear();
 	getAllPlugins().clear();
 	getAllWaves().clear();
 
-	/* Load external data first: plug-ins and waves. */
+	return loadPatch(patch, pluginManager, sampleRate, bufferSize, rsmpQuality, lazyWaves, progress, get(), m_shared);
+
+	// Swap is performed when 'lock' goes out of scope
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Model::preload(const Patch& patch, PluginManager& pluginManager, int sampleRate, int bufferSize,
+    Resampler::Quality rsmpQuality, SwitchPoint switchPoint, std::function<void(float)> progress)
+{
+	assert(m_preload == nullptr);
+	assert(m_preloadStatus.load() == PreloadStatus::NONE);
+
+	/* Start from a copy of the current Layout, so that configuration data and
+	pointers to sequencer and mixer shared data are carried over. The audio
+	thread doesn't know about this Layout yet: it can be filled in freely. */
+
+	std::unique_ptr<Preload> preload = std::make_unique<Preload>();
+	Layout&                  layout  = preload->layout;
+
+	layout               = get();
+	layout.locked        = false;
+	layout.channels      = {};
+	preload->switchPoint = switchPoint;
+	preload->state       = {patch};
+	preload->sampleRate  = sampleRate;
+	preload->bufferSize  = bufferSize;
+	preload->rsmpQuality = rsmpQuality;
+
+	/* Samples are decoded in background, while plug-ins are instantiated here.
+	The rest is up to armPreload(), once samples are ready: the calling thread
+	never waits for them. */
+
+	preload->waves = loadWaves(preload->state.patch.waves, sampleRate, rsmpQuality,
+	    layout.kernelAudio.streamingThreshold, []() {}, preload->cancel.get_token());
+
+	const float steps = static_cast<float>(patch.plugins.size());
+	std::size_t done  = 0;
+
+	auto onPluginLoaded = [&progress, &done, steps]() {
+		progress(++done / steps);
+	};
+
+	loadPlugins(preload->state.patch, pluginManager, sampleRate, bufferSize, onPluginLoaded, preload->state, preload->shared);
+
+	m_preload = std::move(preload);
+	m_preloadStatus.store(PreloadStatus::LOADING);
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool Model::isPreloadLoaded() const
+{
+	return m_preloadStatus.load() == PreloadStatus::LOADING &&
+	       m_preload->waves.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+/* -------------------------------------------------------------------------- */
+
+LoadState Model::armPreload()
+{
+	assert(isPreloadLoaded());
+
+	Preload&     preload = *m_preload;
+	Layout&      layout  = preload.layout;
+	const Patch& patch   = preload.state.patch;
+
+	assemble(patch, preload.waves.get(), patch.waves, preload.sampleRate, preload.bufferSize, preload.rsmpQuality,
+	    /*lazyWaves=*/false, preload.state, layout, preload.shared);
+
+	/* Do here what the engine does after load (2) on the current Layout: adjust
+	actions to the current sample rate, compute frames and solos. The sequencer
+	keeps the status of the current project, so that it doesn't stop across the
+	switch. Recordings, instead, are not carried over. */
+
+	if (preload.sampleRate != patch.samplerate)
+	{
+		const float ratio = preload.sampleRate / static_cast<float>(patch.samplerate);
+		layout.actions.updateKeyFrames([=](Frame old) { return floorf(old * ratio); });
+	}
+
+	layout.sequencer.status = get().sequencer.status;
+	layout.sequencer.recomputeFrames(preload.sampleRate);
+
+	layout.mixer.hasSolos = layout.channels.anyOf([](const Channel& ch) {
+		return !ch.isInternal() && ch.isSoloed();
+	});
+
+	/* The rest of the Layout comes from the current one, as it is now: it may
+	have been changed while samples were being decoded. */
+
+	layout = withProject_(get(), layout);
+
+	layout.locked                   = false;
+	layout.mixer.isRecordingInput   = false;
+	layout.mixer.isRecordingActions = false;
+
+	/* Hand the Layout over to the audio thread. */
+
+	m_preloadStatus.store(PreloadStatus::ARMED);
+
+	return preload.state;
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool Model::isPreloadReady() const
+{
+	const PreloadStatus status = m_preloadStatus.load();
+
+	if (status == PreloadStatus::SWITCHED)
+		return true;
+	if (status != PreloadStatus::ARMED)
+		return false;
+
+	/* The audio thread switches on its own only while both projects are
+	running. In any other case the switch is done on the calling thread, right
+	away. Never during a recording, though. */
+
+	const Layout& layout = get();
+
+	if (layout.mixer.isRecordingInput || layout.mixer.isRecordingActions)
+		return false;
+	return !layout.sequencer.isRunning() || !m_preload->layout.sequencer.isRunning();
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool Model::commitPreload()
+{
+	if (!isPreloadReady())
+		return false;
+
+	/* Take the preloaded Layout back from the audio thread, unless it has
+	switched to it in the meantime. The new project starts from its first frame,
+	with the status of the current sequencer. */
+
+	PreloadStatus status = PreloadStatus::ARMED;
+
+	if (m_preloadStatus.compare_exchange_strong(status, PreloadStatus::NONE))
+	{
+		waitForRt();
+		m_preload->layout.sequencer.status = get().sequencer.status;
+		m_preload->layout.sequencer.a_setCurrentFrame(0, /*sampleRate=*/0); // No need for sampleRate, it's just 0
+	}
+	else if (status != PreloadStatus::SWITCHED)
+		return false;
+
+	/* Move shared data in place. Objects are on the heap, so the preloaded
+	Layout still points to valid data. Old shared data goes away only after the
+	swap, when the audio thread is surely not using it anymore. */
+
+	std::vector<std::unique_ptr<ChannelShared>> oldChannelsShared = std::move(m_shared.channelsShared);
+	std::vector<std::unique_ptr<Wave>>          oldWaves          = std::move(m_shared.waves);
+	std::vector<std::unique_ptr<Plugin>>        oldPlugins        = std::move(m_shared.plugins);
+
+	m_shared.channelsShared = std::move(m_preload->shared.channelsShared);
+	m_shared.waves          = std::move(m_preload->shared.waves);
+	m_shared.plugins        = std::move(m_preload->shared.plugins);
+
+	/* Only the project is taken from the preloaded Layout: anything else might
+	have been changed since armPreload() and must be kept. */
+
+	get() = withProject_(get(), m_preload->layout);
+	swap(SwapType::HARD);
+
+	m_preloadStatus.store(PreloadStatus::NONE);
+	waitForRt();
+	m_preload.reset();
+
+	return true;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Model::discardPreload()
+{
+	const PreloadStatus status = m_preloadStatus.exchange(PreloadStatus::NONE);
+	if (status == PreloadStatus::ARMED || status == PreloadStatus::SWITCHED)
+		waitForRt();
+
+	/* Samples might still be decoding: stop it, so that destroying the future
+	doesn't wait for the whole project to be loaded. */
+
+	if (m_preload != nullptr)
+		m_preload->cancel.request_stop();
+	m_preload.reset();
+}
+
+/* -------------------------------------------------------------------------- */
+
+const Layout* Model::getPreloaded_RT() const
+{
+	const PreloadStatus status = m_preloadStatus.load();
+	return status == PreloadStatus::ARMED || status == PreloadStatus::SWITCHED ? &m_preload->layout : nullptr;
+}
+
+/* -------------------------------------------------------------------------- */
+
+const Layout& Model::getLayoutToRender_RT(const Layout& layout_RT, Frame bufferSize) const
+{
+	const Layout* preloaded_RT = getPreloaded_RT();
+
+	if (preloaded_RT == nullptr)
+		return layout_RT;
+	if (m_preloadStatus.load() == PreloadStatus::SWITCHED)
+		return *preloaded_RT;
+
+	/* Switch only while both projects are running, and never in the middle of
+	a recording. The main thread takes care of the other cases. */
+
+	const Sequencer& sequencer = layout_RT.sequencer;
+	const Mixer&     mixer     = layout_RT.mixer;
+
+	if (!sequencer.isRunning() || !preloaded_RT->sequencer.isRunning() ||
+	    mixer.isRecordingInput || mixer.isRecordingActions)
+		return layout_RT;
+	if (!isCloseToSwitchPoint(sequencer, m_preload->switchPoint, bufferSize))
+		return layout_RT;
+	if (!switchToPreloaded_RT())
+		return layout_RT;
+
+	/* The new project starts from its first frame, right at this block. */
+
+	preloaded_RT->sequencer.a_setCurrentFrame(0, /*sampleRate=*/0); // No need for sampleRate, it's just 0
+
+	return *preloaded_RT;
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool Model::switchToPreloaded_RT() const
+{
+	PreloadStatus expected = PreloadStatus::ARMED;
+	return m_preloadStatus.compare_exchange_strong(expected, PreloadStatus::SWITCHED);
+}
+
+/* -------------------------------------------------------------------------- */
+
+LoadState Model::loadPatch(const Patch& patch, PluginManager& pluginManager, int sampleRate, int bufferSize,
+    Resampler::Quality rsmpQuality, bool lazyWaves, std::function<void(float)> progress, Layout& layout, Shared& shared)
+{
+	LoadState state{patch};
+
+	/* Load external data first: plug-ins and waves. Waves are decoded in the
+	background while plug-ins are instantiated here. Progress counts one step
+	per plug-in or wave. Lazy loading skips waves altogether. */
+
+	const std::vector<Patch::Wave>  noWaves;
+	const std::vector<Patch::Wave>& waves = lazyWaves ? noWaves : patch.waves;
+
+	const float              steps = static_cast<float>(patch.plugins.size() + waves.size());
+	std::atomic<std::size_t> done  = 0;
+
+	auto reportProgress = [&progress, &done, steps]() {
+		progress(steps > 0 ? done.load() / steps : 1.0f);
+	};
+
+	std::future<std::vector<std::unique_ptr<Wave>>> pendingWaves = loadWaves(waves, sampleRate, rsmpQuality,
+	    layout.kernelAudio.streamingThreshold, [&done]() { done++; });
+
+	auto onPluginLoaded = [&done, &reportProgress]() {
+		done++;
+		reportProgress();
+	};
+
+	loadPlugins(patch, pluginManager, sampleRate, bufferSize, onPluginLoaded, state, shared);
+
+	while (pendingWaves.wait_for(std::chrono::milliseconds(G_LOAD_PROGRESS_RATE_MS)) != std::future_status::ready)
+		reportProgress();
+	reportProgress();
+
+	assemble(patch, pendingWaves.get(), waves, sampleRate, bufferSize, rsmpQuality, lazyWaves, state, layout, shared);
+
+	return state;
+}
+
+/* -------------------------------------------------------------------------- */
+
+std::future<std::vector<std::unique_ptr<Wave>>> Model::loadWaves(const std::vector<Patch::Wave>& waves,
+    int sampleRate, Resampler::Quality rsmpQuality, int streamingThreshold, std::function<void()> onLoaded,
+    std::stop_token stop) const
+{
+	return std::async(std::launch::async, [&waves, sampleRate, rsmpQuality, streamingThreshold, onLoaded, stop]() {
+		return waveFactory::deserializeWaves(waves, sampleRate, rsmpQuality, streamingThreshold, onLoaded, stop);
+	});
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Model::loadPlugins(const Patch& patch, PluginManager& pluginManager, int sampleRate, int bufferSize,
+    std::function<void()> onLoaded, LoadState& state, Shared& shared)
+{
+	/* Plug-ins read the sequencer state from the current non-realtime Layout,
+	which is also the one a preloaded Layout will be copied into. */
 
 	for (const Patch::Plugin& pplugin : patch.plugins)
 	{
 		std::unique_ptr<juce::AudioPluginInstance> pi = pluginManager.makeJucePlugin(pplugin.path, sampleRate, bufferSize);
-		std::unique_ptr<Plugin>                    p  = pluginFactory::deserializePlugin(pplugin, std::move(pi), layout.sequencer, sampleRate, bufferSize);
+		std::unique_ptr<Plugin>                    p  = pluginFactory::deserializePlugin(pplugin, std::move(pi), get().sequencer, sampleRate, bufferSize);
 		if (!p->valid)
 			state.missingPlugins.push_back(pplugin.path);
-		getAllPlugins().push_back(std::move(p));
+		shared.plugins.push_back(std::move(p));
+		onLoaded();
 	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Model::assemble(const Patch& patch, std::vector<std::unique_ptr<Wave>> loadedWaves, const std::vector<Patch::Wave>& waves,
+    int sampleRate, int bufferSize, Resampler::Quality rsmpQuality, bool lazyWaves, LoadState& state, Layout& layout, Shared& shared)
+{
+	const float sampleRateRatio = sampleRate / static_cast<float>(patch.samplerate);
+
+	/* Waves are added to the model in patch order, so that the memory budget
+	for compact Waves is checked the same way on each load. */
 
-	for (const Patch::Wave& pwave : patch.waves)
+	layout.kernelAudio.compactSamples = patch.compactSamples;
+
+	for (std::size_t i = 0; i < loadedWaves.size(); i++)
 	{
-		std::unique_ptr<Wave> w = waveFactory::deserializeWave(pwave, sampleRate, rsmpQuality);
-		if (w != nullptr)
-			getAllWaves().push_back(std::move(w));
-		else
-			state.missingWaves.push_back(pwave.path);
+		std::unique_ptr<Wave>& w = loadedWaves[i];
+		if (w == nullptr)
+		{
+			state.missingWaves.push_back(waves[i].path);
+			continue;
+		}
+		waveFactory::compact(*w, layout.kernelAudio.compactSamples, layout.kernelAudio.sampleMemoryBudget, shared.waves);
+		shared.waves.push_back(std::move(w));
 	}
 
 	/* Then load up channels, actions and global properties. */
 
 	for (const Patch::Channel& pchannel : patch.channels)
 	{
-		Wave*                wave    = findWave(pchannel.waveId);
-		std::vector<Plugin*> plugins = findPlugins(pchannel.pluginIds);
+		Wave*                wave    = get_(shared.waves, pchannel.waveId);
+		std::vector<Plugin*> plugins = findPlugins(pchannel.pluginIds, shared);
 		channelFactory::Data data    = channelFactory::deserializeChannel(pchannel, sampleRateRatio, bufferSize, rsmpQuality, wave, plugins);
+		if (lazyWaves && u::vector::has(patch.waves, [&pchannel](const Patch::Wave& w) { return w.id == pchannel.waveId; }))
+			data.shared->playStatus.store(ChannelStatus::LOADING);
 		layout.channels.add(data.channel);
-		getAllChannelsShared().push_back(std::move(data.shared));
+		shared.channelsShared.push_back(std::move(data.shared));
 	}
 
 	layout.actions.set(actionFactory::deserializeActions(patch.actions));
@@ -277,10 +637,6 @@ LoadState Model::load(const Patch& patch, PluginManager& pluginManager, int samp
 	layout.sequencer.bpm       = patch.bpm;
 	layout.sequencer.quantize  = patch.quantize;
 	layout.sequencer.metronome = patch.metronome;
-
-	return state;
-
-	// Swap is performed when 'lock' goes out of scope
 }
 
 /* -------------------------------------------------------------------------- */
@@ -289,18 +645,24 @@ void Model::store(Conf& conf) const
 {
 	const Layout& layout = get();
 
-	conf.soundSystem      = layout.kernelAudio.api;
-	conf.soundDeviceOut   = layout.kernelAudio.deviceOut.index;
-	conf.channelsOutCount = layout.kernelAudio.deviceOut.channelsCount;
-	conf.channelsOutStart = layout.kernelAudio.deviceOut.channelsStart;
-	conf.soundDeviceIn    = layout.kernelAudio.deviceIn.index;
-	conf.channelsInCount  = layout.kernelAudio.deviceIn.channelsCount;
-	conf.channelsInStart  = layout.kernelAudio.deviceIn.channelsStart;
-	conf.samplerate       = layout.kernelAudio.samplerate;
-	conf.buffersize       = layout.kernelAudio.buffersize;
-	conf.limitOutput      = layout.kernelAudio.limitOutput;
-	conf.rsmpQuality      = layout.kernelAudio.rsmpQuality;
-	conf.recTriggerLevel  = layout.kernelAudio.recTriggerLevel;
+	conf.soundSystem        = layout.kernelAudio.api;
+	conf.soundDeviceOut     = layout.kernelAudio.deviceOut.index;
+	conf.channelsOutCount   = layout.kernelAudio.deviceOut.channelsCount;
+	conf.channelsOutStart   = layout.kernelAudio.deviceOut.channelsStart;
+	conf.soundDeviceIn      = layout.kernelAudio.deviceIn.index;
+	conf.channelsInCount    = layout.kernelAudio.deviceIn.channelsCount;
+	conf.channelsInStart    = layout.kernelAudio.deviceIn.channelsStart;
+	conf.samplerate         = layout.kernelAudio.samplerate;
+	conf.buffersize         = layout.kernelAudio.buffersize;
+	conf.limitOutput        = layout.kernelAudio.limitOutput;
+	conf.rsmpQuality        = layout.kernelAudio.rsmpQuality;
+	conf.recTriggerLevel    = layout.kernelAudio.recTriggerLevel;
+	conf.renderThreads      = layout.kernelAudio.renderThreads;
+	conf.streamingThreshold = layout.kernelAudio.streamingThreshold;
+	conf.sampleMemoryBudget = layout.kernelAudio.sampleMemoryBudget;
+	conf.lazyWaveLoading    = layout.kernelAudio.lazyWaveLoading;
+	conf.nullAudioOutFile   = layout.kernelAudio.nullAudioOutFile;
+	conf.nullAudioInFile    = layout.kernelAudio.nullAudioInFile;
 
 	conf.midiSystem  = layout.kernelMidi.api;
 	conf.midiPortOut = layout.kernelMidi.portOut;
@@ -341,11 +703,12 @@ void Model::store(Patch& patch, const std::string& projectPath)
 
 	const Layout& layout = get();
 
-	patch.bars      = layout.sequencer.bars;
-	patch.beats     = layout.sequencer.beats;
-	patch.bpm       = layout.sequencer.bpm;
-	patch.quantize  = layout.sequencer.quantize;
-	patch.metronome = layout.sequencer.metronome;
+	patch.bars           = layout.sequencer.bars;
+	patch.beats          = layout.sequencer.beats;
+	patch.bpm            = layout.sequencer.bpm;
+	patch.quantize       = layout.sequencer.quantize;
+	patch.metronome      = layout.sequencer.metronome;
+	patch.compactSamples = layout.kernelAudio.compactSamples;
 
 	for (const auto& p : getAllPlugins())
 		patch.plugins.push_back(pluginFactory::serializePlugin(*p));
@@ -405,6 +768,14 @@ bool Model::isLocked() const
 
 /* -------------------------------------------------------------------------- */
 
+void Model::waitForRt() const
+{
+	while (isLocked())
+		;
+}
+
+/* -------------------------------------------------------------------------- */
+
 std::vector<std::unique_ptr<Wave>>&          Model::getAllWaves() { return m_shared.waves; };
 std::vector<std::unique_ptr<Plugin>>&        Model::getAllPlugins() { return m_shared.plugins; }
 std::vector<std::unique_ptr<ChannelShared>>& Model::getAllChannelsShared() { return m_shared.channelsShared; }
@@ -432,12 +803,12 @@ void Model::clearWaves() { clear_(m_shared.waves, *this); }
 
 /* -------------------------------------------------------------------------- */
 
-std::vector<Plugin*> Model::findPlugins(std::vector<ID> pluginIds)
+std::vector<Plugin*> Model::findPlugins(std::vector<ID> pluginIds, Shared& shared)
 {
 	std::vector<Plugin*> out;
 	for (ID id : pluginIds)
 	{
-		Plugin* plugin = findPlugin(id);
+		Plugin* plugin = get_(shared.plugins, id);
 		if (plugin != nullptr)
 			out.push_back(plugin);
 	}
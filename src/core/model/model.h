@@ -42,7 +42,11 @@
 #include "deps/mcl-atomic-swapper/src/atomic-swapper.hpp"
 #include "deps/mcl-audio-buffer/src/audioBuffer.hpp"
 #include "utils/vector.h"
+#include <atomic>
+#include <functional>
+#include <future>
 #include <memory>
+#include <stop_token>
 
 namespace giada::m::model
 {
@@ -90,6 +94,15 @@ enum class SwapType
 	NONE
 };
 
+/* SwitchPoint
+Musical boundary at which a preloaded project takes over the current one. */
+
+enum class SwitchPoint
+{
+	BAR,
+	LOOP
+};
+
 /* -------------------------------------------------------------------------- */
 
 /* LoadState
@@ -106,6 +119,16 @@ struct LoadState
 
 /* -------------------------------------------------------------------------- */
 
+/* isCloseToSwitchPoint
+Tells whether a block of 'bufferSize' frames starting at the current frame of
+'sequencer' starts within half a block from a bar (or loop) boundary, before or
+after it. Blocks can't be split between two Layouts: this picks the block start
+closest to the boundary. Always true if the boundary has no length. */
+
+bool isCloseToSwitchPoint(const Sequencer&, SwitchPoint, Frame bufferSize);
+
+/* -------------------------------------------------------------------------- */
+
 class DataLock;
 class Model
 {
@@ -136,10 +159,72 @@ public:
 
 	void load(const Conf&);
 
-	/* load (2) 
-	Loads data from a Patch object. */
+	/* load (2)
+	Loads data from a Patch object. Samples are decoded in parallel in the
+	background while plug-ins are instantiated on the calling thread; the
+	model is then assembled in one go. 'progress' is called on the calling
+	thread with values in [0.0, 1.0]. If 'lazyWaves' is true samples are not
+	loaded at all: channels referring to a sample are left in LOADING status,
+	waiting for their Wave to be loaded later on (see WaveLoader). */
+
+	LoadState load(const Patch&, PluginManager&, int sampleRate, int bufferSize, Resampler::Quality,
+	    bool lazyWaves, std::function<void(float)> progress);
+
+	/* preload
+	Starts loading a Patch into a shadow Layout, while the current one keeps
+	playing. Only plug-ins are instantiated on the calling thread, with
+	'progress' called for each of them. Samples are decoded in background: call
+	armPreload() once isPreloadLoaded() returns true. */
+
+	void preload(const Patch&, PluginManager&, int sampleRate, int bufferSize, Resampler::Quality,
+	    SwitchPoint, std::function<void(float)> progress);
+
+	/* isPreloadLoaded
+	True if the samples of a preload() have been decoded, i.e. armPreload() can
+	be called without blocking. */
+
+	bool isPreloadLoaded() const;
+
+	/* armPreload
+	Completes a preload() as load (2) does, without touching the current
+	Layout. The shadow Layout is then handed over to the audio thread, which
+	switches to it at the next 'switchPoint'. Call commitPreload() afterwards to
+	make it the current one. Returns the LoadState of the preloaded Patch. */
+
+	LoadState armPreload();
+
+	/* isPreloadReady
+	Tells whether commitPreload() would commit the preloaded Layout right now. */
+
+	bool isPreloadReady() const;
+
+	/* commitPreload
+	Makes the preloaded Layout the current one with a single swap, as soon as
+	the audio thread has switched to it. If the sequencer is not running there's
+	no beat to wait for: the swap is done right away. The old shared data is
+	freed. Returns true if the preloaded Layout has been committed. */
+
+	bool commitPreload();
+
+	/* discardPreload
+	Drops the preloaded Layout, if any, even if the audio thread has already
+	switched to it. Samples still being decoded are given up: this waits only
+	for the chunks in progress. */
+
+	void discardPreload();
+
+	/* getPreloaded_RT
+	Returns the preloaded Layout waiting to be committed, or nullptr if there's
+	none. REALTIME. */
 
-	LoadState load(const Patch&, PluginManager&, int sampleRate, int bufferSize, Resampler::Quality);
+	const Layout* getPreloaded_RT() const;
+
+	/* getLayoutToRender_RT
+	Returns the Layout to render in the current block of 'bufferSize' frames: a
+	preloaded one, if the time has come to switch to it, 'layout_RT' otherwise.
+	REALTIME. */
+
+	const Layout& getLayoutToRender_RT(const Layout& layout_RT, Frame bufferSize) const;
 
 	/* store
 	Stores data into a Conf object. */
@@ -218,10 +303,83 @@ private:
 		std::vector<std::unique_ptr<Plugin>> plugins;
 	};
 
-	std::vector<Plugin*> findPlugins(std::vector<ID> pluginIds);
+	/* Preload
+	A project loaded by preload(). Only the vectors of its Shared object are
+	used: sequencer and mixer shared data are the ones of the current project.
+	'waves' refers to the Patch in 'state': it's declared last, so that it's
+	destroyed first, waiting for the decoding to be over. Request a stop on
+	'cancel' beforehand to cut the wait short. */
+
+	struct Preload
+	{
+		Layout             layout;
+		Shared             shared;
+		SwitchPoint        switchPoint = SwitchPoint::LOOP;
+		LoadState          state;
+		int                sampleRate  = 0;
+		int                bufferSize  = 0;
+		Resampler::Quality rsmpQuality = Resampler::Quality::LINEAR;
+		std::stop_source   cancel;
+
+		std::future<std::vector<std::unique_ptr<Wave>>> waves;
+	};
+
+	enum class PreloadStatus
+	{
+		NONE,
+		LOADING, // Samples being decoded in background
+		ARMED,   // Waiting for the audio thread to switch to it
+		SWITCHED // Rendered by the audio thread, waiting to be committed
+	};
+
+	/* loadPatch
+	Fills 'layout' and 'shared' with the content of a Patch, waiting for all
+	samples to be decoded. Used by load (2). */
+
+	LoadState loadPatch(const Patch&, PluginManager&, int sampleRate, int bufferSize, Resampler::Quality,
+	    bool lazyWaves, std::function<void(float)> progress, Layout&, Shared&);
+
+	/* loadWaves
+	Starts decoding 'waves' in background, by a pool of threads. 'onLoaded' is
+	called from any thread each time a Wave is done. 'waves' must outlive the
+	returned future. Decoding is given up when 'stop' is requested. */
+
+	std::future<std::vector<std::unique_ptr<Wave>>> loadWaves(const std::vector<Patch::Wave>& waves,
+	    int sampleRate, Resampler::Quality, int streamingThreshold, std::function<void()> onLoaded,
+	    std::stop_token stop = {}) const;
+
+	/* loadPlugins
+	Instantiates the plug-ins of a Patch into 'shared', on the calling thread as
+	plug-in formats want. 'onLoaded' is called each time a plug-in is done. */
+
+	void loadPlugins(const Patch&, PluginManager&, int sampleRate, int bufferSize,
+	    std::function<void()> onLoaded, LoadState&, Shared&);
+
+	/* assemble
+	Adds decoded 'loadedWaves' to 'shared', then fills 'layout' with channels,
+	actions and global properties of a Patch. */
+
+	void assemble(const Patch&, std::vector<std::unique_ptr<Wave>> loadedWaves, const std::vector<Patch::Wave>& waves,
+	    int sampleRate, int bufferSize, Resampler::Quality, bool lazyWaves, LoadState&, Layout&, Shared&);
+
+	std::vector<Plugin*> findPlugins(std::vector<ID> pluginIds, Shared&);
+
+	/* switchToPreloaded_RT
+	Marks the preloaded Layout as the one to render from now on. Returns false
+	if it has been withdrawn in the meantime. REALTIME. */
+
+	bool switchToPreloaded_RT() const;
+
+	/* waitForRt
+	Spins until the audio thread is done with the current block. */
+
+	void waitForRt() const;
 
 	AtomicSwapper m_swapper;
 	Shared        m_shared;
+
+	std::unique_ptr<Preload>           m_preload;
+	mutable std::atomic<PreloadStatus> m_preloadStatus;
 };
 
 /* -------------------------------------------------------------------------- */
@@ -95,6 +95,16 @@ int Sequencer::getMaxFramesInLoop(int sampleRate) const
 
 /* -------------------------------------------------------------------------- */
 
+void Sequencer::recomputeFrames(int sampleRate)
+{
+	framesInBeat = u::time::beatToFrame(1, sampleRate, bpm);
+	framesInLoop = framesInBeat * beats;
+	framesInBar  = framesInLoop / (float)bars;
+	framesInSeq  = framesInBeat * G_MAX_BEATS;
+}
+
+/* -------------------------------------------------------------------------- */
+
 void Sequencer::a_setCurrentFrame(Frame f, int sampleRate) const
 {
 	shared->currentFrame.store(f);
@@ -69,6 +69,12 @@ public:
 
 	int getMaxFramesInLoop(int sampleRate) const;
 
+	/* recomputeFrames
+	Updates the frame counts (beat, bar, loop, whole sequencer) according to
+	the current bpm, beats and bars. */
+
+	void recomputeFrames(int sampleRate);
+
 	void a_setCurrentFrame(Frame f, int sampleRate) const;
 	void a_setCurrentBeat(int b, int sampleRate) const;
 
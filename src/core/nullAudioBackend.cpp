@@ -0,0 +1,200 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2023 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#include "core/nullAudioBackend.h"
+#include "core/waveFactory.h"
+#include "utils/log.h"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+
+namespace giada::m
+{
+NullAudioBackend::NullAudioBackend()
+: onAudioCallback(nullptr)
+, onXrun(nullptr)
+, m_running(false)
+, m_open(false)
+, m_sampleRate(0)
+, m_inFilePosition(0)
+{
+}
+
+/* -------------------------------------------------------------------------- */
+
+NullAudioBackend::~NullAudioBackend()
+{
+	close();
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool NullAudioBackend::isOpen() const { return m_open; }
+bool NullAudioBackend::isRunning() const { return m_running.load(); }
+
+/* -------------------------------------------------------------------------- */
+
+bool NullAudioBackend::open(int sampleRate, int bufferSize, int channelsOut, int channelsIn,
+    const std::string& outFile, const std::string& inFile)
+{
+	close();
+
+	u::log::print("[NullAudioBackend::open] sampleRate={}, bufferSize={}, channelsOut={}, channelsIn={}\n",
+	    sampleRate, bufferSize, channelsOut, channelsIn);
+
+	if (!outFile.empty())
+	{
+		m_outFile = std::make_unique<AudioFileWriter>(outFile, channelsOut, sampleRate);
+		if (!m_outFile->isOpen())
+		{
+			m_outFile.reset();
+			return false;
+		}
+		u::log::print("[NullAudioBackend::open] writing output to {}\n", outFile);
+	}
+
+	if (!inFile.empty() && channelsIn > 0)
+	{
+		waveFactory::Result res = waveFactory::createFromFile(inFile, /*id=*/0, sampleRate, Resampler::Quality::LINEAR);
+		if (res.status != G_RES_OK)
+		{
+			u::log::print("[NullAudioBackend::open] can't read input file {}\n", inFile);
+			m_outFile.reset();
+			return false;
+		}
+		if (res.wave->getBuffer().countFrames() == 0)
+		{
+			u::log::print("[NullAudioBackend::open] input file {} is empty\n", inFile);
+			m_outFile.reset();
+			return false;
+		}
+		m_inFileData     = std::move(res.wave->getWritableBuffer());
+		m_inFilePosition = 0;
+		u::log::print("[NullAudioBackend::open] reading input from {}\n", inFile);
+	}
+
+	m_out.alloc(bufferSize, channelsOut);
+	if (channelsIn > 0)
+		m_in.alloc(bufferSize, channelsIn);
+
+	m_sampleRate = sampleRate;
+	m_open       = true;
+
+	return true;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void NullAudioBackend::close()
+{
+	stop();
+
+	m_outFile.reset();
+	m_out.free();
+	m_in.free();
+	m_inFileData.free();
+	m_open = false;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void NullAudioBackend::start()
+{
+	assert(m_open);
+	assert(onAudioCallback != nullptr);
+
+	if (m_running.load())
+		return;
+
+	m_running.store(true);
+	m_thread = std::thread([this]() { run(); });
+}
+
+/* -------------------------------------------------------------------------- */
+
+void NullAudioBackend::stop()
+{
+	m_running.store(false);
+	if (m_thread.joinable())
+		m_thread.join();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void NullAudioBackend::run()
+{
+	using Clock = std::chrono::steady_clock;
+
+	const auto period = std::chrono::duration_cast<Clock::duration>(
+	    std::chrono::duration<double>(m_out.countFrames() / static_cast<double>(m_sampleRate)));
+
+	Clock::time_point deadline = Clock::now();
+
+	while (m_running.load())
+	{
+		if (m_inFileData.isAllocd())
+			readInput();
+
+		onAudioCallback(m_out, m_in);
+
+		if (m_outFile != nullptr)
+			m_outFile->write(m_out, m_out.countFrames());
+
+		/* Wait for the next block, as a real audio device would do. If the
+		callback took longer than a period, report an underflow and restart the
+		clock from now, rather than rendering a burst of late blocks. */
+
+		deadline += period;
+
+		const Clock::time_point now = Clock::now();
+		if (now > deadline)
+		{
+			if (onXrun != nullptr)
+				onXrun(/*inputOverflow=*/false, /*outputUnderflow=*/true);
+			deadline = now;
+		}
+		else
+			std::this_thread::sleep_until(deadline);
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+void NullAudioBackend::readInput()
+{
+	const int fileFrames   = m_inFileData.countFrames();
+	const int fileChannels = m_inFileData.countChannels();
+
+	assert(fileFrames > 0);
+
+	for (int i = 0; i < m_in.countFrames(); i++)
+	{
+		for (int j = 0; j < m_in.countChannels(); j++)
+			m_in[i][j] = m_inFileData[m_inFilePosition][std::min(j, fileChannels - 1)];
+		m_inFilePosition = (m_inFilePosition + 1) % fileFrames;
+	}
+}
+} // namespace giada::m
@@ -0,0 +1,109 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2023 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#ifndef G_NULL_AUDIO_BACKEND_H
+#define G_NULL_AUDIO_BACKEND_H
+
+#include "core/audioFileWriter.h"
+#include "deps/mcl-audio-buffer/src/audioBuffer.hpp"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace giada::m
+{
+/* NullAudioBackend
+An audio backend that needs no audio hardware. A clock thread invokes the audio
+callback at the pace of the configured buffer size and sample rate. The output
+can be optionally written to a WAV file, the input optionally read (and looped)
+from an audio file. Useful for testing and profiling the engine on machines
+without a sound card. */
+
+class NullAudioBackend final
+{
+public:
+	NullAudioBackend();
+	~NullAudioBackend();
+
+	bool isOpen() const;
+	bool isRunning() const;
+
+	/* open
+	Prepares the backend. Pass empty paths to disable file output and input,
+	respectively. Returns false if any of the files can't be opened, or if the
+	input file is empty. */
+
+	bool open(int sampleRate, int bufferSize, int channelsOut, int channelsIn,
+	    const std::string& outFile, const std::string& inFile);
+
+	/* close
+	Stops the clock thread and closes any open file. */
+
+	void close();
+
+	/* start, stop
+	Starts and stops the clock thread. */
+
+	void start();
+	void stop();
+
+	/* onAudioCallback
+	Main callback invoked on each audio block by the clock thread. */
+
+	std::function<int(mcl::AudioBuffer& out, const mcl::AudioBuffer& in)> onAudioCallback;
+
+	/* onXrun
+	Callback fired by the clock thread when a block has missed its deadline. */
+
+	std::function<void(bool inputOverflow, bool outputUnderflow)> onXrun;
+
+private:
+	/* run
+	Clock thread main loop. */
+
+	void run();
+
+	/* readInput
+	Fills the input buffer with the next block of the input file, looping it. */
+
+	void readInput();
+
+	std::thread       m_thread;
+	std::atomic<bool> m_running;
+	bool              m_open;
+	int               m_sampleRate;
+
+	mcl::AudioBuffer                 m_out;
+	mcl::AudioBuffer                 m_in;
+	mcl::AudioBuffer                 m_inFileData;
+	int                              m_inFilePosition;
+	std::unique_ptr<AudioFileWriter> m_outFile;
+};
+} // namespace giada::m
+
+#endif
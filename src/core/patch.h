@@ -127,14 +127,15 @@ struct Patch
 	};
 
 	Version     version;
-	int         status     = G_FILE_INVALID;
-	std::string name       = G_DEFAULT_PATCH_NAME;
-	int         bars       = G_DEFAULT_BARS;
-	int         beats      = G_DEFAULT_BEATS;
-	float       bpm        = G_DEFAULT_BPM;
-	bool        quantize   = G_DEFAULT_QUANTIZE;
-	int         samplerate = G_DEFAULT_SAMPLERATE;
-	bool        metronome  = false;
+	int         status         = G_FILE_INVALID;
+	std::string name           = G_DEFAULT_PATCH_NAME;
+	int         bars           = G_DEFAULT_BARS;
+	int         beats          = G_DEFAULT_BEATS;
+	float       bpm            = G_DEFAULT_BPM;
+	bool        quantize       = G_DEFAULT_QUANTIZE;
+	int         samplerate     = G_DEFAULT_SAMPLERATE;
+	bool        metronome      = false;
+	bool        compactSamples = false;
 
 	std::vector<Column>  columns;
 	std::vector<Channel> channels;
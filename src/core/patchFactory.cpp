@@ -38,13 +38,14 @@ namespace
 {
 void readCommons_(Patch& patch, const nlohmann::json& j)
 {
-	patch.name       = j.value(PATCH_KEY_NAME, G_DEFAULT_PATCH_NAME);
-	patch.bars       = j.value(PATCH_KEY_BARS, G_DEFAULT_BARS);
-	patch.beats      = j.value(PATCH_KEY_BEATS, G_DEFAULT_BEATS);
-	patch.bpm        = j.value(PATCH_KEY_BPM, G_DEFAULT_BPM);
-	patch.quantize   = j.value(PATCH_KEY_QUANTIZE, G_DEFAULT_QUANTIZE);
-	patch.samplerate = j.value(PATCH_KEY_SAMPLERATE, G_DEFAULT_SAMPLERATE);
-	patch.metronome  = j.value(PATCH_KEY_METRONOME, false);
+	patch.name           = j.value(PATCH_KEY_NAME, G_DEFAULT_PATCH_NAME);
+	patch.bars           = j.value(PATCH_KEY_BARS, G_DEFAULT_BARS);
+	patch.beats          = j.value(PATCH_KEY_BEATS, G_DEFAULT_BEATS);
+	patch.bpm            = j.value(PATCH_KEY_BPM, G_DEFAULT_BPM);
+	patch.quantize       = j.value(PATCH_KEY_QUANTIZE, G_DEFAULT_QUANTIZE);
+	patch.samplerate     = j.value(PATCH_KEY_SAMPLERATE, G_DEFAULT_SAMPLERATE);
+	patch.metronome      = j.value(PATCH_KEY_METRONOME, false);
+	patch.compactSamples = j.value(PATCH_KEY_COMPACT_SAMPLES, false);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -265,17 +266,18 @@ void writeWaves_(const Patch& patch, nlohmann::json& j)
 
 void writeCommons_(const Patch& patch, nlohmann::json& j)
 {
-	j[PATCH_KEY_HEADER]        = "GIADAPTC";
-	j[PATCH_KEY_VERSION_MAJOR] = G_VERSION_MAJOR;
-	j[PATCH_KEY_VERSION_MINOR] = G_VERSION_MINOR;
-	j[PATCH_KEY_VERSION_PATCH] = G_VERSION_PATCH;
-	j[PATCH_KEY_NAME]          = patch.name;
-	j[PATCH_KEY_BARS]          = patch.bars;
-	j[PATCH_KEY_BEATS]         = patch.beats;
-	j[PATCH_KEY_BPM]           = patch.bpm;
-	j[PATCH_KEY_QUANTIZE]      = patch.quantize;
-	j[PATCH_KEY_SAMPLERATE]    = patch.samplerate;
-	j[PATCH_KEY_METRONOME]     = patch.metronome;
+	j[PATCH_KEY_HEADER]          = "GIADAPTC";
+	j[PATCH_KEY_VERSION_MAJOR]   = G_VERSION_MAJOR;
+	j[PATCH_KEY_VERSION_MINOR]   = G_VERSION_MINOR;
+	j[PATCH_KEY_VERSION_PATCH]   = G_VERSION_PATCH;
+	j[PATCH_KEY_NAME]            = patch.name;
+	j[PATCH_KEY_BARS]            = patch.bars;
+	j[PATCH_KEY_BEATS]           = patch.beats;
+	j[PATCH_KEY_BPM]             = patch.bpm;
+	j[PATCH_KEY_QUANTIZE]        = patch.quantize;
+	j[PATCH_KEY_SAMPLERATE]      = patch.samplerate;
+	j[PATCH_KEY_METRONOME]       = patch.metronome;
+	j[PATCH_KEY_COMPACT_SAMPLES] = patch.compactSamples;
 }
 
 /* -------------------------------------------------------------------------- */
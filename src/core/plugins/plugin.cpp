@@ -39,8 +39,10 @@ Plugin::Plugin(ID id, const std::string& UID)
 , valid(false)
 , onEditorResize(nullptr)
 , m_plugin(nullptr)
+, m_stateVersion(0)
 , m_UID(UID)
 , m_hasEditor(false)
+, m_acceptsMidi(false)
 {
 }
 
@@ -54,7 +56,9 @@ Plugin::Plugin(ID id, std::unique_ptr<juce::AudioPluginInstance> plugin,
 , m_plugin(std::move(plugin))
 , m_playHead(std::move(playHead))
 , m_bypass(false)
+, m_stateVersion(0)
 , m_hasEditor(m_plugin->hasEditor())
+, m_acceptsMidi(m_plugin->acceptsMidi())
 {
 	/* (1) Initialize midiInParams vector, where midiInParams.size == number of 
 	plugin parameters. All values are initially empty (0x0): they will be filled
@@ -82,6 +86,11 @@ Plugin::Plugin(ID id, std::unique_ptr<juce::AudioPluginInstance> plugin,
 
 	m_plugin->prepareToPlay(samplerate, buffersize);
 
+	/* Listen to parameter changes made from the plug-in side (e.g. its own
+	editor), see getStateVersion(). */
+
+	m_plugin->addListener(this);
+
 	u::log::print("[Plugin] plugin initialized and ready. MIDI input params: {}\n",
 	    midiInParams.size());
 }
@@ -97,6 +106,8 @@ Plugin::~Plugin()
 	if (e != nullptr)
 		e->removeComponentListener(this);
 
+	m_plugin->removeListener(this);
+
 	m_plugin->suspendProcessing(true);
 	m_plugin->releaseResources();
 }
@@ -113,6 +124,18 @@ void Plugin::componentMovedOrResized(juce::Component& c, bool moved, bool /* res
 
 /* -------------------------------------------------------------------------- */
 
+void Plugin::audioProcessorParameterChanged(juce::AudioProcessor*, int, float)
+{
+	m_stateVersion.fetch_add(1);
+}
+
+void Plugin::audioProcessorChanged(juce::AudioProcessor*, const ChangeDetails&)
+{
+	m_stateVersion.fetch_add(1);
+}
+
+/* -------------------------------------------------------------------------- */
+
 juce::AudioProcessor::Bus* Plugin::getMainBus(BusType b) const
 {
 	const bool isInput = static_cast<bool>(b);
@@ -167,6 +190,7 @@ float Plugin::getParameter(int paramIndex) const
 void Plugin::setParameter(int paramIndex, float value) const
 {
 	m_plugin->getParameters()[paramIndex]->setValue(value);
+	m_stateVersion.fetch_add(1);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -196,6 +220,11 @@ bool Plugin::isInstrument() const
 	return m_plugin->acceptsMidi() && m_plugin->getTotalNumInputChannels() == 0;
 }
 
+bool Plugin::acceptsMidi() const
+{
+	return m_acceptsMidi;
+}
+
 /* -------------------------------------------------------------------------- */
 
 PluginState Plugin::getState() const
@@ -210,7 +239,19 @@ PluginState Plugin::getState() const
 /* -------------------------------------------------------------------------- */
 
 bool Plugin::isBypassed() const { return m_bypass.load(); }
-void Plugin::setBypass(bool b) { m_bypass.store(b); }
+
+void Plugin::setBypass(bool b)
+{
+	m_bypass.store(b);
+	m_stateVersion.fetch_add(1);
+}
+
+/* -------------------------------------------------------------------------- */
+
+std::uint32_t Plugin::getStateVersion() const
+{
+	return m_stateVersion.load(std::memory_order_relaxed);
+}
 
 /* -------------------------------------------------------------------------- */
 
@@ -230,6 +271,7 @@ const Plugin::Buffer& Plugin::process(const Plugin::Buffer& out, juce::MidiBuffe
 void Plugin::setState(PluginState state)
 {
 	m_plugin->setStateInformation(state.getData(), state.getSize());
+	m_stateVersion.fetch_add(1);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -256,6 +298,7 @@ void Plugin::setCurrentProgram(int index) const
 {
 	if (valid)
 		m_plugin->setCurrentProgram(index);
+	m_stateVersion.fetch_add(1);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -28,17 +28,20 @@
 #define G_PLUGIN_H
 
 #include "core/const.h"
+#include "core/cpuMeter.h"
 #include "core/midiLearnParam.h"
 #include "core/plugins/pluginHost.h"
 #include "core/plugins/pluginState.h"
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_gui_basics/juce_gui_basics.h>
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <vector>
 
 namespace giada::m
 {
-class Plugin : private juce::ComponentListener
+class Plugin : private juce::ComponentListener, private juce::AudioProcessorListener
 {
 public:
 	using Buffer = juce::AudioBuffer<float>;
@@ -75,6 +78,7 @@ public:
 	bool                        isSuspended() const;
 	bool                        isBypassed() const;
 	bool                        isInstrument() const;
+	bool                        acceptsMidi() const;
 	int                         getNumPrograms() const;
 	int                         getCurrentProgram() const;
 	std::string                 getProgramName(int index) const;
@@ -88,6 +92,13 @@ public:
 
 	int countMainOutChannels() const;
 
+	/* getStateVersion
+	Returns a counter that changes whenever the plug-in state changes:
+	parameters (also when edited from the plug-in's own editor), programs, bypass
+	or the whole state. Thread-safe. */
+
+	std::uint32_t getStateVersion() const;
+
 	/* process
 	Process the plug-in with audio and MIDI data. The audio buffer is a 
 	reference, while the MIDI buffer must be passed by copy: each plug-in must 
@@ -116,6 +127,11 @@ public:
 
 	bool valid;
 
+	/* cpuMeter
+	Time spent processing each audio block. */
+
+	CpuMeter cpuMeter;
+
 	std::function<void(int w, int h)> onEditorResize;
 
 private:
@@ -134,6 +150,8 @@ private:
 	/* JUCE overrides. */
 
 	void componentMovedOrResized(juce::Component& c, bool moved, bool resized) override;
+	void audioProcessorParameterChanged(juce::AudioProcessor*, int index, float value) override;
+	void audioProcessorChanged(juce::AudioProcessor*, const ChangeDetails&) override;
 
 	juce::AudioProcessor::Bus* getMainBus(BusType b) const;
 
@@ -143,6 +161,11 @@ private:
 
 	std::atomic<bool> m_bypass;
 
+	/* m_stateVersion
+	See getStateVersion(). Mutable: bumped by const setters too. */
+
+	mutable std::atomic<std::uint32_t> m_stateVersion;
+
 	/* UID
 	The original UID, used for missing plugins. */
 
@@ -153,6 +176,11 @@ private:
 	take ages to query it, better fetch the property during construction. */
 
 	bool m_hasEditor;
+
+	/* m_acceptsMidi
+	Cached boolean value, queried by the audio thread on each block. */
+
+	bool m_acceptsMidi;
 };
 } // namespace giada::m
 
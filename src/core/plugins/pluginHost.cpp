@@ -30,6 +30,7 @@
 #include "core/model/model.h"
 #include "core/plugins/plugin.h"
 #include "core/plugins/pluginManager.h"
+#include "core/renderPool.h"
 #include "deps/mcl-audio-buffer/src/audioBuffer.hpp"
 #include "utils/log.h"
 #include "utils/vector.h"
@@ -87,7 +88,8 @@ void PluginHost::reset(int bufferSize)
 
 void PluginHost::setBufferSize(int bufferSize)
 {
-	m_audioBuffer.setSize(G_MAX_IO_CHANS, bufferSize);
+	for (juce::AudioBuffer<float>& buffer : m_audioBuffers)
+		buffer.setSize(G_MAX_IO_CHANS, bufferSize);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -95,19 +97,26 @@ void PluginHost::setBufferSize(int bufferSize)
 void PluginHost::processStack(mcl::AudioBuffer& outBuf, const std::vector<Plugin*>& plugins,
     juce::MidiBuffer* events)
 {
-	assert(outBuf.countFrames() == m_audioBuffer.getNumSamples());
+	/* Each render thread works on its own JUCE buffer: this function can be 
+	called concurrently by the RenderPool on different channels. */
 
-	giadaToJuceTempBuf(outBuf);
+	assert(RenderPool::getThreadIndex() < static_cast<int>(m_audioBuffers.size()));
+
+	juce::AudioBuffer<float>& juceBuf = m_audioBuffers[RenderPool::getThreadIndex()];
+
+	assert(outBuf.countFrames() == juceBuf.getNumSamples());
+
+	giadaToJuceTempBuf(outBuf, juceBuf);
 
 	if (events == nullptr)
 	{
 		juce::MidiBuffer dummyEvents; // empty
-		processPlugins(plugins, dummyEvents);
+		processPlugins(plugins, dummyEvents, juceBuf);
 	}
 	else
-		processPlugins(plugins, *events);
+		processPlugins(plugins, *events, juceBuf);
 
-	juceToGiadaOutBuf(outBuf);
+	juceToGiadaOutBuf(juceBuf, outBuf);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -170,56 +179,61 @@ void PluginHost::toggleBypass(ID pluginId)
 
 /* -------------------------------------------------------------------------- */
 
-void PluginHost::giadaToJuceTempBuf(const mcl::AudioBuffer& outBuf)
+void PluginHost::giadaToJuceTempBuf(const mcl::AudioBuffer& outBuf, juce::AudioBuffer<float>& juceBuf) const
 {
-	assert(outBuf.countChannels() == m_audioBuffer.getNumChannels());
+	assert(outBuf.countChannels() == juceBuf.getNumChannels());
 
 	using namespace juce;
 	using Format = AudioData::Format<AudioData::Float32, AudioData::BigEndian>;
 
 	AudioData::deinterleaveSamples(
 	    AudioData::InterleavedSource<Format>{outBuf[0], outBuf.countChannels()},
-	    AudioData::NonInterleavedDest<Format>{m_audioBuffer.getArrayOfWritePointers(), m_audioBuffer.getNumChannels()},
+	    AudioData::NonInterleavedDest<Format>{juceBuf.getArrayOfWritePointers(), juceBuf.getNumChannels()},
 	    outBuf.countFrames());
 }
 
-void PluginHost::juceToGiadaOutBuf(mcl::AudioBuffer& outBuf) const
+void PluginHost::juceToGiadaOutBuf(const juce::AudioBuffer<float>& juceBuf, mcl::AudioBuffer& outBuf) const
 {
-	assert(outBuf.countChannels() == m_audioBuffer.getNumChannels());
+	assert(outBuf.countChannels() == juceBuf.getNumChannels());
 
 	using namespace juce;
 	using Format = AudioData::Format<AudioData::Float32, AudioData::BigEndian>;
 
 	AudioData::interleaveSamples(
-	    AudioData::NonInterleavedSource<Format>{m_audioBuffer.getArrayOfReadPointers(), m_audioBuffer.getNumChannels()},
+	    AudioData::NonInterleavedSource<Format>{juceBuf.getArrayOfReadPointers(), juceBuf.getNumChannels()},
 	    AudioData::InterleavedDest<Format>{outBuf[0], outBuf.countChannels()},
 	    outBuf.countFrames());
 }
 
 /* -------------------------------------------------------------------------- */
 
-void PluginHost::processPlugins(const std::vector<Plugin*>& plugins, juce::MidiBuffer& events)
+void PluginHost::processPlugins(const std::vector<Plugin*>& plugins, juce::MidiBuffer& events,
+    juce::AudioBuffer<float>& juceBuf) const
 {
 	for (Plugin* p : plugins)
 	{
 		if (!p->valid || p->isSuspended() || p->isBypassed())
 			continue;
-		processPlugin(p, events);
+		processPlugin(p, events, juceBuf);
 	}
 	events.clear();
 }
 
 /* -------------------------------------------------------------------------- */
 
-void PluginHost::processPlugin(Plugin* p, const juce::MidiBuffer& events)
+void PluginHost::processPlugin(Plugin* p, const juce::MidiBuffer& events,
+    juce::AudioBuffer<float>& juceBuf) const
 {
-	const Plugin::Buffer& pluginBuffer = p->process(m_audioBuffer, events);
-	const bool            isInstrument = p->isInstrument();
+	const CpuMeter::Clock::time_point start        = CpuMeter::Clock::now();
+	const Plugin::Buffer&             pluginBuffer = p->process(juceBuf, events);
+	const bool                        isInstrument = p->isInstrument();
+
+	p->cpuMeter.record(CpuMeter::Clock::now() - start);
 
 	/* Merge the plugin buffer back into the local one. Special care is needed
 	if audio channels mismatch. */
 
-	for (int i = 0, j = 0; i < m_audioBuffer.getNumChannels(); i++)
+	for (int i = 0, j = 0; i < juceBuf.getNumChannels(); i++)
 	{
 		/* If instrument (i.e. a plug-in that accepts MIDI and produces audio 
 		out of it), SUM the local working buffer to the main one. This allows
@@ -228,9 +242,9 @@ void PluginHost::processPlugin(Plugin* p, const juce::MidiBuffer& events)
 		working buffer is simply copied over the main one. */
 
 		if (isInstrument)
-			m_audioBuffer.addFrom(i, 0, pluginBuffer, j, 0, pluginBuffer.getNumSamples());
+			juceBuf.addFrom(i, 0, pluginBuffer, j, 0, pluginBuffer.getNumSamples());
 		else
-			m_audioBuffer.copyFrom(i, 0, pluginBuffer, j, 0, pluginBuffer.getNumSamples());
+			juceBuf.copyFrom(i, 0, pluginBuffer, j, 0, pluginBuffer.getNumSamples());
 		if (i < p->countMainOutChannels() - 1)
 			j++;
 	}
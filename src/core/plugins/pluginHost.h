@@ -27,7 +27,9 @@
 #ifndef G_PLUGIN_HOST_H
 #define G_PLUGIN_HOST_H
 
+#include "core/const.h"
 #include "core/types.h"
+#include <array>
 #include <functional>
 #include <juce_audio_basics/juce_audio_basics.h>
 #include <juce_gui_basics/juce_gui_basics.h>
@@ -118,23 +120,27 @@ public:
 
 private:
 	/* giadaToJuceTempBuf
-	Copies the Giada buffer 'outBuf' to the private JUCE buffer for local
-	processing. */
+	Copies the Giada buffer 'outBuf' to the private JUCE buffer 'juceBuf' for 
+	local processing. */
 
-	void giadaToJuceTempBuf(const mcl::AudioBuffer& outBuf);
+	void giadaToJuceTempBuf(const mcl::AudioBuffer& outBuf, juce::AudioBuffer<float>& juceBuf) const;
 
 	/* juceToGiadaOutBuf
-	Copies the private JUCE buffer to Giada buffer 'outBuf'. */
+	Copies the private JUCE buffer 'juceBuf' to Giada buffer 'outBuf'. */
 
-	void juceToGiadaOutBuf(mcl::AudioBuffer& outBuf) const;
+	void juceToGiadaOutBuf(const juce::AudioBuffer<float>& juceBuf, mcl::AudioBuffer& outBuf) const;
 
-	void processPlugins(const std::vector<Plugin*>&, juce::MidiBuffer& events);
+	void processPlugins(const std::vector<Plugin*>&, juce::MidiBuffer& events, juce::AudioBuffer<float>& juceBuf) const;
 
-	void processPlugin(Plugin*, const juce::MidiBuffer& events);
+	void processPlugin(Plugin*, const juce::MidiBuffer& events, juce::AudioBuffer<float>& juceBuf) const;
 
 	model::Model& m_model;
 
-	juce::AudioBuffer<float> m_audioBuffer;
+	/* m_audioBuffers
+	Private JUCE working buffers, one for each render thread (see RenderPool),
+	so that multiple channels can process their plug-in stacks in parallel. */
+
+	std::array<juce::AudioBuffer<float>, G_MAX_RENDER_THREADS + 1> m_audioBuffers;
 };
 } // namespace giada::m
 
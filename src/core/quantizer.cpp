@@ -31,16 +31,19 @@ namespace giada::m
 {
 void Quantizer::trigger(int id)
 {
-	assert(m_callbacks.count(id) > 0); // Make sure id exists
+	assert(id >= 0 && id < G_MAX_QUANTIZER_SLOTS);
+	assert(m_slots[id].callback != nullptr); // Make sure id exists
 
 	m_performId.store(id);
 }
 
 /* -------------------------------------------------------------------------- */
 
-void Quantizer::schedule(int id, std::function<void(Frame delta)> f)
+void Quantizer::schedule(int id, void* ctx, Callback f)
 {
-	m_callbacks[id] = f;
+	assert(id >= 0 && id < G_MAX_QUANTIZER_SLOTS);
+
+	m_slots[id] = {f, ctx};
 }
 
 /* -------------------------------------------------------------------------- */
@@ -54,18 +57,19 @@ void Quantizer::advance(Range<Frame> block, Frame quantizerStep) const
 	if (pid == -1)
 		return;
 
-	assert(m_callbacks.count(pid) > 0);
+	assert(m_slots[pid].callback != nullptr);
 
-	for (Frame global = block.getBegin(), local = 0; global < block.getEnd(); global++, local++)
-	{
+	/* Find the first quantization unit within the block, if any. */
 
-		if (global % quantizerStep != 0) // Skip if it's not on a quantization unit.
-			continue;
+	const Frame begin  = block.getBegin();
+	const Frame global = ((begin + quantizerStep - 1) / quantizerStep) * quantizerStep;
 
-		m_callbacks.at(pid)(local);
-		m_performId.store(-1);
+	if (global >= block.getEnd())
 		return;
-	}
+
+	const Slot& slot = m_slots[pid];
+	slot.callback(slot.ctx, global - begin);
+	m_performId.store(-1);
 }
 
 /* -------------------------------------------------------------------------- */
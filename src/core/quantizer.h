@@ -31,19 +31,25 @@
 #include "core/range.h"
 #include "core/types.h"
 #include "core/weakAtomic.h"
-#include <functional>
-#include <map>
+#include <array>
 
 namespace giada::m
 {
 class Quantizer
 {
 public:
+	/* Callback
+	Function called when a quantized operation is performed. Takes the context
+	pointer passed to schedule() and a 'delta' parameter for the buffer offset. 
+	Plain function pointer, so that captureless lambdas can be used. */
+
+	using Callback = void (*)(void* ctx, Frame delta);
+
 	/* schedule
-	Schedules a function in slot 'id' to be called at the right time. The 
-	function has a 'delta' parameter for the buffer offset. */
+	Schedules a function in slot 'id' to be called at the right time. Slot must
+	be in range [0, G_MAX_QUANTIZER_SLOTS). */
 
-	void schedule(int id, std::function<void(Frame)>);
+	void schedule(int id, void* ctx, Callback);
 
 	/* trigger
 	Triggers the function in slot 'id'. Might start right away, or at the end 
@@ -69,8 +75,14 @@ public:
 	bool hasBeenTriggered() const;
 
 private:
-	std::map<int, std::function<void(Frame)>> m_callbacks;
-	mutable WeakAtomic<int>                   m_performId = -1;
+	struct Slot
+	{
+		Callback callback = nullptr;
+		void*    ctx      = nullptr;
+	};
+
+	std::array<Slot, G_MAX_QUANTIZER_SLOTS> m_slots;
+	mutable WeakAtomic<int>                 m_performId = -1;
 };
 } // namespace giada::m
 
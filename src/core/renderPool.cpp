@@ -0,0 +1,303 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2023 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#include "core/renderPool.h"
+#include "core/const.h"
+#include "utils/log.h"
+#include <algorithm>
+#include <cassert>
+#ifdef G_OS_WINDOWS
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace giada::m
+{
+namespace
+{
+thread_local int threadIndex_ = 0;
+
+/* -------------------------------------------------------------------------- */
+
+constexpr std::uint32_t getGeneration_(std::uint64_t state) { return static_cast<std::uint32_t>(state >> 32); }
+constexpr std::uint32_t getIndex_(std::uint64_t state) { return static_cast<std::uint32_t>(state); }
+constexpr std::uint64_t makeState_(std::uint32_t generation) { return static_cast<std::uint64_t>(generation) << 32; }
+
+/* -------------------------------------------------------------------------- */
+
+/* getPriority_
+Returns the real-time priority of the calling thread, or 0 if it doesn't run in
+real-time mode. */
+
+int getPriority_()
+{
+#ifdef G_OS_WINDOWS
+	const int priority = GetThreadPriority(GetCurrentThread());
+	return priority == THREAD_PRIORITY_TIME_CRITICAL ? priority : 0;
+#else
+	int         policy;
+	sched_param param{};
+	if (pthread_getschedparam(pthread_self(), &policy, &param) != 0)
+		return 0;
+	return policy == SCHED_RR || policy == SCHED_FIFO ? param.sched_priority : 0;
+#endif
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* setPriorityBelow_
+Gives the calling thread a real-time priority just below 'priority', i.e. the
+one of the audio thread (see getPriority_()). Workers must not preempt the audio
+thread, but they still have to run ahead of everything else: the audio thread
+may be waiting for their jobs. */
+
+bool setPriorityBelow_(int priority)
+{
+	if (priority == 0)
+		return true;
+#ifdef G_OS_WINDOWS
+	return SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_HIGHEST) != 0;
+#else
+	sched_param param{};
+	param.sched_priority = std::clamp(priority - 1, sched_get_priority_min(SCHED_RR), sched_get_priority_max(SCHED_RR));
+	return pthread_setschedparam(pthread_self(), SCHED_RR, &param) == 0;
+#endif
+}
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+RenderPool::RenderPool()
+: m_spinTime(0)
+, m_running(false)
+, m_priority(UNKNOWN_PRIORITY)
+, m_sleeping(0)
+, m_state(0)
+{
+}
+
+/* -------------------------------------------------------------------------- */
+
+RenderPool::~RenderPool()
+{
+	stop();
+}
+
+/* -------------------------------------------------------------------------- */
+
+int RenderPool::getThreadIndex()
+{
+	return threadIndex_;
+}
+
+/* -------------------------------------------------------------------------- */
+
+int RenderPool::countWorkers() const
+{
+	return static_cast<int>(m_threads.size());
+}
+
+/* -------------------------------------------------------------------------- */
+
+void RenderPool::start(int numWorkers, std::chrono::nanoseconds spinTime)
+{
+	stop();
+
+	/* Workers start from the current generation, read here and not in the
+	thread itself: a batch (or the stop signal) published before a worker gets
+	scheduled for the first time must not be missed. */
+
+	const std::uint32_t generation = getGeneration_(m_state.load());
+
+	m_spinTime = spinTime;
+	m_priority.store(UNKNOWN_PRIORITY);
+	m_running.store(true);
+	for (int i = 0; i < numWorkers; i++)
+		m_threads.emplace_back([this, i, generation]() { loop(i + 1, generation); });
+
+	u::log::print("[RenderPool::start] {} workers started, spin time {} us\n", numWorkers,
+	    std::chrono::duration_cast<std::chrono::microseconds>(spinTime).count());
+}
+
+/* -------------------------------------------------------------------------- */
+
+void RenderPool::stop()
+{
+	if (m_threads.empty())
+		return;
+
+	/* Publish an empty batch to wake up all sleeping workers. */
+
+	m_running.store(false);
+	m_batches[(getGeneration_(m_state.load()) + 1) & 1].count.store(0);
+	m_state.store(makeState_(getGeneration_(m_state.load()) + 1));
+	m_state.notify_all();
+
+	for (std::thread& t : m_threads)
+		t.join();
+	m_threads.clear();
+
+	u::log::print("[RenderPool::stop] workers stopped\n");
+}
+
+/* -------------------------------------------------------------------------- */
+
+void RenderPool::dispatch(std::size_t count, void* ctx, Job job)
+{
+	if (m_threads.empty() || count < 2)
+	{
+		for (std::size_t i = 0; i < count; i++)
+			job(ctx, i);
+		return;
+	}
+
+	/* The audio thread may run at any priority, depending on the backend: read
+	it once, workers will adjust theirs when they see it (see loop()). */
+
+	if (m_priority.load(std::memory_order_relaxed) == UNKNOWN_PRIORITY)
+		m_priority.store(getPriority_(), std::memory_order_relaxed);
+
+	const std::uint32_t generation = getGeneration_(m_state.load(std::memory_order_relaxed)) + 1;
+	const std::uint64_t state      = makeState_(generation);
+	Batch&              batch      = m_batches[generation & 1];
+
+	batch.ctx.store(ctx, std::memory_order_relaxed);
+	batch.job.store(job, std::memory_order_relaxed);
+	batch.count.store(count, std::memory_order_relaxed);
+	batch.done.store(0, std::memory_order_relaxed);
+
+	/* Wake up sleeping workers, if any: those still spinning will grab the
+	batch on their own. Sequentially consistent operations on both m_state and
+	m_sleeping guarantee that a worker going to sleep either sees the new batch
+	or is seen here (see waitForBatch()). */
+
+	m_state.store(state, std::memory_order_seq_cst);
+	if (m_sleeping.load(std::memory_order_seq_cst) > 0)
+		m_state.notify_all();
+
+	/* Help the workers: every job not claimed yet is taken back and run here,
+	so that a worker slow to wake up can't delay the block. Then wait for the
+	jobs still in progress on other threads, sleeping after a while in case a
+	worker has been preempted on this very core: having a lower priority, it
+	couldn't resume while this thread spins or yields. */
+
+	work(state);
+	for (int spins = 0; batch.done.load(std::memory_order_acquire) < count; spins++)
+		if (spins >= G_RENDER_POOL_SPIN_LIMIT)
+			std::this_thread::sleep_for(std::chrono::microseconds(1));
+}
+
+/* -------------------------------------------------------------------------- */
+
+void RenderPool::work(std::uint64_t state)
+{
+	const std::uint32_t generation = getGeneration_(state);
+	Batch&              batch      = m_batches[generation & 1];
+
+	while (getGeneration_(state) == generation)
+	{
+		const std::size_t index = getIndex_(state);
+		if (index >= batch.count.load(std::memory_order_relaxed))
+			return;
+
+		/* Claim job 'index'. A failed exchange reloads the current state: try
+		again, unless a new batch has been published in the meantime. */
+
+		if (!m_state.compare_exchange_weak(state, state + 1, std::memory_order_acq_rel, std::memory_order_acquire))
+			continue;
+
+		batch.job.load(std::memory_order_relaxed)(batch.ctx.load(std::memory_order_relaxed), index);
+		batch.done.fetch_add(1, std::memory_order_release);
+
+		state = state + 1;
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+std::uint64_t RenderPool::waitForBatch(std::uint32_t generation)
+{
+	using Clock = std::chrono::steady_clock;
+
+	/* Spin first, reading the clock only once in a while. */
+
+	const Clock::time_point deadline = Clock::now() + m_spinTime;
+
+	std::uint64_t state = m_state.load(std::memory_order_acquire);
+	for (int spins = 1; getGeneration_(state) == generation; spins++)
+	{
+		if (spins % 64 == 0 && Clock::now() >= deadline)
+			break;
+		state = m_state.load(std::memory_order_acquire);
+	}
+	if (getGeneration_(state) != generation)
+		return state;
+
+	/* Then sleep. Register as a sleeper before the last check on m_state (see
+	dispatch()). */
+
+	m_sleeping.fetch_add(1, std::memory_order_seq_cst);
+	state = m_state.load(std::memory_order_seq_cst);
+	while (getGeneration_(state) == generation)
+	{
+		m_state.wait(state, std::memory_order_seq_cst);
+		state = m_state.load(std::memory_order_seq_cst);
+	}
+	m_sleeping.fetch_sub(1, std::memory_order_relaxed);
+
+	return state;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void RenderPool::loop(int index, std::uint32_t generation)
+{
+	threadIndex_ = index;
+
+	int priority = UNKNOWN_PRIORITY;
+
+	while (true)
+	{
+		const std::uint64_t state = waitForBatch(generation);
+		if (!m_running.load())
+			return;
+		generation = getGeneration_(state);
+
+		if (priority != m_priority.load(std::memory_order_relaxed))
+		{
+			priority = m_priority.load(std::memory_order_relaxed);
+			if (!setPriorityBelow_(priority))
+				u::log::print("[RenderPool::loop] Unable to set real-time priority on worker {}\n", index);
+		}
+
+		work(state);
+	}
+}
+} // namespace giada::m
@@ -0,0 +1,158 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2023 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#ifndef G_RENDER_POOL_H
+#define G_RENDER_POOL_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace giada::m
+{
+/* RenderPool
+A pool of worker threads that helps the audio thread to process independent 
+jobs (e.g. channels) in parallel. Jobs are dispatched with the run() function,
+which is realtime-safe: it doesn't allocate memory nor acquire locks. Workers
+run with a real-time priority just below the one of the audio thread. */
+
+class RenderPool
+{
+public:
+	RenderPool();
+	RenderPool(const RenderPool&) = delete;
+	RenderPool(RenderPool&&)      = delete;
+	RenderPool& operator=(const RenderPool&) = delete;
+	RenderPool& operator=(RenderPool&&) = delete;
+	~RenderPool();
+
+	/* getThreadIndex
+	Returns the index of the calling thread: 0 for the thread that calls run()
+	(i.e. the audio thread) or any other non-worker thread, [1, countWorkers()] 
+	for worker threads. Useful to pick per-thread working buffers. */
+
+	static int getThreadIndex();
+
+	/* countWorkers
+	Returns the number of worker threads currently running. */
+
+	int countWorkers() const;
+
+	/* start
+	Spawns 'numWorkers' threads. Any existing worker is stopped first. Must not
+	be called while run() is in progress. After each batch, workers keep polling
+	for the next one for 'spinTime' before going to sleep: if run() is called
+	again within that time, no system call is needed to wake them up. Keep it
+	short, spinning workers take CPU time away from other threads. */
+
+	void start(int numWorkers, std::chrono::nanoseconds spinTime = {});
+
+	/* stop
+	Stops and joins all worker threads. */
+
+	void stop();
+
+	/* run
+	Calls 'job(i)' for each i in [0, count), spreading the calls across worker 
+	threads. The calling thread takes part in the work too, grabbing any job not
+	yet claimed by a worker, and returns only when all jobs have been completed.
+	Falls back to a plain loop if there are no workers. */
+
+	template <typename F>
+	void run(std::size_t count, F& job)
+	{
+		dispatch(count, &job, [](void* ctx, std::size_t i) {
+			(*static_cast<F*>(ctx))(i);
+		});
+	}
+
+private:
+	using Job = void (*)(void* ctx, std::size_t i);
+
+	/* Batch
+	A set of jobs to be processed. Two batches are used in a round-robin 
+	fashion, so that a late worker still looking at the previous batch can't 
+	read data that is being written for the next one. */
+
+	struct Batch
+	{
+		std::atomic<void*>       ctx   = nullptr;
+		std::atomic<Job>         job   = nullptr;
+		std::atomic<std::size_t> count = 0;
+		std::atomic<std::size_t> done  = 0;
+	};
+
+	void dispatch(std::size_t count, void* ctx, Job);
+
+	/* work
+	Grabs and executes jobs from the batch described by 'state' until there are
+	no more left, or a new batch has been published in the meantime. */
+
+	void work(std::uint64_t state);
+
+	/* waitForBatch
+	Blocks until a batch newer than 'generation' is published. Spins for
+	m_spinTime first, then goes to sleep. Returns the new state. */
+
+	std::uint64_t waitForBatch(std::uint32_t generation);
+
+	/* loop
+	Main worker loop: waits until a batch newer than 'generation' is available,
+	then works on it. */
+
+	void loop(int index, std::uint32_t generation);
+
+	static constexpr int UNKNOWN_PRIORITY = -1;
+
+	std::vector<std::thread> m_threads;
+	std::chrono::nanoseconds m_spinTime;
+	std::atomic<bool>        m_running;
+	Batch                    m_batches[2];
+
+	/* m_priority
+	Real-time priority of the thread calling run(), read on the first call
+	after start(). Workers run just below it. */
+
+	std::atomic<int> m_priority;
+
+	/* m_sleeping
+	Number of workers sleeping on m_state. The audio thread issues a (costly)
+	wake-up call only if some worker is actually sleeping. */
+
+	std::atomic<int> m_sleeping;
+
+	/* m_state
+	Generation of the current batch in the upper 32 bits, index of the next job
+	to grab in the lower 32 bits. Workers wait on it for new batches. */
+
+	std::atomic<std::uint64_t> m_state;
+};
+} // namespace giada::m
+
+#endif
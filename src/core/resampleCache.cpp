@@ -0,0 +1,355 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2023 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#include "core/resampleCache.h"
+#include "core/const.h"
+#include "deps/mcl-audio-buffer/src/audioBuffer.hpp"
+#include "utils/fs.h"
+#include "utils/log.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fmt/core.h>
+#include <fstream>
+#include <functional>
+#include <thread>
+#include <vector>
+#ifdef G_OS_WINDOWS
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace stdfs = std::filesystem;
+
+namespace giada::m::resampleCache
+{
+namespace
+{
+constexpr char     MAGIC_[4] = {'G', 'R', 'S', 'C'};
+constexpr uint32_t VERSION_  = 1;
+
+/* Header_
+File header. 32 bytes long, so that audio data that follows stays aligned for
+vector instructions. */
+
+struct Header_
+{
+	char     magic[4];
+	uint32_t version;
+	int32_t  frames;
+	int32_t  channels;
+	uint8_t  padding[16];
+};
+
+static_assert(sizeof(Header_) == 32);
+
+/* Mapping_
+A file mapped in memory. */
+
+struct Mapping_
+{
+	void*       addr = nullptr;
+	std::size_t size = 0;
+};
+
+/* -------------------------------------------------------------------------- */
+
+uint64_t hashFile_(const std::string& path)
+{
+	/* FNV-1a, 64 bit. */
+
+	std::ifstream in(path, std::ios::binary);
+	if (!in)
+		return 0;
+
+	uint64_t          hash = 0xcbf29ce484222325;
+	std::vector<char> chunk(1 << 16);
+	while (in)
+	{
+		in.read(chunk.data(), chunk.size());
+		for (std::streamsize i = 0; i < in.gcount(); i++)
+		{
+			hash ^= static_cast<uint8_t>(chunk[i]);
+			hash *= 0x100000001b3;
+		}
+	}
+	return hash;
+}
+
+/* -------------------------------------------------------------------------- */
+
+Mapping_ map_(const std::string& path)
+{
+#ifdef G_OS_WINDOWS
+
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return {};
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+	{
+		CloseHandle(file);
+		return {};
+	}
+
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+	void*  addr    = mapping != nullptr ? MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0) : nullptr;
+
+	if (mapping != nullptr)
+		CloseHandle(mapping);
+	CloseHandle(file);
+
+	if (addr == nullptr)
+		return {};
+	return {addr, static_cast<std::size_t>(size.QuadPart)};
+
+#else
+
+	const int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd == -1)
+		return {};
+
+	struct stat st;
+	if (::fstat(fd, &st) != 0 || st.st_size == 0)
+	{
+		::close(fd);
+		return {};
+	}
+
+	/* Private mapping: pages are copied on write, the file is never touched.
+	Read the whole file in right away where possible (see also prefault_()). */
+
+#ifdef MAP_POPULATE
+	constexpr int flags = MAP_PRIVATE | MAP_POPULATE;
+#else
+	constexpr int flags = MAP_PRIVATE;
+#endif
+
+	void* addr = ::mmap(nullptr, st.st_size, PROT_READ | PROT_WRITE, flags, fd, 0);
+	::close(fd);
+
+	if (addr == MAP_FAILED)
+		return {};
+	return {addr, static_cast<std::size_t>(st.st_size)};
+
+#endif
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* prefault_
+Writes every page of the mapping in place, so that each one is read from disk
+and gets its private copy now, on the loading thread. The audio thread would
+take the page faults otherwise, the first time it plays or edits the data. */
+
+void prefault_(const Mapping_& m)
+{
+	constexpr std::size_t STRIDE = 4096; // The smallest page size around
+
+	volatile char* bytes = static_cast<char*>(m.addr);
+	for (std::size_t i = 0; i < m.size; i += STRIDE)
+		bytes[i] = bytes[i];
+}
+
+/* -------------------------------------------------------------------------- */
+
+void unmap_(const Mapping_& m)
+{
+#ifdef G_OS_WINDOWS
+	UnmapViewOfFile(m.addr);
+#else
+	::munmap(m.addr, m.size);
+#endif
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool isValid_(const Mapping_& m)
+{
+	if (m.size < sizeof(Header_))
+		return false;
+
+	Header_ header;
+	std::memcpy(&header, m.addr, sizeof(Header_));
+
+	if (std::memcmp(header.magic, MAGIC_, sizeof(MAGIC_)) != 0 || header.version != VERSION_ ||
+	    header.frames <= 0 || header.channels <= 0 || header.channels > G_MAX_IO_CHANS)
+		return false;
+
+	const std::size_t dataSize = static_cast<std::size_t>(header.frames) * header.channels * sizeof(float);
+	return m.size == sizeof(Header_) + dataSize;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* prune_
+Removes the least recently written entries from 'dir' until its size drops
+below 'maxBytes'. */
+
+void prune_(const std::string& dir, uintmax_t maxBytes)
+{
+	struct Entry
+	{
+		stdfs::path           path;
+		uintmax_t             size;
+		stdfs::file_time_type time;
+	};
+
+	std::error_code    ec;
+	std::vector<Entry> entries;
+	uintmax_t          total = 0;
+
+	for (const stdfs::directory_entry& e : stdfs::directory_iterator(dir, ec))
+	{
+		if (!e.is_regular_file(ec))
+			continue;
+		const uintmax_t size = e.file_size(ec);
+		entries.push_back({e.path(), size, e.last_write_time(ec)});
+		total += size;
+	}
+
+	if (total <= maxBytes)
+		return;
+
+	std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.time < b.time; });
+
+	for (const Entry& e : entries)
+	{
+		if (total <= maxBytes)
+			break;
+		if (stdfs::remove(e.path, ec)) // Might fail on Windows if still mapped
+			total -= e.size;
+	}
+}
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+std::string makeKey(const std::string& path, int samplerate, Resampler::Quality quality)
+{
+	if (!u::fs::fileExists(path))
+		return "";
+	return fmt::format("{:016x}-{}-{}.raw", hashFile_(path), samplerate, static_cast<int>(quality));
+}
+
+/* -------------------------------------------------------------------------- */
+
+std::shared_ptr<mcl::AudioBuffer> load(const std::string& dir, const std::string& key)
+{
+	const std::string path = u::fs::join(dir, key);
+
+	const Mapping_ m = map_(path);
+	if (m.addr == nullptr)
+		return nullptr;
+
+	if (!isValid_(m))
+	{
+		u::log::print("[resampleCache::load] invalid cache entry {}\n", path);
+		unmap_(m);
+		return nullptr;
+	}
+
+	prefault_(m);
+
+	Header_ header;
+	std::memcpy(&header, m.addr, sizeof(Header_));
+
+	float* data = reinterpret_cast<float*>(static_cast<char*>(m.addr) + sizeof(Header_));
+
+	u::log::print("[resampleCache::load] cache hit: {}, {} frames\n", key, header.frames);
+
+	/* The buffer just views the mapped memory, which is released together with
+	the buffer. */
+
+	return std::shared_ptr<mcl::AudioBuffer>(
+	    new mcl::AudioBuffer(data, header.frames, header.channels),
+	    [m](mcl::AudioBuffer* b) {
+		    delete b;
+		    unmap_(m);
+	    });
+}
+
+/* -------------------------------------------------------------------------- */
+
+void store(const std::string& dir, const std::string& key, const mcl::AudioBuffer& b)
+{
+	if (b.countFrames() == 0)
+		return;
+
+	std::error_code ec;
+	stdfs::create_directories(dir, ec);
+	if (ec)
+	{
+		u::log::print("[resampleCache::store] unable to create {}: {}\n", dir, ec.message());
+		return;
+	}
+
+	Header_ header{};
+	std::memcpy(header.magic, MAGIC_, sizeof(MAGIC_));
+	header.version  = VERSION_;
+	header.frames   = b.countFrames();
+	header.channels = b.countChannels();
+
+	/* Write into a temporary file first, so that a half-written entry is never
+	picked up. One per thread, as the same sample might be stored by parallel
+	loads. */
+
+	const std::string path = u::fs::join(dir, key);
+	const std::string tmp  = fmt::format("{}.{}.tmp", path, std::hash<std::thread::id>{}(std::this_thread::get_id()));
+
+	std::ofstream out(tmp, std::ios::binary);
+	out.write(reinterpret_cast<const char*>(&header), sizeof(Header_));
+	out.write(reinterpret_cast<const char*>(b[0]), static_cast<std::streamsize>(b.countFrames()) * b.countChannels() * sizeof(float));
+	out.close();
+
+	if (!out)
+	{
+		u::log::print("[resampleCache::store] unable to write {}\n", tmp);
+		stdfs::remove(tmp, ec);
+		return;
+	}
+
+	stdfs::rename(tmp, path, ec);
+	if (ec)
+	{
+		u::log::print("[resampleCache::store] unable to write {}: {}\n", path, ec.message());
+		stdfs::remove(tmp, ec);
+		return;
+	}
+
+	u::log::print("[resampleCache::store] cache entry {} written\n", key);
+
+	prune_(dir, static_cast<uintmax_t>(G_RESAMPLE_CACHE_MAX_MB) * 1024 * 1024);
+}
+} // namespace giada::m::resampleCache
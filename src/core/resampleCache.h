@@ -0,0 +1,69 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2023 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#ifndef G_RESAMPLE_CACHE_H
+#define G_RESAMPLE_CACHE_H
+
+#include "core/resampler.h"
+#include <memory>
+#include <string>
+
+namespace mcl
+{
+class AudioBuffer;
+}
+
+/* resampleCache
+On-disk cache of resampled audio data, so that a sample is converted only once
+for each target sample rate. Entries are raw float files named after the
+content of the source file, the target rate and the resampling quality. They
+are memory-mapped when loaded. */
+
+namespace giada::m::resampleCache
+{
+/* makeKey
+Returns the cache key for file 'path' resampled to 'samplerate' with
+'quality', or an empty string if the file can't be read. Reads the whole
+file. */
+
+std::string makeKey(const std::string& path, int samplerate, Resampler::Quality quality);
+
+/* load
+Maps the entry 'key' from cache folder 'dir' in memory. Returns nullptr if the
+entry doesn't exist or is invalid. The returned buffer can be written: changes
+are private and never reach the file. All pages are faulted in before returning,
+so the buffer can be handed to the audio thread. */
+
+std::shared_ptr<mcl::AudioBuffer> load(const std::string& dir, const std::string& key);
+
+/* store
+Writes 'b' as entry 'key' into cache folder 'dir', then removes the oldest
+entries if the folder grows past G_RESAMPLE_CACHE_MAX_MB. */
+
+void store(const std::string& dir, const std::string& key, const mcl::AudioBuffer& b);
+} // namespace giada::m::resampleCache
+
+#endif
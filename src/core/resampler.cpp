@@ -25,152 +25,356 @@
  * -------------------------------------------------------------------------- */
 
 #include "core/resampler.h"
+#include "core/audioKernels.h"
+#include "core/const.h"
 #include <algorithm>
 #include <cassert>
-#include <new>
-#include <utility>
-
-#include <cstdio>
+#include <cmath>
+#include <iterator>
+#include <numbers>
+#include <vector>
 
 namespace giada::m
 {
-Resampler::Resampler()
-: m_state(nullptr)
-, m_input(nullptr)
-, m_inputPos(0)
-, m_inputLength(0)
-, m_channels(0)
-, m_usedFrames(0)
+/* SincTable
+Polyphase windowed-sinc filter. The fractional position between two input
+frames is split in PHASES phases, each one with its own row of coefficients;
+the coefficients for an arbitrary position are obtained by linear
+interpolation between two adjacent rows. There is one set of PHASES + 1 rows
+for each anti-aliasing band in BANDS: playback rates above 1.0 need a lower
+cutoff frequency, so the rate is rounded up to the closest band. A lower cutoff
+stretches the sinc, so the number of taps grows with the band too (the base
+'taps' value times the band rate, rounded up): this way the window always
+spans the same number of sinc lobes and the anti-aliasing doesn't degrade at
+high rates. Each coefficient is stored twice ([c0 c0 c1 c1 ...]) to match
+interleaved stereo data in the SIMD kernels. */
+
+struct Resampler::SincTable
 {
-}
+	static constexpr int   PHASES    = 256;
+	static constexpr float BANDS[]   = {1.0f, 1.5f, 2.0f, 3.0f, G_MAX_PITCH};
+	static constexpr int   NUM_BANDS = static_cast<int>(std::size(BANDS));
 
+	SincTable(int taps, float cutoff, float beta);
+
+	const float* getRow(int band, int phase) const;
+	int          getBand(float ratio) const;
+
+	int                taps[NUM_BANDS];    // Number of taps, for each band
+	std::size_t        offsets[NUM_BANDS]; // Offset of each band in 'data'
+	std::vector<float> data;
+};
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
 
-Resampler::Resampler(Quality quality, int channels)
-: Resampler()
+namespace
+{
+/* bessel0_
+Zeroth order modified Bessel function of the first kind, used by the Kaiser
+window. */
+
+double bessel0_(double x)
 {
-	alloc(quality, channels);
+	double sum  = 1.0;
+	double term = 1.0;
+	for (int k = 1; k < 32; k++)
+	{
+		term *= (x / (2.0 * k)) * (x / (2.0 * k));
+		sum += term;
+	}
+	return sum;
 }
 
 /* -------------------------------------------------------------------------- */
 
-Resampler::Resampler(const Resampler& o)
-: Resampler()
+/* fetch_
+Returns sample on 'channel' at frame 'index', or 0.0 if out of range. */
+
+float fetch_(const float* input, long index, long length, int channels, int channel)
 {
-	*this = o;
+	return index >= 0 && index < length ? input[index * channels + channel] : 0.0f;
 }
 
 /* -------------------------------------------------------------------------- */
 
-/* This is a fake move constructor that makes a copy instead. The SRC_STATE
-object has a callback that, if moved, would still point to the original object.
-TODO: maybe delete the move constructor? */
+/* run_
+Main resampling loop. Calls 'interpolate' for each output frame, given the
+input frame index and the fractional position, until the output is full or
+the input is over. 'interpolate' fills the first 'inputChannels' channels of
+the output frame: the remaining ones, if any, get a copy of the first (mono
+to multichannel spread). Returns the number of generated frames. */
 
-Resampler::Resampler(Resampler&& o)
-: Resampler()
+template <typename F>
+long run_(double& position, long inputPos, long inputLength, int inputChannels,
+    float* output, long outputLength, float ratio, int channels, F interpolate)
 {
-	*this = o;
+	long generated = 0;
+	for (; generated < outputLength; generated++)
+	{
+		const long offset = static_cast<long>(position);
+		const long index  = inputPos + offset;
+		if (index >= inputLength)
+			break;
+		float* out = output + generated * channels;
+		interpolate(index, static_cast<float>(position - offset), out);
+		for (int c = inputChannels; c < channels; c++)
+			out[c] = out[0];
+		position += ratio;
+	}
+	return generated;
 }
+} // namespace
 
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
 
-Resampler& Resampler::operator=(const Resampler& o)
+Resampler::SincTable::SincTable(int baseTaps, float cutoff, float beta)
 {
-	if (this == &o)
-		return *this;
-	alloc(o.m_quality, o.m_channels);
-	return *this;
+	const int    rows   = PHASES + 1;
+	const double window = bessel0_(beta);
+
+	std::size_t size = 0;
+	for (int band = 0; band < NUM_BANDS; band++)
+	{
+		taps[band]    = baseTaps * static_cast<int>(std::ceil(BANDS[band]));
+		offsets[band] = size;
+		size += rows * taps[band] * 2;
+	}
+	data.resize(size);
+
+	for (int band = 0; band < NUM_BANDS; band++)
+	{
+		const int    numTaps = taps[band];
+		const int    half    = numTaps / 2;
+		const double fc      = cutoff / BANDS[band];
+
+		for (int phase = 0; phase < rows; phase++)
+		{
+			const double frac = phase / static_cast<double>(PHASES);
+			float*       row  = data.data() + offsets[band] + phase * numTaps * 2;
+			double       sum  = 0.0;
+
+			/* Tap 'i' is applied to input frame 'index - half + 1 + i', whose
+			distance from the current (fractional) position is 'x'. */
+
+			for (int i = 0; i < numTaps; i++)
+			{
+				const double x    = (i - half + 1) - frac;
+				const double r    = x / half;
+				const double w    = std::abs(r) <= 1.0 ? bessel0_(beta * std::sqrt(1.0 - r * r)) / window : 0.0;
+				const double sinc = x == 0.0 ? 1.0 : std::sin(std::numbers::pi * fc * x) / (std::numbers::pi * fc * x);
+				const double h    = fc * sinc * w;
+
+				row[i * 2]     = static_cast<float>(h);
+				row[i * 2 + 1] = static_cast<float>(h);
+				sum += h;
+			}
+
+			/* Normalize for unity gain at DC, so that the level doesn't wobble
+			with the fractional position. */
+
+			for (int i = 0; i < numTaps * 2; i++)
+				row[i] = static_cast<float>(row[i] / sum);
+		}
+	}
 }
 
 /* -------------------------------------------------------------------------- */
 
-/* This is a fake move operator: see notes above. */
-
-Resampler& Resampler::operator=(Resampler&& o)
+const float* Resampler::SincTable::getRow(int band, int phase) const
 {
-	if (this == &o)
-		return *this;
-	alloc(o.m_quality, o.m_channels);
-	return *this;
+	return data.data() + offsets[band] + phase * taps[band] * 2;
 }
 
 /* -------------------------------------------------------------------------- */
 
-Resampler::~Resampler()
+int Resampler::SincTable::getBand(float ratio) const
 {
-	src_delete(m_state);
+	for (int i = 0; i < NUM_BANDS; i++)
+		if (ratio <= BANDS[i])
+			return i;
+	return NUM_BANDS - 1;
 }
 
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
 
-long Resampler::callback(void* self, float** audio)
+Resampler::Resampler()
+: m_quality(Quality::LINEAR)
+, m_channels(0)
+, m_position(0.0)
+, m_sinc(nullptr)
 {
-	return static_cast<Resampler*>(self)->callback(audio);
 }
 
 /* -------------------------------------------------------------------------- */
 
-long Resampler::callback(float** audio)
+Resampler::Resampler(Quality quality, int channels)
+: m_quality(quality)
+, m_channels(channels)
+, m_position(0.0)
+, m_sinc(getSincTable(quality))
 {
-	assert(audio != nullptr);
-
-	/* Move pointer properly, taking into account read data and number of 
-	channels in input data. */
-
-	*audio = m_input + (m_inputPos * m_channels);
-
-	/* Returns how many frames have been read in this callback shot. */
-
-	long frames;
-
-	/* Read in CHUNK_LEN parts, checking if there is enough data left. */
-
-	if (m_inputPos + CHUNK_LEN < m_inputLength)
-		frames = CHUNK_LEN;
-	else
-		frames = m_inputLength - m_inputPos;
-
-	m_usedFrames += frames;
-	m_inputPos += frames;
-
-	return frames;
 }
 
 /* -------------------------------------------------------------------------- */
 
-void Resampler::alloc(Quality quality, int channels)
+const Resampler::SincTable* Resampler::getSincTable(Quality quality)
 {
-	if (m_state != nullptr)
-		src_delete(m_state);
-	m_state    = src_callback_new(callback, static_cast<int>(quality), channels, nullptr, this);
-	m_quality  = quality;
-	m_channels = channels;
-	if (m_state == nullptr)
-		throw std::bad_alloc();
-	src_reset(m_state);
+	/* Tables are built once, on first use. Static local initialization is
+	thread-safe. */
+
+	switch (quality)
+	{
+	case Quality::SINC_FASTEST:
+	{
+		static const SincTable table(/*taps=*/8, /*cutoff=*/0.85f, /*beta=*/6.0f);
+		return &table;
+	}
+	case Quality::SINC_MEDIUM:
+	{
+		static const SincTable table(/*taps=*/16, /*cutoff=*/0.90f, /*beta=*/7.5f);
+		return &table;
+	}
+	case Quality::SINC_BEST:
+	{
+		static const SincTable table(/*taps=*/SINC_BEST_TAPS, /*cutoff=*/0.95f, /*beta=*/9.0f);
+		return &table;
+	}
+	default:
+		return nullptr;
+	}
 }
 
 /* -------------------------------------------------------------------------- */
 
 Resampler::Result Resampler::process(float* input, long inputPos, long inputLength,
-    float* output, long outputLength, float ratio)
+    int inputChannels, float* output, long outputLength, float ratio)
 {
-	assert(m_state != nullptr); // Must be initialized first!
-
-	m_input       = input;
-	m_inputPos    = inputPos;
-	m_inputLength = inputLength;
-	m_usedFrames  = 0;
-
-	long generated = src_callback_read(m_state, 1 / ratio, outputLength, output);
-
-	return {m_usedFrames, generated};
+	assert(m_channels > 0); // Must be initialized first!
+	assert(inputChannels == 1 || inputChannels == m_channels);
+	assert(ratio > 0.0f);
+
+	const int channels  = m_channels;
+	long      generated = 0;
+
+	switch (m_quality)
+	{
+	case Quality::ZERO_ORDER_HOLD:
+	{
+		generated = run_(m_position, inputPos, inputLength, inputChannels, output, outputLength, ratio, channels,
+		    [=](long index, float, float* out) {
+			    for (int c = 0; c < inputChannels; c++)
+				    out[c] = input[index * inputChannels + c];
+		    });
+		break;
+	}
+
+	case Quality::LINEAR:
+	{
+		generated = run_(m_position, inputPos, inputLength, inputChannels, output, outputLength, ratio, channels,
+		    [=](long index, float frac, float* out) {
+			    for (int c = 0; c < inputChannels; c++)
+			    {
+				    const float x0 = input[index * inputChannels + c];
+				    const float x1 = fetch_(input, index + 1, inputLength, inputChannels, c);
+				    out[c]         = x0 + (x1 - x0) * frac;
+			    }
+		    });
+		break;
+	}
+
+	case Quality::CUBIC:
+	{
+		/* 4-point, 3rd-order Hermite (Catmull-Rom spline). */
+
+		generated = run_(m_position, inputPos, inputLength, inputChannels, output, outputLength, ratio, channels,
+		    [=](long index, float frac, float* out) {
+			    for (int c = 0; c < inputChannels; c++)
+			    {
+				    const float xm1 = fetch_(input, index - 1, inputLength, inputChannels, c);
+				    const float x0  = input[index * inputChannels + c];
+				    const float x1  = fetch_(input, index + 1, inputLength, inputChannels, c);
+				    const float x2  = fetch_(input, index + 2, inputLength, inputChannels, c);
+				    const float c1  = 0.5f * (x1 - xm1);
+				    const float c2  = xm1 - 2.5f * x0 + 2.0f * x1 - 0.5f * x2;
+				    const float c3  = 0.5f * (x2 - xm1) + 1.5f * (x0 - x1);
+				    out[c]          = ((c3 * frac + c2) * frac + c1) * frac + x0;
+			    }
+		    });
+		break;
+	}
+
+	default: // SINC_*
+	{
+		assert(m_sinc != nullptr);
+
+		const SincTable& sinc = *m_sinc;
+		const int        band = sinc.getBand(ratio);
+		const int        taps = sinc.taps[band];
+		const int        half = taps / 2;
+
+		assert(half <= maxHalfTaps());
+
+		generated = run_(m_position, inputPos, inputLength, inputChannels, output, outputLength, ratio, channels,
+		    [=, &sinc](long index, float frac, float* out) {
+			    /* A fractional position just below 1.0 can be rounded up to 1.0
+			    when converted to float: clamp the row, so that 'row + 1' stays
+			    within the table (t = 1.0 then picks the last row). */
+
+			    const float  phase = frac * SincTable::PHASES;
+			    const int    row   = std::min(static_cast<int>(phase), SincTable::PHASES - 1);
+			    const float  t     = phase - row;
+			    const float* rowA  = sinc.getRow(band, row);
+			    const float* rowB  = sinc.getRow(band, row + 1);
+			    const long   first = index - half + 1;
+
+			    /* Fast path: stereo or mono data, all taps within the input range.
+			    Mono goes into out[0] only, run_ spreads it. */
+
+			    if (first >= 0 && first + taps <= inputLength)
+			    {
+				    if (inputChannels == G_MAX_IO_CHANS && channels == G_MAX_IO_CHANS)
+				    {
+					    kernels::interpolate(input + first * channels, rowA, rowB, t, taps, out);
+					    return;
+				    }
+				    if (inputChannels == 1)
+				    {
+					    kernels::interpolateMono(input + first, rowA, rowB, t, taps, out);
+					    return;
+				    }
+			    }
+
+			    for (int c = 0; c < inputChannels; c++)
+			    {
+				    float sum = 0.0f;
+				    for (int i = 0; i < taps; i++)
+					    sum += fetch_(input, first + i, inputLength, inputChannels, c) * (rowA[i * 2] + (rowB[i * 2] - rowA[i * 2]) * t);
+				    out[c] = sum;
+			    }
+		    });
+		break;
+	}
+	}
+
+	/* Advance by the whole input frames consumed, keep the fractional part for
+	the next call. */
+
+	const long consumed = static_cast<long>(m_position);
+	m_position -= consumed;
+
+	return {std::min(consumed, std::max(0L, inputLength - inputPos)), generated};
 }
 
 /* -------------------------------------------------------------------------- */
 
 void Resampler::last()
 {
-	src_reset(m_state);
+	m_position = 0.0;
 }
 } // namespace giada::m
@@ -27,21 +27,37 @@
 #ifndef G_RESAMPLER_H
 #define G_RESAMPLER_H
 
+#include "core/const.h"
 #include <cstddef>
-#include <samplerate.h>
 
 namespace giada::m
 {
+/* Resampler
+Real-time safe resampler for sample playback at variable rate (i.e. pitch). It
+reads directly from the input buffer, with no callbacks, and its only state is
+the fractional read position: no memory is allocated while processing. Sinc
+tables are precomputed once per quality and shared among all instances. */
+
 class Resampler final
 {
 public:
+	/* Quality
+	ZERO_ORDER_HOLD - nearest frame, no interpolation;
+	LINEAR          - 2-point linear interpolation;
+	CUBIC           - 4-point cubic Hermite interpolation;
+	SINC_*          - windowed-sinc polyphase filter, 8 (FASTEST), 16 (MEDIUM)
+	                  or 32 (BEST) taps at normal rate. The filter gets
+	                  longer at higher rates, see resampler.cpp.
+	Values are stored in the configuration file: don't change them. */
+
 	enum class Quality
 	{
 		SINC_BEST       = 0,
 		SINC_MEDIUM     = 1,
 		SINC_FASTEST    = 2,
 		ZERO_ORDER_HOLD = 3,
-		LINEAR          = 4
+		LINEAR          = 4,
+		CUBIC           = 5
 	};
 
 	/* Result
@@ -55,43 +71,58 @@ public:
 
 	Resampler(); // Invalid
 	Resampler(Quality quality, int channels);
-	Resampler(const Resampler& o);
-	Resampler(Resampler&&);
-	Resampler& operator=(const Resampler&);
-	Resampler& operator=(Resampler&&);
-	~Resampler();
 
 	/* process
 	Resamples a certain amount of frames from 'input' starting at 'inputPos' and
-	puts the result into 'output'. */
+	puts the result into 'output'. 'ratio' is the number of input frames read
+	for each output frame, i.e. the playback rate. Frames outside the range
+	[0, inputLength) are considered silent. 'input' has 'inputChannels'
+	channels: either the same number of the output, or 1 (mono) which is then
+	spread over all output channels. */
 
-	Result process(float* input, long inputPos, long inputLength, float* output,
-	    long outputLength, float ratio);
+	Result process(float* input, long inputPos, long inputLength, int inputChannels,
+	    float* output, long outputLength, float ratio);
 
 	/* last
-	Call this when you are about to process the last chunk of data. */
+	Call this when you are about to process the last chunk of data. Resets the
+	fractional read position. */
 
 	void last();
 
+	/* maxHalfTaps
+	Maximum number of input frames read on each side of the current position,
+	for any quality and ratio up to G_MAX_PITCH. A window cut out of a longer
+	input must be padded by this amount on both sides, or the filter sees
+	silence past its edges. */
+
+	static constexpr int maxHalfTaps()
+	{
+		const int maxRate = static_cast<int>(G_MAX_PITCH) + (G_MAX_PITCH > static_cast<int>(G_MAX_PITCH) ? 1 : 0);
+		return SINC_BEST_TAPS * maxRate / 2;
+	}
+
 private:
-	static long callback(void* self, float** audio);
-	long        callback(float** audio);
+	/* SINC_BEST_TAPS
+	Base number of taps of the longest filter (SINC_BEST), see SincTable. */
+
+	static constexpr int SINC_BEST_TAPS = 32;
+
+	/* SincTable
+	Precomputed polyphase windowed-sinc filter. See resampler.cpp. */
 
-	void alloc(Quality quality, int channels);
+	struct SincTable;
 
-	/* CHUNK_LEN
-	How many chunks of data to read from input in the callback. */
+	/* getSincTable
+	Returns the shared table for the given quality, building it on first use.
+	Returns nullptr if the quality is not sinc-based. */
 
-	static constexpr int CHUNK_LEN = 256;
+	static const SincTable* getSincTable(Quality);
 
-	SRC_STATE* m_state;
-	Quality    m_quality;
-	float*     m_input;       // Pointer to input data
-	long       m_inputPos;    // Where to read from input
-	long       m_inputLength; // Total number of frames in input data
-	int        m_channels;    // Number of channels
-	long       m_usedFrames;  // How many frames have been read from input with a process() call
+	Quality          m_quality;
+	int              m_channels;
+	double           m_position; // Fractional read position in [0, 1)
+	const SincTable* m_sinc;
 };
 } // namespace giada::m
 
-#endif
\ No newline at end of file
+#endif
@@ -35,12 +35,48 @@
 #include "utils/log.h"
 #include "utils/math.h"
 #include "utils/time.h"
+#include <algorithm>
 
 namespace giada::m
 {
 namespace
 {
 constexpr int Q_ACTION_REWIND = 0;
+
+/* -------------------------------------------------------------------------- */
+
+/* nextMultiple_
+Returns the first multiple of 'step' which is greater than or equal to 'f'. */
+
+Frame nextMultiple_(Frame f, Frame step)
+{
+	return ((f + step - 1) / step) * step;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* seekCursor_
+Returns the index of the first key frame at or after frame 'f'. Just returns
+'cursor' if it's already pointing there, which is the common case while the
+sequencer is playing. */
+
+std::size_t seekCursor_(const model::Actions::Playback& playback, std::size_t cursor, Frame f)
+{
+	using KeyFrame = model::Actions::Playback::KeyFrame;
+
+	const std::vector<KeyFrame>& keyFrames = playback.keyFrames;
+
+	if (f == 0)
+		return 0;
+	if (cursor <= keyFrames.size() &&
+	    (cursor == keyFrames.size() || keyFrames[cursor].frame >= f) &&
+	    (cursor == 0 || keyFrames[cursor - 1].frame < f))
+		return cursor;
+
+	const auto it = std::lower_bound(keyFrames.begin(), keyFrames.end(), f,
+	    [](const KeyFrame& k, Frame f) { return k.frame < f; });
+	return std::distance(keyFrames.begin(), it);
+}
 } // namespace
 
 /* -------------------------------------------------------------------------- */
@@ -53,9 +89,12 @@ Sequencer::Sequencer(model::Model& m, MidiSynchronizer& s, JackTransport& j)
 , m_model(m)
 , m_midiSynchronizer(s)
 , m_jackTransport(j)
+, m_actionCursor(0)
 , m_quantizerStep(1)
 {
-	m_quantizer.schedule(Q_ACTION_REWIND, [this](Frame delta) { rawRewind(delta); });
+	m_quantizer.schedule(Q_ACTION_REWIND, this, [](void* ctx, Frame delta) {
+		static_cast<Sequencer*>(ctx)->rawRewind(delta);
+	});
 }
 /* -------------------------------------------------------------------------- */
 
@@ -132,31 +171,67 @@ const Sequencer::EventBuffer& Sequencer::advance(const model::Sequencer& sequenc
 	const Frame framesInBeat = sequencer.framesInBeat;
 	const Frame nextFrame    = end % framesInLoop;
 
-	/* Process events in the current block. */
+	/* Process events in the current block. Rather than inspecting each frame,
+	jump straight to the next interesting one: the closest among the next beat,
+	the next bar and the next frame with actions. The block is split into
+	segments that never cross the loop boundary, so that 'global' frames stay
+	monotonic within each segment. */
+
+	const model::Actions::Playback& playback  = actions.getPlayback();
+	const std::size_t               keyFrames = playback.keyFrames.size();
 
-	for (Frame i = start, local = 0; i < end; i++, local++)
+	for (Frame i = start, local = 0; i < end;)
 	{
+		const Frame segStart = i % framesInLoop; // wraps around 'framesInLoop'
+		const Frame segEnd   = std::min(segStart + (end - i), framesInLoop);
 
-		Frame global = i % framesInLoop; // wraps around 'framesInLoop'
+		Frame nextBeat = nextMultiple_(segStart, framesInBeat);
+		Frame nextBar  = nextMultiple_(segStart, framesInBar);
 
-		if (global == 0)
-		{
-			m_eventBuffer.push_back({EventType::FIRST_BEAT, global, local});
-			m_metronome.trigger(Metronome::Click::BEAT, local);
-		}
-		else if (global % framesInBar == 0)
-		{
-			m_eventBuffer.push_back({EventType::BAR, global, local});
-			m_metronome.trigger(Metronome::Click::BAR, local);
-		}
-		else if (global % framesInBeat == 0)
+		m_actionCursor = seekCursor_(playback, m_actionCursor, segStart);
+
+		while (true)
 		{
-			m_metronome.trigger(Metronome::Click::BEAT, local);
+			const Frame nextAction = m_actionCursor < keyFrames ? playback.keyFrames[m_actionCursor].frame : framesInLoop;
+			const Frame global     = std::min({nextBeat, nextBar, nextAction});
+
+			if (global >= segEnd)
+				break;
+
+			const Frame offset = local + (global - segStart);
+
+			if (global == nextBeat || global == nextBar)
+			{
+				if (global == 0)
+				{
+					m_eventBuffer.push_back({EventType::FIRST_BEAT, global, offset});
+					m_metronome.trigger(Metronome::Click::BEAT, offset);
+				}
+				else if (global == nextBar)
+				{
+					m_eventBuffer.push_back({EventType::BAR, global, offset});
+					m_metronome.trigger(Metronome::Click::BAR, offset);
+				}
+				else
+				{
+					m_metronome.trigger(Metronome::Click::BEAT, offset);
+				}
+
+				if (global == nextBeat)
+					nextBeat += framesInBeat;
+				if (global == nextBar)
+					nextBar += framesInBar;
+			}
+
+			if (global == nextAction)
+			{
+				const model::Actions::Playback::KeyFrame& k = playback.keyFrames[m_actionCursor++];
+				m_eventBuffer.push_back({EventType::ACTIONS, global, offset, playback.getActions(k)});
+			}
 		}
 
-		const std::vector<Action>* as = actions.getActionsOnFrame(global);
-		if (as != nullptr)
-			m_eventBuffer.push_back({EventType::ACTIONS, global, local, as});
+		local += segEnd - segStart;
+		i += segEnd - segStart;
 	}
 
 	/* Advance this and quantizer after the event parsing. */
@@ -267,10 +342,7 @@ void Sequencer::recomputeFrames(int sampleRate)
 {
 	model::Sequencer& s = m_model.get().sequencer;
 
-	s.framesInBeat = u::time::beatToFrame(1, sampleRate, s.bpm);
-	s.framesInLoop = s.framesInBeat * s.beats;
-	s.framesInBar  = s.framesInLoop / (float)s.bars;
-	s.framesInSeq  = s.framesInBeat * G_MAX_BEATS;
+	s.recomputeFrames(sampleRate);
 
 	if (s.quantize != 0)
 		m_quantizerStep = s.framesInBeat / s.quantize;
@@ -32,6 +32,7 @@
 #include "core/metronome.h"
 #include "core/quantizer.h"
 #include "core/ringBuffer.h"
+#include <span>
 #include <vector>
 
 namespace mcl
@@ -66,10 +67,10 @@ public:
 
 	struct Event
 	{
-		EventType                  type    = EventType::NONE;
-		Frame                      global  = 0;
-		Frame                      delta   = 0;
-		const std::vector<Action>* actions = nullptr;
+		EventType               type    = EventType::NONE;
+		Frame                   global  = 0;
+		Frame                   delta   = 0;
+		std::span<const Action> actions = {};
 	};
 
 	using EventBuffer = RingBuffer<Event, G_MAX_SEQUENCER_EVENTS>;
@@ -198,6 +199,14 @@ private:
 
 	mutable EventBuffer m_eventBuffer;
 
+	/* m_actionCursor
+	Index of the next key frame to be played in the actions Playback index. Kept
+	across blocks so that action playback is a linear scan. Re-synced with a 
+	binary search when it doesn't match the current position anymore (e.g. on
+	rewind or when the actions have changed). */
+
+	mutable std::size_t m_actionCursor;
+
 	Metronome m_metronome;
 	Quantizer m_quantizer;
 
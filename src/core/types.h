@@ -72,7 +72,8 @@ enum class ChannelStatus : int
 	OFF,
 	EMPTY,
 	MISSING,
-	WRONG
+	WRONG,
+	LOADING
 };
 
 enum class SamplePlayerMode : int
@@ -34,10 +34,12 @@ namespace giada::m
 {
 Wave::Wave(ID id)
 : id(id)
+, m_buffer(std::make_shared<mcl::AudioBuffer>())
 , m_rate(0)
 , m_bits(0)
 , m_logical(false)
 , m_edited(false)
+, m_original(false)
 {
 }
 
@@ -45,11 +47,14 @@ Wave::Wave(ID id)
 
 Wave::Wave(const Wave& other)
 : id(other.id)
-, m_buffer(other.getBuffer())
+, m_buffer(other.m_buffer)
+, m_compact(other.m_compact)
+, m_stream(other.isStreamed() ? std::make_unique<WaveStream>(other.m_stream->getPath(), other.getBuffer().countFrames()) : nullptr)
 , m_rate(other.m_rate)
 , m_bits(other.m_bits)
 , m_logical(false)
 , m_edited(false)
+, m_original(other.m_original)
 , m_path(other.m_path)
 {
 }
@@ -58,10 +63,12 @@ Wave::Wave(const Wave& other)
 
 void Wave::alloc(Frame size, int channels, int rate, int bits, const std::string& path)
 {
-	m_buffer.alloc(size, channels);
-	m_rate = rate;
-	m_bits = bits;
-	m_path = path;
+	m_buffer   = std::make_shared<mcl::AudioBuffer>(size, channels);
+	m_rate     = rate;
+	m_bits     = bits;
+	m_path     = path;
+	m_original = false;
+	m_compact.reset();
 }
 
 /* -------------------------------------------------------------------------- */
@@ -78,17 +85,61 @@ std::string Wave::getPath() const { return m_path; }
 int         Wave::getBits() const { return m_bits; }
 bool        Wave::isLogical() const { return m_logical; }
 bool        Wave::isEdited() const { return m_edited; }
+bool        Wave::isOriginal() const { return m_original; }
+bool        Wave::isStreamed() const { return m_stream != nullptr; }
+bool        Wave::isCompact() const { return m_compact != nullptr; }
+WaveStream* Wave::getStream() const { return m_stream.get(); }
 
 /* -------------------------------------------------------------------------- */
 
-mcl::AudioBuffer&       Wave::getBuffer() { return m_buffer; }
-const mcl::AudioBuffer& Wave::getBuffer() const { return m_buffer; }
+const mcl::AudioBuffer& Wave::getBuffer() const { return *m_buffer; }
+const CompactBuffer*    Wave::getCompact() const { return m_compact.get(); }
+
+/* -------------------------------------------------------------------------- */
+
+mcl::AudioBuffer& Wave::getWritableBuffer()
+{
+	expand();
+	m_original = false;
+	if (m_buffer.use_count() > 1)
+	{
+		/* Deep copy with set(): the shared buffer might be a view over memory
+		owned by someone else (see resampleCache), which a copy constructor
+		would just view again. */
+
+		const int frames = m_buffer->countFrames();
+		auto      copy   = std::make_shared<mcl::AudioBuffer>(frames, m_buffer->countChannels());
+		if (frames > 0)
+			copy->set(*m_buffer, frames, 0, 0);
+		m_buffer = std::move(copy);
+	}
+	return *m_buffer;
+}
+
+/* -------------------------------------------------------------------------- */
+
+Frame Wave::getSize() const
+{
+	if (isStreamed())
+		return m_stream->getSize();
+	if (isCompact())
+		return m_compact->countFrames();
+	return m_buffer->countFrames();
+}
+
+/* -------------------------------------------------------------------------- */
+
+std::size_t Wave::getMemorySize() const
+{
+	const std::size_t floats = static_cast<std::size_t>(m_buffer->countFrames()) * m_buffer->countChannels();
+	return floats * sizeof(float) + (isCompact() ? m_compact->getBytes() : 0);
+}
 
 /* -------------------------------------------------------------------------- */
 
 int Wave::getDuration() const
 {
-	return m_buffer.countFrames() / m_rate;
+	return getSize() / m_rate;
 }
 
 /* -------------------------------------------------------------------------- */
@@ -103,6 +154,7 @@ std::string Wave::getExtension() const
 void Wave::setRate(int v) { m_rate = v; }
 void Wave::setLogical(bool l) { m_logical = l; }
 void Wave::setEdited(bool e) { m_edited = e; }
+void Wave::setOriginal(bool o) { m_original = o; }
 
 /* -------------------------------------------------------------------------- */
 
@@ -118,6 +170,49 @@ void Wave::setPath(const std::string& p, int wid)
 
 void Wave::replaceData(mcl::AudioBuffer&& b)
 {
-	m_buffer = std::move(b);
+	replaceData(std::make_shared<mcl::AudioBuffer>(std::move(b)));
+}
+
+void Wave::replaceData(std::shared_ptr<mcl::AudioBuffer> b)
+{
+	assert(b != nullptr);
+
+	m_buffer   = std::move(b);
+	m_original = false;
+	m_compact.reset();
+	m_stream.reset();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Wave::setStream(std::unique_ptr<WaveStream> s)
+{
+	assert(s == nullptr || s->getSize() >= m_buffer->countFrames());
+	m_stream = std::move(s);
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool Wave::compact()
+{
+	if (isCompact())
+		return true;
+	if (isStreamed() || !m_original || !CompactBuffer::canCompact(m_bits))
+		return false;
+
+	m_compact = std::make_shared<const CompactBuffer>(*m_buffer, m_bits);
+	m_buffer  = std::make_shared<mcl::AudioBuffer>();
+	return true;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Wave::expand()
+{
+	if (!isCompact())
+		return;
+
+	m_buffer = std::make_shared<mcl::AudioBuffer>(m_compact->toAudioBuffer());
+	m_compact.reset();
 }
 } // namespace giada::m
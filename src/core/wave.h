@@ -27,12 +27,22 @@
 #ifndef G_WAVE_H
 #define G_WAVE_H
 
+#include "core/compactBuffer.h"
 #include "core/types.h"
+#include "core/waveStream.h"
 #include "deps/mcl-audio-buffer/src/audioBuffer.hpp"
+#include <memory>
 #include <string>
 
 namespace giada::m
 {
+/* Wave
+A sample in memory (or streamed from disk, see WaveStream). Audio data is held
+in a reference-counted block shared among copies of the same Wave, e.g. cloned
+channels: it is duplicated only when one of them is about to be modified
+(copy-on-write). Audio data can also be kept in compact integer form to save
+memory (see CompactBuffer). */
+
 class Wave
 {
 public:
@@ -51,12 +61,56 @@ public:
 	bool        isLogical() const;
 	bool        isEdited() const;
 
+	/* isOriginal
+	True if audio data still holds the integer samples decoded from the file,
+	untouched. Only original data can be compacted with no loss of quality:
+	anything resampled, edited or replaced is arbitrary float data. */
+
+	bool isOriginal() const;
+
+	/* isStreamed
+	True if audio data is streamed from disk while playing. */
+
+	bool isStreamed() const;
+
+	/* isCompact
+	True if audio data is stored as 16 or 24-bit integers. */
+
+	bool isCompact() const;
+
+	/* getSize
+	Returns the length in frames. Always use this instead of
+	getBuffer().countFrames(), which for streamed Waves is the resident part
+	only and for compact Waves is zero. */
+
+	Frame getSize() const;
+
+	/* getMemorySize
+	Returns the amount of memory taken by audio data, in bytes. */
+
+	std::size_t getMemorySize() const;
+
 	/* getBuffer
-	Returns a (non-)const reference to the underlying audio buffer. */
+	Returns a read-only reference to the underlying audio buffer. For streamed
+	Waves, this is the resident head only. For compact Waves it's empty: read
+	from getCompact() instead, or expand() the Wave first. Real-time safe. */
 
-	mcl::AudioBuffer&       getBuffer();
 	const mcl::AudioBuffer& getBuffer() const;
 
+	/* getWritableBuffer
+	Returns a writable reference to the underlying audio buffer. Audio data
+	shared with other Waves is copied first and compact data is expanded, so
+	this might allocate: never call it from the audio thread. The Wave is no
+	longer original (see isOriginal) afterwards. */
+
+	mcl::AudioBuffer& getWritableBuffer();
+
+	/* getCompact
+	Returns the compact audio data, or nullptr if the Wave is not compact.
+	Real-time safe. */
+
+	const CompactBuffer* getCompact() const;
+
 	/* setPath
 	Sets new path 'p'. If 'id' != -1 inserts a numeric id next to the file 
 	extension, e.g. : /path/to/sample-[id].wav */
@@ -66,23 +120,51 @@ public:
 	void setRate(int v);
 	void setLogical(bool l);
 	void setEdited(bool e);
+	void setOriginal(bool o);
 
 	/* replaceData
-	Replaces internal audio buffer with 'b' by moving it. */
+	Replaces internal audio buffer with 'b' by moving it. The second version
+	takes ownership of a shared buffer, e.g. one mapped from the resample
+	cache. The Wave is no longer original (see isOriginal). */
 
 	void replaceData(mcl::AudioBuffer&& b);
+	void replaceData(std::shared_ptr<mcl::AudioBuffer> b);
+
+	/* setStream, getStream
+	Sets and returns the WaveStream object used to stream audio data from disk.
+	The resident head must be already allocated with alloc(). */
+
+	void        setStream(std::unique_ptr<WaveStream> s);
+	WaveStream* getStream() const;
+
+	/* compact
+	Moves audio data to a CompactBuffer, if the Wave is original (see
+	isOriginal) and the bit depth allows it with no loss of quality (see
+	CompactBuffer::canCompact). Streamed Waves are left untouched. Returns true
+	if the Wave is now compact. */
+
+	bool compact();
+
+	/* expand
+	Moves compact audio data back to a float buffer. Does nothing if the Wave
+	is not compact. */
+
+	void expand();
 
 	void alloc(Frame size, int channels, int rate, int bits, const std::string& path);
 
 	ID id;
 
 private:
-	mcl::AudioBuffer m_buffer;
-	int              m_rate;
-	int              m_bits;
-	bool             m_logical; // memory only (a take)
-	bool             m_edited;  // edited via editor
-	std::string      m_path;    // E.g. /path/to/my/sample.wav
+	std::shared_ptr<mcl::AudioBuffer>    m_buffer;   // Shared among copies
+	std::shared_ptr<const CompactBuffer> m_compact;  // Shared among copies, read-only
+	std::unique_ptr<WaveStream>          m_stream;
+	int                                  m_rate;
+	int                                  m_bits;
+	bool                                 m_logical;  // memory only (a take)
+	bool                                 m_edited;   // edited via editor
+	bool                                 m_original; // integer samples from file
+	std::string                          m_path;     // E.g. /path/to/my/sample.wav
 };
 } // namespace giada::m
 
@@ -29,41 +29,72 @@
 #include "deps/mcl-audio-buffer/src/audioBuffer.hpp"
 #include "idManager.h"
 #include "patch.h"
+#include "resampleCache.h"
 #include "utils/fs.h"
 #include "utils/log.h"
 #include "wave.h"
 #include "waveFx.h"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
 #include <cmath>
+#include <condition_variable>
+#include <deque>
 #include <fmt/core.h>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <numeric>
 #include <samplerate.h>
 #include <sndfile.h>
+#include <stop_token>
+#include <thread>
+#include <vector>
 
 namespace giada::m::waveFactory
 {
 namespace
 {
-IdManager waveId_;
+IdManager  waveId_;
+std::mutex waveIdMutex_; // Waves are created by multiple threads on patch load
 
 /* -------------------------------------------------------------------------- */
 
+/* generateId_
+Thread-safe version of waveId_.set() + waveId_.generate(). */
+
+ID generateId_(ID id = 0)
+{
+	std::scoped_lock lock(waveIdMutex_);
+	waveId_.set(id);
+	return waveId_.generate(id);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* getBits_
+Bits per sample of the file, from its subtype. Floating point data is reported
+as 32 or 64 bits: it's never compacted (see CompactBuffer::canCompact). */
+
 int getBits_(const SF_INFO& header)
 {
-	if (header.format & SF_FORMAT_PCM_S8)
+	switch (header.format & SF_FORMAT_SUBMASK)
+	{
+	case SF_FORMAT_PCM_S8:
+	case SF_FORMAT_PCM_U8:
 		return 8;
-	else if (header.format & SF_FORMAT_PCM_16)
+	case SF_FORMAT_PCM_16:
 		return 16;
-	else if (header.format & SF_FORMAT_PCM_24)
+	case SF_FORMAT_PCM_24:
 		return 24;
-	else if (header.format & SF_FORMAT_PCM_32)
-		return 32;
-	else if (header.format & SF_FORMAT_PCM_U8)
-		return 8;
-	else if (header.format & SF_FORMAT_FLOAT)
+	case SF_FORMAT_PCM_32:
+	case SF_FORMAT_FLOAT:
 		return 32;
-	else if (header.format & SF_FORMAT_DOUBLE)
+	case SF_FORMAT_DOUBLE:
 		return 64;
-	return 0;
+	default:
+		return 0;
+	}
 }
 
 /* -------------------------------------------------------------------------- */
@@ -83,6 +114,374 @@ bool isWavePathUnique_(const m::Wave& skip, const std::string& path,
 			return false;
 	return true;
 }
+
+/* -------------------------------------------------------------------------- */
+
+/* toSrcConverter_
+Maps a Resampler quality to the closest libsamplerate converter, used for
+load-time sample rate conversion. */
+
+int toSrcConverter_(Resampler::Quality quality)
+{
+	if (quality == Resampler::Quality::CUBIC)
+		return SRC_SINC_FASTEST;
+	return static_cast<int>(quality);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* LoadPool_
+Threads shared by all loading operations, one per available core minus one,
+started on first use. Work split by parallelFor_ from inside another
+parallelFor_ job (e.g. a long file decoded in chunks while loading a whole
+project) ends up here as well, so the number of threads, and of files open at
+the same time, stays bounded however deep the nesting. */
+
+struct LoadPool_
+{
+	std::mutex                        mutex;
+	std::condition_variable           cond;
+	std::deque<std::function<void()>> tasks;
+	std::size_t                       size = 0;
+};
+
+/* Batch_
+A single parallelFor_ call. Indexes are claimed one at a time by the caller and
+by any pool thread picking up one of its tasks. 'job' is valid only while the
+caller waits, i.e. as long as there are indexes left to claim. Indexes claimed
+after 'stop' has been requested are skipped. */
+
+struct Batch_
+{
+	std::function<void(std::size_t)> job;
+	std::stop_token                  stop;
+	std::size_t                      count     = 0;
+	std::atomic<std::size_t>         next      = 0;
+	std::size_t                      remaining = 0; // Guarded by 'mutex'
+	std::mutex                       mutex;
+	std::condition_variable          done;
+};
+
+/* -------------------------------------------------------------------------- */
+
+/* getLoadPool_
+Returns the shared LoadPool_. Leaked on purpose, along with its threads: they
+just wait for tasks until the process exits. */
+
+LoadPool_& getLoadPool_()
+{
+	static LoadPool_* pool = []() {
+		LoadPool_* p = new LoadPool_();
+		p->size      = std::max(2u, std::thread::hardware_concurrency()) - 1;
+		for (std::size_t i = 0; i < p->size; i++)
+			std::thread([p]() {
+				while (true)
+				{
+					std::function<void()> task;
+					{
+						std::unique_lock lock(p->mutex);
+						p->cond.wait(lock, [p]() { return !p->tasks.empty(); });
+						task = std::move(p->tasks.front());
+						p->tasks.pop_front();
+					}
+					task();
+				}
+			}).detach();
+		return p;
+	}();
+	return *pool;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* runBatch_
+Claims and runs indexes of 'batch' until there are none left. */
+
+void runBatch_(Batch_& batch)
+{
+	for (std::size_t i = batch.next++; i < batch.count; i = batch.next++)
+	{
+		if (!batch.stop.stop_requested())
+			batch.job(i);
+
+		std::scoped_lock lock(batch.mutex);
+		if (--batch.remaining == 0)
+			batch.done.notify_all();
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* parallelFor_
+Calls 'job(i)' for each i in [0, count) on the shared LoadPool_, the calling
+thread included, unless 'stop' is requested in the meantime. The caller sleeps
+while the last jobs taken by the pool are still running: loads may take
+seconds, not worth spinning for. The audio RenderPool is never involved. */
+
+template <typename F>
+void parallelFor_(std::size_t count, F& job, std::stop_token stop = {})
+{
+	if (count == 0)
+		return;
+
+	LoadPool_& pool  = getLoadPool_();
+	auto       batch = std::make_shared<Batch_>();
+
+	batch->job       = [&job](std::size_t i) { job(i); };
+	batch->stop      = stop;
+	batch->count     = count;
+	batch->remaining = count;
+
+	const std::size_t helpers = std::min(count - 1, pool.size);
+	if (helpers > 0)
+	{
+		{
+			std::scoped_lock lock(pool.mutex);
+			for (std::size_t i = 0; i < helpers; i++)
+				pool.tasks.push_back([batch]() { runBatch_(*batch); });
+		}
+		pool.cond.notify_all();
+	}
+
+	runBatch_(*batch);
+
+	std::unique_lock lock(batch->mutex);
+	batch->done.wait(lock, [&batch]() { return batch->remaining == 0; });
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* canReadChunked_
+True if the file can be decoded starting from any frame, quickly and exactly:
+PCM and float data, either raw or FLAC-compressed. */
+
+bool canReadChunked_(const SF_INFO& header)
+{
+	if (!header.seekable)
+		return false;
+
+	switch (header.format & SF_FORMAT_SUBMASK)
+	{
+	case SF_FORMAT_PCM_S8:
+	case SF_FORMAT_PCM_U8:
+	case SF_FORMAT_PCM_16:
+	case SF_FORMAT_PCM_24:
+	case SF_FORMAT_PCM_32:
+	case SF_FORMAT_FLOAT:
+	case SF_FORMAT_DOUBLE:
+		return true;
+	default:
+		return false;
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* read_
+Decodes 'frames' frames from 'file' into 'buffer'. Long files are decoded in
+chunks of G_LOAD_CHUNK_FRAMES frames in parallel, each chunk through its own
+handle to 'path'. Returns the number of frames read, fewer if 'stop' is
+requested halfway. */
+
+sf_count_t read_(const std::string& path, SNDFILE* file, const SF_INFO& header, mcl::AudioBuffer& buffer,
+    sf_count_t frames, std::stop_token stop)
+{
+	const std::size_t chunks = static_cast<std::size_t>((frames + G_LOAD_CHUNK_FRAMES - 1) / G_LOAD_CHUNK_FRAMES);
+
+	if (chunks < 2 || !canReadChunked_(header))
+		return sf_readf_float(file, buffer[0], frames);
+
+	std::atomic<sf_count_t> read = 0;
+
+	auto job = [&](std::size_t i) {
+		const sf_count_t first = static_cast<sf_count_t>(i) * G_LOAD_CHUNK_FRAMES;
+		const sf_count_t count = std::min<sf_count_t>(G_LOAD_CHUNK_FRAMES, frames - first);
+
+		/* The first chunk reuses the handle already open, positioned at the
+		beginning of the file. */
+
+		SF_INFO  info{};
+		SNDFILE* f = i == 0 ? file : sf_open(path.c_str(), SFM_READ, &info);
+		if (f == nullptr)
+			return;
+
+		if (sf_seek(f, first, SEEK_SET) == first)
+			read += sf_readf_float(f, buffer[static_cast<int>(first)], count);
+
+		if (f != file)
+			sf_close(f);
+	};
+
+	parallelFor_(chunks, job, stop);
+
+	return read.load();
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* convert_
+Converts 'inFrames' frames from 'in' into at most 'outFrames' frames at 'out'
+with libsamplerate. Returns the number of frames generated, or -1 on error. */
+
+long convert_(const float* in, long inFrames, float* out, long outFrames, double ratio, int converter, int channels)
+{
+	SRC_DATA data{};
+	data.data_in       = in;
+	data.input_frames  = inFrames;
+	data.data_out      = out;
+	data.output_frames = outFrames;
+	data.src_ratio     = ratio;
+
+	const int ret = src_simple(&data, converter, channels);
+	if (ret != 0)
+	{
+		u::log::print("[waveManager::resample] resampling error: {}\n", src_strerror(ret));
+		return -1;
+	}
+	return data.output_frames_gen;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* convertChunked_
+Sample rate conversion of 'in' into 'out' (whose size is the expected output
+length) by a p/q ratio, in chunks processed in parallel. Chunk boundaries lie
+on input frames multiple of 'q': they map to exact output frames, so chunks
+can be converted independently and simply placed one after the other. Each
+chunk is extended by G_LOAD_CHUNK_PADDING frames on both sides, whose output
+is thrown away, to get rid of the converter transients. Fails if 'stop' is
+requested before all chunks are done. */
+
+bool convertChunked_(const mcl::AudioBuffer& in, mcl::AudioBuffer& out, long p, long q, int converter,
+    std::stop_token stop)
+{
+	const long   inFrames  = in.countFrames();
+	const long   outFrames = out.countFrames();
+	const int    channels  = in.countChannels();
+	const long   chunk     = (G_LOAD_CHUNK_FRAMES + q - 1) / q * q;
+	const long   padding   = (G_LOAD_CHUNK_PADDING + q - 1) / q * q;
+	const long   chunks    = (inFrames + chunk - 1) / chunk;
+	const double ratio     = p / static_cast<double>(q);
+
+	std::atomic<bool> ok = true;
+
+	auto job = [&](std::size_t i) {
+		const long first    = static_cast<long>(i) * chunk;
+		const long last     = std::min(first + chunk, inFrames);
+		const long outFirst = first / q * p;
+		const long outLast  = i == static_cast<std::size_t>(chunks - 1) ? outFrames : last / q * p;
+		const long begin    = std::max(0L, first - padding);
+		const long end      = std::min(inFrames, last + padding);
+		const long skip     = (first - begin) / q * p;
+
+		std::vector<float> tmp((skip + outLast - outFirst) * channels);
+
+		const long generated = convert_(in[static_cast<int>(begin)], end - begin, tmp.data(),
+		    skip + outLast - outFirst, ratio, converter, channels);
+		if (generated < 0)
+		{
+			ok = false;
+			return;
+		}
+
+		const long used = std::clamp(generated - skip, 0L, outLast - outFirst);
+		std::copy_n(tmp.data() + skip * channels, used * channels, out[static_cast<int>(outFirst)]);
+		std::fill(out[static_cast<int>(outFirst)] + used * channels, out[static_cast<int>(outFirst)] + (outLast - outFirst) * channels, 0.0f);
+	};
+
+	parallelFor_(static_cast<std::size_t>(chunks), job, stop);
+
+	return ok.load() && !stop.stop_requested();
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* saveStreamed_
+Audio data of streamed Waves is not in memory: copy it chunk by chunk from the
+source file. Nothing to do if source and destination are the same. */
+
+int saveStreamed_(const Wave& w, const std::string& path)
+{
+	const std::string source = w.getStream()->getPath();
+	if (source == path)
+		return G_RES_OK;
+
+	SF_INFO  headerIn{};
+	SNDFILE* fileIn = sf_open(source.c_str(), SFM_READ, &headerIn);
+	if (fileIn == nullptr)
+	{
+		u::log::print("[waveManager::save] unable to read {}: {}\n", source, sf_strerror(fileIn));
+		return G_RES_ERR_IO;
+	}
+
+	SF_INFO headerOut{};
+	headerOut.samplerate = headerIn.samplerate;
+	headerOut.channels   = headerIn.channels;
+	headerOut.format     = SF_FORMAT_WAV | SF_FORMAT_FLOAT;
+
+	SNDFILE* fileOut = sf_open(path.c_str(), SFM_WRITE, &headerOut);
+	if (fileOut == nullptr)
+	{
+		u::log::print("[waveManager::save] unable to open {} for exporting: {}\n",
+		    path, sf_strerror(fileOut));
+		sf_close(fileIn);
+		return G_RES_ERR_IO;
+	}
+
+	std::vector<float> chunk(G_STREAMING_CHUNK_FRAMES * headerIn.channels);
+	sf_count_t         read = 0;
+	while ((read = sf_readf_float(fileIn, chunk.data(), G_STREAMING_CHUNK_FRAMES)) > 0)
+		if (sf_writef_float(fileOut, chunk.data(), read) != read)
+		{
+			u::log::print("[waveManager::save] warning: incomplete write!\n");
+			break;
+		}
+
+	sf_close(fileIn);
+	sf_close(fileOut);
+
+	return G_RES_OK;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* saveCompact_
+Compact Waves are written in their own integer format, chunk by chunk, with no
+need to expand them in memory. They will be compacted again when loaded. */
+
+int saveCompact_(const Wave& w, const std::string& path)
+{
+	const CompactBuffer& compact = *w.getCompact();
+
+	SF_INFO header{};
+	header.samplerate = w.getRate();
+	header.channels   = compact.countChannels();
+	header.format     = SF_FORMAT_WAV | (compact.getBits() == 16 ? SF_FORMAT_PCM_16 : SF_FORMAT_PCM_24);
+
+	SNDFILE* file = sf_open(path.c_str(), SFM_WRITE, &header);
+	if (file == nullptr)
+	{
+		u::log::print("[waveManager::save] unable to open {} for exporting: {}\n",
+		    path, sf_strerror(file));
+		return G_RES_ERR_IO;
+	}
+
+	std::vector<int32_t> chunk(G_STREAMING_CHUNK_FRAMES * header.channels);
+	for (Frame f = 0; f < compact.countFrames(); f += G_STREAMING_CHUNK_FRAMES)
+	{
+		const Frame count = std::min(G_STREAMING_CHUNK_FRAMES, compact.countFrames() - f);
+		compact.decodeInt(chunk.data(), f, count);
+		if (sf_writef_int(file, chunk.data(), count) != count)
+		{
+			u::log::print("[waveManager::save] warning: incomplete write!\n");
+			break;
+		}
+	}
+
+	sf_close(file);
+
+	return G_RES_OK;
+}
 } // namespace
 
 /* -------------------------------------------------------------------------- */
@@ -111,12 +510,22 @@ std::string makeUniqueWavePath(const std::string& base, const m::Wave& w,
 
 void reset()
 {
+	std::scoped_lock lock(waveIdMutex_);
 	waveId_ = IdManager();
 }
 
 /* -------------------------------------------------------------------------- */
 
-Result createFromFile(const std::string& path, ID id, int samplerate, Resampler::Quality quality)
+void reserveId(ID id)
+{
+	std::scoped_lock lock(waveIdMutex_);
+	waveId_.set(id);
+}
+
+/* -------------------------------------------------------------------------- */
+
+Result createFromFile(const std::string& path, ID id, int samplerate, Resampler::Quality quality,
+    int streamingThreshold, std::stop_token stop)
 {
 	if (path == "" || u::fs::isDir(path))
 	{
@@ -142,25 +551,79 @@ Result createFromFile(const std::string& path, ID id, int samplerate, Resampler:
 		return {G_RES_ERR_WRONG_DATA};
 	}
 
-	waveId_.set(id);
+	/* Long samples are streamed from disk, if their sample rate doesn't need
+	conversion: only the head is read here. */
+
+	const bool stream = streamingThreshold > 0 && header.samplerate == samplerate &&
+	                    header.frames > static_cast<sf_count_t>(streamingThreshold) * header.samplerate;
+	const sf_count_t frames = stream ? header.samplerate * G_STREAMING_RESIDENT_MS / 1000 : header.frames;
+
+	std::unique_ptr<Wave> wave = std::make_unique<Wave>(generateId_(id));
+
+	/* Samples that need a sample rate conversion are looked up in the resample
+	cache first: on a hit there's nothing to decode nor convert. */
+
+	const bool        convert  = !stream && header.samplerate != samplerate;
+	const std::string cacheKey = convert ? resampleCache::makeKey(path, samplerate, quality) : "";
+
+	if (cacheKey != "")
+	{
+		std::shared_ptr<mcl::AudioBuffer> cached = resampleCache::load(u::fs::getResampleCachePath(), cacheKey);
+		if (cached != nullptr && cached->countChannels() == header.channels)
+		{
+			sf_close(fileIn);
+
+			wave->alloc(0, header.channels, samplerate, getBits_(header), path);
+			wave->replaceData(std::move(cached));
+
+			u::log::print("[waveManager::create] new Wave created from resample cache, {} frames\n", wave->getSize());
 
-	std::unique_ptr<Wave> wave = std::make_unique<Wave>(waveId_.generate(id));
-	wave->alloc(header.frames, header.channels, header.samplerate, getBits_(header), path);
+			return {G_RES_OK, std::move(wave)};
+		}
+	}
+
+	wave->alloc(frames, header.channels, header.samplerate, getBits_(header), path);
 
-	if (sf_readf_float(fileIn, wave->getBuffer()[0], header.frames) != header.frames)
+	if (read_(path, fileIn, header, wave->getWritableBuffer(), frames, stop) != frames)
 		u::log::print("[waveManager::create] warning: incomplete read!\n");
 
 	sf_close(fileIn);
 
-	if (header.channels == 1 && !wfx::monoToStereo(*wave))
+	if (stop.stop_requested())
 		return {G_RES_ERR_PROCESSING};
 
+	/* Freshly decoded data, still made of the file's integer samples: it can be
+	compacted as long as nothing converts or edits it. */
+
+	wave->setOriginal(true);
+
+	/* Mono samples stay mono in memory: they are spread over the two channels
+	at render time. Streamed ones are the exception, since the stream works on
+	stereo data only. */
+
+	if (stream)
+	{
+		if (header.channels == 1 && !wfx::monoToStereo(*wave))
+			return {G_RES_ERR_PROCESSING};
+
+		auto waveStream = std::make_unique<WaveStream>(path, static_cast<Frame>(frames));
+		if (!waveStream->isOpen())
+			return {G_RES_ERR_IO};
+		wave->setStream(std::move(waveStream));
+
+		u::log::print("[waveManager::create] new streamed Wave created, {} frames\n", wave->getSize());
+
+		return {G_RES_OK, std::move(wave)};
+	}
+
 	if (wave->getRate() != samplerate)
 	{
 		u::log::print("[waveManager::create] input rate ({}) != required rate ({}), conversion needed\n",
 		    wave->getRate(), samplerate);
-		if (resample(*wave.get(), quality, samplerate) != G_RES_OK)
+		if (resample(*wave.get(), quality, samplerate, stop) != G_RES_OK)
 			return {G_RES_ERR_PROCESSING};
+		if (cacheKey != "")
+			resampleCache::store(u::fs::getResampleCachePath(), cacheKey, wave->getBuffer());
 	}
 
 	u::log::print("[waveManager::create] new Wave created, {} frames\n", wave->getBuffer().countFrames());
@@ -173,7 +636,7 @@ Result createFromFile(const std::string& path, ID id, int samplerate, Resampler:
 std::unique_ptr<Wave> createEmpty(int frames, int channels, int samplerate,
     const std::string& name)
 {
-	std::unique_ptr<Wave> wave = std::make_unique<Wave>(waveId_.generate());
+	std::unique_ptr<Wave> wave = std::make_unique<Wave>(generateId_());
 	wave->alloc(frames, channels, samplerate, G_DEFAULT_BIT_DEPTH, name);
 	wave->setLogical(true);
 
@@ -188,15 +651,42 @@ std::unique_ptr<Wave> createEmpty(int frames, int channels, int samplerate,
 std::unique_ptr<Wave> createFromWave(const Wave& src, int a, int b)
 {
 	a = a == -1 ? 0 : a;
-	b = b == -1 ? src.getBuffer().countFrames() : b;
+	b = b == -1 ? src.getSize() : b;
+
+	/* Whole Wave: share audio data with the source, which will be copied only
+	when one of the two gets edited. Streamed Waves can't be cropped: the copy
+	just streams the same file. */
+
+	if (src.isStreamed() || (a == 0 && b == src.getSize()))
+	{
+		assert(a == 0 && b == src.getSize());
+
+		std::unique_ptr<Wave> wave = std::make_unique<Wave>(src);
+		wave->id                   = generateId_();
+		wave->setLogical(!src.isStreamed());
+
+		u::log::print("[waveManager::createFromWave] new Wave created, sharing {} frames\n", b);
+
+		return wave;
+	}
+
+	/* Compact Waves must be expanded to float first. */
+
+	if (src.isCompact())
+	{
+		Wave expanded(src);
+		expanded.expand();
+		return createFromWave(expanded, a, b);
+	}
 
 	const int channels = src.getBuffer().countChannels();
 	const int frames   = b - a;
 
-	std::unique_ptr<Wave> wave = std::make_unique<Wave>(waveId_.generate());
+	std::unique_ptr<Wave> wave = std::make_unique<Wave>(generateId_());
 	wave->alloc(frames, channels, src.getRate(), src.getBits(), src.getPath());
-	wave->getBuffer().set(src.getBuffer(), frames);
+	wave->getWritableBuffer().set(src.getBuffer(), frames);
 	wave->setLogical(true);
+	wave->setOriginal(src.isOriginal());
 
 	u::log::print("[waveManager::createFromWave] new Wave created, {} frames\n", frames);
 
@@ -205,9 +695,10 @@ std::unique_ptr<Wave> createFromWave(const Wave& src, int a, int b)
 
 /* -------------------------------------------------------------------------- */
 
-std::unique_ptr<Wave> deserializeWave(const Patch::Wave& w, int samplerate, Resampler::Quality quality)
+std::unique_ptr<Wave> deserializeWave(const Patch::Wave& w, int samplerate, Resampler::Quality quality,
+    int streamingThreshold, std::stop_token stop)
 {
-	return createFromFile(w.path, w.id, samplerate, quality).wave;
+	return createFromFile(w.path, w.id, samplerate, quality, streamingThreshold, stop).wave;
 }
 
 const Patch::Wave serializeWave(const Wave& w)
@@ -217,28 +708,55 @@ const Patch::Wave serializeWave(const Wave& w)
 
 /* -------------------------------------------------------------------------- */
 
-int resample(Wave& w, Resampler::Quality quality, int samplerate)
+std::vector<std::unique_ptr<Wave>> deserializeWaves(const std::vector<Patch::Wave>& waves, int samplerate,
+    Resampler::Quality quality, int streamingThreshold, std::function<void()> onLoaded, std::stop_token stop)
 {
-	float ratio         = samplerate / (float)w.getRate();
-	int   newSizeFrames = static_cast<int>(ceil(w.getBuffer().countFrames() * ratio));
+	std::vector<std::unique_ptr<Wave>> out(waves.size());
 
-	mcl::AudioBuffer newData;
-	newData.alloc(newSizeFrames, w.getBuffer().countChannels());
+	auto job = [&](std::size_t i) {
+		out[i] = deserializeWave(waves[i], samplerate, quality, streamingThreshold, stop);
+		onLoaded();
+	};
+
+	parallelFor_(waves.size(), job, stop);
+
+	return out;
+}
 
-	SRC_DATA src_data;
-	src_data.data_in       = w.getBuffer()[0];
-	src_data.input_frames  = w.getBuffer().countFrames();
-	src_data.data_out      = newData[0];
-	src_data.output_frames = newSizeFrames;
-	src_data.src_ratio     = ratio;
+/* -------------------------------------------------------------------------- */
+
+int resample(Wave& w, Resampler::Quality quality, int samplerate, std::stop_token stop)
+{
+	/* The conversion ratio as a fraction p/q in lowest terms, so that chunk
+	boundaries can be placed on exact output frames. */
+
+	const long gcd = std::gcd(samplerate, w.getRate());
+	const long p   = samplerate / gcd;
+	const long q   = w.getRate() / gcd;
+
+	const mcl::AudioBuffer& buffer        = w.getBuffer();
+	const int               converter     = toSrcConverter_(quality);
+	const int               newSizeFrames = static_cast<int>((static_cast<int64_t>(buffer.countFrames()) * p + q - 1) / q);
+
+	mcl::AudioBuffer newData;
+	newData.alloc(newSizeFrames, buffer.countChannels());
 
 	u::log::print("[waveManager::resample] resampling: new size={} frames\n", newSizeFrames);
 
-	int ret = src_simple(&src_data, static_cast<int>(quality), w.getBuffer().countChannels());
-	if (ret != 0)
+	/* Short samples, or ratios too odd to be split, are converted in one go. */
+
+	const bool chunked = q <= G_LOAD_CHUNK_FRAMES && buffer.countFrames() >= G_LOAD_CHUNK_FRAMES * 2;
+
+	if (chunked)
 	{
-		u::log::print("[waveManager::resample] resampling error: {}\n", src_strerror(ret));
-		return G_RES_ERR_PROCESSING;
+		if (!convertChunked_(buffer, newData, p, q, converter, stop))
+			return G_RES_ERR_PROCESSING;
+	}
+	else
+	{
+		if (convert_(buffer[0], buffer.countFrames(), newData[0], newSizeFrames, p / static_cast<double>(q),
+		        converter, buffer.countChannels()) < 0)
+			return G_RES_ERR_PROCESSING;
 	}
 
 	w.replaceData(std::move(newData));
@@ -249,8 +767,39 @@ int resample(Wave& w, Resampler::Quality quality, int samplerate)
 
 /* -------------------------------------------------------------------------- */
 
+bool compact(Wave& w, bool force, int budget, const std::vector<std::unique_ptr<Wave>>& waves)
+{
+	if (!force && budget <= 0)
+		return false;
+
+	if (!force)
+	{
+		std::size_t used = w.getMemorySize();
+		for (const std::unique_ptr<Wave>& other : waves)
+			if (other.get() != &w)
+				used += other->getMemorySize();
+		if (used <= static_cast<std::size_t>(budget) * 1024 * 1024)
+			return false;
+	}
+
+	if (!w.compact())
+		return false;
+
+	u::log::print("[waveManager::compact] Wave compacted to {} bits, {} bytes\n",
+	    w.getCompact()->getBits(), w.getMemorySize());
+
+	return true;
+}
+
+/* -------------------------------------------------------------------------- */
+
 int save(const Wave& w, const std::string& path)
 {
+	if (w.isStreamed())
+		return saveStreamed_(w, path);
+	if (w.isCompact())
+		return saveCompact_(w, path);
+
 	SF_INFO header;
 	header.samplerate = w.getRate();
 	header.channels   = w.getBuffer().countChannels();
@@ -32,8 +32,11 @@
 #include "core/resampler.h"
 #include "core/types.h"
 #include "core/wave.h"
+#include <functional>
 #include <memory>
+#include <stop_token>
 #include <string>
+#include <vector>
 
 namespace giada::m::waveFactory
 {
@@ -48,12 +51,22 @@ struct Result
 
 void reset();
 
+/* reserveId
+	Marks 'id' as taken, so that it won't be given to new Waves. Used when Waves
+	with known IDs are going to be created later on, e.g. loaded in background. */
+
+void reserveId(ID id);
+
 /* create
 	Creates a new Wave object with data read from file 'path'. Pass id = 0 to 
 	auto-generate it. The function converts the Wave sample rate if it doesn't 
-	match the desired one as specified in 'samplerate'. */
+	match the desired one as specified in 'samplerate'. Samples longer than
+	'streamingThreshold' seconds with no need for conversion are streamed from
+	disk instead of being loaded in memory (0 = never). Decoding and conversion
+	are given up as soon as 'stop' is requested: no Wave is returned then. */
 
-Result createFromFile(const std::string& path, ID id, int samplerate, Resampler::Quality);
+Result createFromFile(const std::string& path, ID id, int samplerate, Resampler::Quality,
+    int streamingThreshold = 0, std::stop_token stop = {});
 
 /* createEmpty
 	Creates a new silent Wave object. */
@@ -63,24 +76,48 @@ std::unique_ptr<Wave> createEmpty(int frames, int channels, int samplerate,
 
 /* createFromWave
 	Creates a new Wave from an existing one. If specified, copying the data in 
-	range a - b. Range is [0, sr.buffer.countFrames()] otherwise. */
+	range a - b. Range is [0, sr.buffer.countFrames()] otherwise. A copy of the
+	whole Wave shares audio data with the source until one of them is edited.
+	Streamed Waves are always copied as a whole. */
 
 std::unique_ptr<Wave> createFromWave(const Wave& src, int a = -1, int b = -1);
 
 /* (de)serializeWave
 	Creates a new Wave given the patch raw data and vice versa. */
 
-std::unique_ptr<Wave> deserializeWave(const Patch::Wave& w, int samplerate, Resampler::Quality);
+std::unique_ptr<Wave> deserializeWave(const Patch::Wave& w, int samplerate, Resampler::Quality,
+    int streamingThreshold = 0, std::stop_token stop = {});
 const Patch::Wave     serializeWave(const Wave& w);
 
+/* deserializeWaves
+	Same as deserializeWave(), for multiple Waves decoded in parallel. The output
+	matches 'waves' one by one, with nullptr for the Waves that couldn't be
+	loaded. 'onLoaded' is called, from any thread, each time a Wave is done.
+	When 'stop' is requested, Waves not started yet are skipped and the ones in
+	progress are given up between chunks. */
+
+std::vector<std::unique_ptr<Wave>> deserializeWaves(const std::vector<Patch::Wave>& waves, int samplerate,
+    Resampler::Quality, int streamingThreshold, std::function<void()> onLoaded, std::stop_token stop = {});
+
 /* resample
 	Change sample rate of 'w' to the desider value. The 'quality' parameter sets 
-	the algorithm to use for the conversion. */
+	the algorithm to use for the conversion. Long samples are converted in
+	chunks: the conversion fails as soon as 'stop' is requested. */
+
+int resample(Wave&, Resampler::Quality, int samplerate, std::stop_token stop = {});
+
+/* compact
+	Stores Wave 'w' in compact form (see CompactBuffer) if 'force' is true, or
+	if the memory taken by 'waves' plus 'w' exceeds 'budget' megabytes (0 = no
+	budget). Only Waves still holding the file's original samples qualify (see
+	Wave::isOriginal). Returns true if 'w' is now compact. */
 
-int resample(Wave&, Resampler::Quality, int samplerate);
+bool compact(Wave& w, bool force, int budget, const std::vector<std::unique_ptr<Wave>>& waves);
 
 /* save
-	Writes Wave data to file 'path'. Only 'wav' format is supported for now. */
+	Writes Wave data to file 'path'. Only 'wav' format is supported for now.
+	Streamed Waves are copied from their source file. Compact Waves are saved
+	in their 16 or 24-bit integer format. */
 
 int save(const Wave& w, const std::string& path);
 
@@ -0,0 +1,229 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2023 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#include "core/waveLoader.h"
+#include "core/wave.h"
+#include "core/waveFactory.h"
+#include "utils/log.h"
+#include "utils/vector.h"
+#include <algorithm>
+
+namespace giada::m
+{
+WaveLoader::WaveLoader()
+: m_stop(false)
+, m_sampleRate(0)
+, m_quality(Resampler::Quality::LINEAR)
+, m_streamingThreshold(0)
+{
+}
+
+/* -------------------------------------------------------------------------- */
+
+WaveLoader::~WaveLoader()
+{
+	stop();
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool WaveLoader::isLoading() const
+{
+	std::scoped_lock lock(m_mutex);
+	return !m_queue.empty() || !m_running.empty() || !m_loaded.empty();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void WaveLoader::start(std::vector<Request> requests, int sampleRate, Resampler::Quality quality,
+    int streamingThreshold, int threads)
+{
+	stop();
+
+	if (requests.empty())
+		return;
+
+	if (threads <= 0)
+		threads = std::max(2u, std::thread::hardware_concurrency()) - 1;
+	threads = std::min(threads, static_cast<int>(requests.size()));
+
+	m_queue              = std::move(requests);
+	m_sampleRate         = sampleRate;
+	m_quality            = quality;
+	m_streamingThreshold = streamingThreshold;
+
+	u::log::print("[WaveLoader::start] Loading {} waves on {} threads\n", m_queue.size(), threads);
+
+	for (int i = 0; i < threads; i++)
+		m_threads.emplace_back([this]() { run(); });
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool WaveLoader::press(ID channelId, int velocity, Frame frame)
+{
+	std::scoped_lock lock(m_mutex);
+
+	if (!isWaiting(channelId))
+		return false;
+
+	/* Move the Request up front, if still queued. */
+
+	auto it = std::find_if(m_queue.begin(), m_queue.end(), [channelId](const Request& r) {
+		return std::find(r.channelIds.begin(), r.channelIds.end(), channelId) != r.channelIds.end();
+	});
+	if (it != m_queue.end())
+		std::rotate(m_queue.begin(), it, it + 1);
+
+	/* Keep only the last press for each channel. */
+
+	auto press = std::find_if(m_presses.begin(), m_presses.end(), [channelId](const Press& p) { return p.channelId == channelId; });
+	if (press != m_presses.end())
+		*press = {channelId, velocity, frame};
+	else
+		m_presses.push_back({channelId, velocity, frame});
+
+	return true;
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool WaveLoader::release(ID channelId)
+{
+	std::scoped_lock lock(m_mutex);
+
+	auto press = std::find_if(m_presses.begin(), m_presses.end(), [channelId](const Press& p) { return p.channelId == channelId; });
+	if (press == m_presses.end())
+		return false;
+	press->released = true;
+	return true;
+}
+
+/* -------------------------------------------------------------------------- */
+
+std::vector<WaveLoader::Result> WaveLoader::collect()
+{
+	std::scoped_lock lock(m_mutex);
+
+	std::vector<Result> out = std::move(m_loaded);
+	m_loaded.clear();
+
+	/* Hand over the key presses received in the meantime to their Result. */
+
+	for (Result& r : out)
+	{
+		for (ID channelId : r.channelIds)
+		{
+			auto press = std::find_if(m_presses.begin(), m_presses.end(), [channelId](const Press& p) { return p.channelId == channelId; });
+			if (press == m_presses.end())
+				continue;
+			r.presses.push_back(*press);
+			m_presses.erase(press);
+		}
+	}
+
+	return out;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void WaveLoader::wait()
+{
+	/* Threads quit as soon as the queue is empty. */
+
+	for (std::thread& t : m_threads)
+		if (t.joinable())
+			t.join();
+	m_threads.clear();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void WaveLoader::stop()
+{
+	{
+		std::scoped_lock lock(m_mutex);
+		m_stop = true;
+	}
+
+	wait();
+
+	std::scoped_lock lock(m_mutex);
+	m_queue.clear();
+	m_running.clear();
+	m_loaded.clear();
+	m_presses.clear();
+	m_stop = false;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void WaveLoader::run()
+{
+	while (true)
+	{
+		Request request;
+		{
+			std::scoped_lock lock(m_mutex);
+			if (m_stop || m_queue.empty())
+				return;
+			request = m_queue.front();
+			m_queue.erase(m_queue.begin());
+			m_running.push_back(request);
+		}
+
+		std::unique_ptr<Wave> wave = waveFactory::deserializeWave(request.wave, m_sampleRate, m_quality, m_streamingThreshold);
+
+		if (wave == nullptr)
+			u::log::print("[WaveLoader::run] Unable to load wave {}\n", request.wave.path);
+
+		std::scoped_lock lock(m_mutex);
+		u::vector::removeIf(m_running, [&request](const Request& r) { return r.wave.id == request.wave.id; });
+		if (!m_stop)
+			m_loaded.push_back({std::move(wave), std::move(request.wave), std::move(request.channelIds), {}});
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool WaveLoader::isWaiting(ID channelId) const
+{
+	auto hasChannel = [channelId](const std::vector<ID>& ids) {
+		return std::find(ids.begin(), ids.end(), channelId) != ids.end();
+	};
+
+	for (const Request& r : m_queue)
+		if (hasChannel(r.channelIds))
+			return true;
+	for (const Request& r : m_running)
+		if (hasChannel(r.channelIds))
+			return true;
+	for (const Result& r : m_loaded)
+		if (hasChannel(r.channelIds))
+			return true;
+	return false;
+}
+} // namespace giada::m
@@ -0,0 +1,154 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2023 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+#ifndef G_WAVE_LOADER_H
+#define G_WAVE_LOADER_H
+
+#include "core/patch.h"
+#include "core/resampler.h"
+#include "core/types.h"
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace giada::m
+{
+class Wave;
+
+/* WaveLoader
+Decodes Waves in the background, one per thread at a time, in the order they
+have been requested. Used to open a project without waiting for its samples:
+channels are brought online as soon as their Wave gets collected. The order can
+be changed on the fly, e.g. when a channel is triggered while its Wave is still
+waiting in line. All methods are meant to be called by non-realtime threads. */
+
+class WaveLoader final
+{
+public:
+	/* Press
+	A key press received by a channel while its Wave was still being loaded, at
+	sequencer frame 'frame'. 'released' == true if the key has been released in
+	the meantime. */
+
+	struct Press
+	{
+		ID    channelId;
+		int   velocity;
+		Frame frame    = 0;
+		bool  released = false;
+	};
+
+	/* Request
+	A Wave to be loaded and the channels waiting for it. */
+
+	struct Request
+	{
+		Patch::Wave     wave;
+		std::vector<ID> channelIds;
+	};
+
+	/* Result
+	A loaded Request. 'wave' is nullptr if the file couldn't be read. */
+
+	struct Result
+	{
+		std::unique_ptr<Wave> wave;
+		Patch::Wave           patchWave;
+		std::vector<ID>       channelIds;
+		std::vector<Press>    presses;
+	};
+
+	WaveLoader();
+	~WaveLoader();
+
+	/* isLoading
+	True if there are Requests not collected yet. */
+
+	bool isLoading() const;
+
+	/* start
+	Starts loading 'requests' in order, on 'threads' threads (0 = one per 
+	available core, minus one). Any previous operation is stopped first. */
+
+	void start(std::vector<Request> requests, int sampleRate, Resampler::Quality,
+	    int streamingThreshold, int threads = 0);
+
+	/* press
+	Moves the Request of channel 'channelId' in front of the queue, and keeps
+	track of the key press received at sequencer frame 'frame'. Returns false if
+	the channel is not waiting for any Wave. */
+
+	bool press(ID channelId, int velocity, Frame frame);
+
+	/* release
+	Marks as released a key press previously recorded with press(). Returns
+	false if there's no such press. */
+
+	bool release(ID channelId);
+
+	/* collect
+	Returns the Requests loaded so far, in order of completion. */
+
+	std::vector<Result> collect();
+
+	/* wait
+	Blocks until all Requests have been loaded. */
+
+	void wait();
+
+	/* stop
+	Stops loading and discards all Requests, loaded or not. */
+
+	void stop();
+
+private:
+	/* run
+	Body of each loading thread: keeps picking the first Request in the queue
+	until the queue is empty or the operation is stopped. */
+
+	void run();
+
+	/* isWaiting
+	True if channel 'channelId' is waiting for a Wave, either queued, being
+	loaded or not collected yet. Call it with 'm_mutex' locked. */
+
+	bool isWaiting(ID channelId) const;
+
+	std::vector<std::thread> m_threads;
+	mutable std::mutex       m_mutex;
+	std::vector<Request>     m_queue;
+	std::vector<Request>     m_running;
+	std::vector<Result>      m_loaded;
+	std::vector<Press>       m_presses;
+	bool                     m_stop;
+	int                      m_sampleRate;
+	Resampler::Quality       m_quality;
+	int                      m_streamingThreshold;
+};
+} // namespace giada::m
+
+#endif
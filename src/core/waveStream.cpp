@@ -0,0 +1,377 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2023 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#include "core/waveStream.h"
+#include "core/const.h"
+#include "core/worker.h"
+#include "deps/mcl-audio-buffer/src/audioBuffer.hpp"
+#include "utils/log.h"
+#include "utils/vector.h"
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <mutex>
+
+namespace giada::m
+{
+namespace
+{
+/* Streamer_
+The background thread shared by all WaveStreams, which register themselves on
+construction and unregister on destruction. The thread runs only while there
+is at least one stream. 'lifecycle' serializes registrations (and thread start
+and stop), 'mutex' protects the list of streams while the thread goes through
+it. */
+
+struct Streamer_
+{
+	Streamer_()
+	: worker(G_STREAMING_RATE_MS)
+	{
+	}
+
+	std::mutex               lifecycle;
+	std::mutex               mutex;
+	std::vector<WaveStream*> streams;
+	Worker                   worker;
+};
+
+/* -------------------------------------------------------------------------- */
+
+/* getStreamer_
+Never destroyed on purpose: Waves live in the global Engine, which might
+outlive any other static object at exit. */
+
+Streamer_& getStreamer_()
+{
+	static Streamer_* streamer = new Streamer_();
+	return *streamer;
+}
+} // namespace
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+WaveStream::WaveStream(const std::string& path, Frame first)
+: m_path(path)
+, m_file(nullptr)
+, m_header{}
+, m_first(first)
+, m_loopStart(-1)
+, m_loopEnd(-1)
+, m_loopGen(0)
+, m_ringFrames(0)
+, m_ringStart(first)
+, m_ringEnd(first)
+, m_ringGen(0)
+, m_readPos(first)
+, m_begin(0)
+, m_end(0)
+{
+	m_file = sf_open(path.c_str(), SFM_READ, &m_header);
+	if (m_file == nullptr)
+	{
+		u::log::print("[WaveStream] unable to open {}: {}\n", path, sf_strerror(m_file));
+		return;
+	}
+
+	const Frame residentFrames = m_header.samplerate * G_STREAMING_RESIDENT_MS / 1000;
+
+	m_ringFrames = std::max(m_header.samplerate * G_STREAMING_RING_MS / 1000, G_STREAMING_CHUNK_FRAMES * 2);
+	m_end.store(getSize());
+
+	m_fileBuffer.resize(G_STREAMING_CHUNK_FRAMES * m_header.channels);
+	m_scratch.resize(SCRATCH_FRAMES * G_MAX_IO_CHANS);
+	m_loop.resize(residentFrames * G_MAX_IO_CHANS);
+	m_ring.resize(m_ringFrames * G_MAX_IO_CHANS);
+
+	u::log::print("[WaveStream] streaming {}, {} frames ({} resident)\n", path, getSize(), m_first);
+
+	/* Fill loop cache and ring buffer right away, so that the sample is ready
+	to play as soon as it's loaded. */
+
+	process();
+
+	/* Then let the shared background thread keep them filled. */
+
+	Streamer_&       streamer = getStreamer_();
+	std::scoped_lock lifecycle(streamer.lifecycle);
+	{
+		std::scoped_lock lock(streamer.mutex);
+		streamer.streams.push_back(this);
+	}
+	if (streamer.streams.size() == 1)
+		streamer.worker.start([&streamer]() {
+			std::scoped_lock lock(streamer.mutex);
+			for (WaveStream* stream : streamer.streams)
+				stream->process();
+		});
+}
+
+/* -------------------------------------------------------------------------- */
+
+WaveStream::~WaveStream()
+{
+	if (m_file != nullptr)
+	{
+		/* Unregister first: the background thread must be done with this stream
+		before the file is closed. */
+
+		Streamer_&       streamer = getStreamer_();
+		std::scoped_lock lifecycle(streamer.lifecycle);
+		{
+			std::scoped_lock lock(streamer.mutex);
+			u::vector::remove(streamer.streams, this);
+		}
+		if (streamer.streams.empty())
+			streamer.worker.stop();
+
+		sf_close(m_file);
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool        WaveStream::isOpen() const { return m_file != nullptr; }
+std::string WaveStream::getPath() const { return m_path; }
+Frame       WaveStream::getSize() const { return static_cast<Frame>(m_header.frames); }
+int         WaveStream::getRate() const { return m_header.samplerate; }
+int         WaveStream::getFileChannels() const { return m_header.channels; }
+float*      WaveStream::getScratch() { return m_scratch.data(); }
+
+/* -------------------------------------------------------------------------- */
+
+bool WaveStream::read(const mcl::AudioBuffer& head, float* out, Frame start, Frame count)
+{
+	assert(head.countFrames() == m_first);
+	assert(head.countChannels() == G_MAX_IO_CHANS);
+
+	/* Let the background thread know where the playhead is. Frames before
+	m_first are resident, so the ring buffer must start from there at least. */
+
+	m_readPos.store(std::max(start, m_first));
+
+	const Frame size = getSize();
+	const Frame end  = start + count;
+
+	for (Frame f = start; f < end;)
+	{
+		float* dest = out + (f - start) * G_MAX_IO_CHANS;
+		Frame  n    = 0;
+
+		if (f < 0 || f >= size) // Out of range: silence
+		{
+			n = f < 0 ? std::min(end, 0) - f : end - f;
+			std::fill_n(dest, n * G_MAX_IO_CHANS, 0.0f);
+		}
+		else if (f < m_first) // Resident head
+		{
+			n = std::min(end, m_first) - f;
+			std::copy_n(head[f], n * G_MAX_IO_CHANS, dest);
+		}
+		else // Streamed part: loop cache first, then ring buffer
+		{
+			n = readLoopCache(dest, f, end);
+			if (n == 0)
+				n = readRing(dest, f, end);
+			if (n == 0) // Underrun: disk is late
+			{
+				std::fill_n(dest, (end - f) * G_MAX_IO_CHANS, 0.0f);
+				return false;
+			}
+		}
+
+		f += n;
+	}
+
+	return true;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void WaveStream::setLoopPoints(Frame begin, Frame end)
+{
+	m_begin.store(begin);
+	m_end.store(end);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void WaveStream::process()
+{
+	const Frame loopStart = std::max(m_begin.load(), m_first);
+
+	if (loopStart != m_loopStart.load())
+		refillLoopCache(loopStart);
+	refillRing(m_readPos.load(), std::min(m_end.load(), getSize()));
+}
+
+/* -------------------------------------------------------------------------- */
+
+void WaveStream::refillLoopCache(Frame begin)
+{
+	m_loopGen.fetch_add(1, std::memory_order_relaxed); // Odd: writing
+	m_loopStart.store(begin, std::memory_order_relaxed);
+	m_loopEnd.store(begin, std::memory_order_relaxed);
+
+	/* Seqlock writer: the odd generation must be visible before any change to
+	the data. Pairs with the acquire fence in readLoopCache(). */
+
+	std::atomic_thread_fence(std::memory_order_release);
+
+	const Frame read = readFile(m_loop.data(), begin, static_cast<Frame>(m_loop.size() / G_MAX_IO_CHANS));
+
+	m_loopEnd.store(begin + read, std::memory_order_relaxed);
+	m_loopGen.fetch_add(1, std::memory_order_release); // Even: ready
+}
+
+/* -------------------------------------------------------------------------- */
+
+void WaveStream::refillRing(Frame readPos, Frame end)
+{
+	Frame start = m_ringStart.load();
+	Frame last  = m_ringEnd.load();
+
+	/* The playhead has jumped outside the ring buffer (loop, rewind, new
+	start point): restart the ring from the new position. */
+
+	if (readPos < start || readPos > last)
+	{
+		m_ringGen.fetch_add(1); // Odd: moving
+		m_ringStart.store(readPos);
+		m_ringEnd.store(readPos);
+		m_ringGen.fetch_add(1); // Even: ready
+
+		start = last = readPos;
+	}
+
+	/* Read ahead up to the loop end point, without overwriting frames from
+	'readPos' onwards that the audio thread might still need. */
+
+	while (last < end)
+	{
+		const Frame slot = last % m_ringFrames;
+		const Frame n    = std::min({G_STREAMING_CHUNK_FRAMES, end - last, readPos + m_ringFrames - last, m_ringFrames - slot});
+		if (n <= 0)
+			break;
+
+		/* Frames about to be overwritten leave the ring first. The fence makes
+		the new start visible before any change to the data, see readRing(). */
+
+		start = std::max(start, last + n - m_ringFrames);
+		m_ringStart.store(start, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+
+		const Frame read = readFile(m_ring.data() + slot * G_MAX_IO_CHANS, last, n);
+		if (read <= 0)
+			break;
+
+		last += read;
+		m_ringEnd.store(last, std::memory_order_release);
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+Frame WaveStream::readFile(float* out, Frame start, Frame count)
+{
+	if (m_file == nullptr || sf_seek(m_file, start, SEEK_SET) < 0)
+		return 0;
+
+	Frame total = 0;
+	while (total < count)
+	{
+		const Frame      n    = std::min(count - total, G_STREAMING_CHUNK_FRAMES);
+		const sf_count_t read = sf_readf_float(m_file, m_fileBuffer.data(), n);
+		if (read <= 0)
+			break;
+
+		float* dest = out + total * G_MAX_IO_CHANS;
+		if (m_header.channels == 1)
+			for (sf_count_t i = 0; i < read; i++)
+				dest[i * 2] = dest[i * 2 + 1] = m_fileBuffer[i];
+		else
+			std::copy_n(m_fileBuffer.data(), read * G_MAX_IO_CHANS, dest);
+
+		total += static_cast<Frame>(read);
+		if (read < n)
+			break;
+	}
+	return total;
+}
+
+/* -------------------------------------------------------------------------- */
+
+Frame WaveStream::readLoopCache(float* out, Frame start, Frame end) const
+{
+	const unsigned gen = m_loopGen.load(std::memory_order_acquire);
+	if (gen % 2 != 0)
+		return 0;
+
+	const Frame first = m_loopStart.load(std::memory_order_relaxed);
+	const Frame last  = m_loopEnd.load(std::memory_order_relaxed);
+	if (start < first || start >= last)
+		return 0;
+
+	const Frame count = std::min(end, last) - start;
+	std::copy_n(m_loop.data() + (start - first) * G_MAX_IO_CHANS, count * G_MAX_IO_CHANS, out);
+
+	/* Discard if the background thread has touched the cache in the meantime.
+	The fence keeps the data reads above from being moved after the check. */
+
+	std::atomic_thread_fence(std::memory_order_acquire);
+	return m_loopGen.load(std::memory_order_relaxed) == gen ? count : 0;
+}
+
+/* -------------------------------------------------------------------------- */
+
+Frame WaveStream::readRing(float* out, Frame start, Frame end) const
+{
+	const unsigned gen = m_ringGen.load(std::memory_order_acquire);
+	if (gen % 2 != 0)
+		return 0;
+
+	const Frame last = m_ringEnd.load(std::memory_order_acquire);
+	if (start < m_ringStart.load(std::memory_order_relaxed) || start >= last)
+		return 0;
+
+	const Frame count = std::min(end, last) - start;
+	const Frame slot  = start % m_ringFrames;
+	const Frame head  = std::min(count, m_ringFrames - slot);
+
+	std::copy_n(m_ring.data() + slot * G_MAX_IO_CHANS, head * G_MAX_IO_CHANS, out);
+	std::copy_n(m_ring.data(), (count - head) * G_MAX_IO_CHANS, out + head * G_MAX_IO_CHANS);
+
+	/* Discard if the ring has been moved, or the frames just read have been
+	overwritten, in the meantime. The fence keeps the data reads above from
+	being moved after the check. */
+
+	std::atomic_thread_fence(std::memory_order_acquire);
+	return m_ringGen.load(std::memory_order_relaxed) == gen && m_ringStart.load(std::memory_order_relaxed) <= start ? count : 0;
+}
+} // namespace giada::m
@@ -0,0 +1,154 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2023 Giovanni A. Zuliani | Monocasual Laboratories
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#ifndef G_WAVE_STREAM_H
+#define G_WAVE_STREAM_H
+
+#include "core/types.h"
+#include <atomic>
+#include <sndfile.h>
+#include <string>
+#include <vector>
+
+namespace mcl
+{
+class AudioBuffer;
+}
+
+namespace giada::m
+{
+/* WaveStream
+Reads a long audio file from disk while playing, instead of loading it in
+memory. The head of the file (the first 'first' frames) is kept resident by the
+owner Wave; everything after it is served from two areas filled by a background
+thread, shared by all streams:
+	- a loop cache holding the audio right after the loop start point, so that
+	  looping and rewinding never wait for the disk;
+	- a ring buffer kept ahead of the last read position (i.e. the channel's
+	  tracker) and up to the loop end point.
+Both areas are single-producer (the background thread), single-consumer (the
+audio thread) seqlocks. Data is always stored as interleaved stereo: mono files
+are converted on the fly. */
+
+class WaveStream final
+{
+public:
+	/* SCRATCH_FRAMES
+	Size of the scratch buffer returned by getScratch(), in stereo frames. */
+
+	static constexpr Frame SCRATCH_FRAMES = 32768;
+
+	/* WaveStream
+	Opens file in 'path' for streaming, starting from frame 'first'. */
+
+	WaveStream(const std::string& path, Frame first);
+	WaveStream(const WaveStream&) = delete;
+	WaveStream(WaveStream&&)      = delete;
+	WaveStream& operator=(const WaveStream&) = delete;
+	WaveStream& operator=(WaveStream&&) = delete;
+	~WaveStream();
+
+	bool        isOpen() const;
+	std::string getPath() const;
+	Frame       getSize() const;
+	int         getRate() const;
+	int         getFileChannels() const;
+
+	/* read
+	Fills 'out' with 'count' interleaved stereo frames starting at 'start'.
+	Frames before 'first' are taken from the resident 'head' buffer. Frames not
+	available yet are left silent. Returns false on underrun. Real-time safe. */
+
+	bool read(const mcl::AudioBuffer& head, float* out, Frame start, Frame count);
+
+	/* setLoopPoints
+	Tells the background thread where playback restarts when looping and where
+	it stops, so that data around them gets prefetched. Real-time safe. */
+
+	void setLoopPoints(Frame begin, Frame end);
+
+	/* getScratch
+	Returns a preallocated buffer of SCRATCH_FRAMES stereo frames, for the
+	audio thread to gather input data before resampling. */
+
+	float* getScratch();
+
+private:
+	/* process
+	Background thread job: refills loop cache and ring buffer. */
+
+	void process();
+	void refillLoopCache(Frame begin);
+	void refillRing(Frame readPos, Frame end);
+
+	/* readFile
+	Reads 'count' frames starting at 'start' from disk into 'out' as
+	interleaved stereo. Returns the number of frames actually read. */
+
+	Frame readFile(float* out, Frame start, Frame count);
+
+	/* readLoopCache, readRing
+	Copy frames in range [start, end) into 'out', as long as they are contiguous
+	and available in the loop cache and the ring buffer respectively. Return the
+	number of frames copied, or 0 if 'start' is not available. */
+
+	Frame readLoopCache(float* out, Frame start, Frame end) const;
+	Frame readRing(float* out, Frame start, Frame end) const;
+
+	std::string m_path;
+	SNDFILE*    m_file;
+	SF_INFO     m_header;
+	Frame       m_first;
+
+	std::vector<float> m_fileBuffer; // Raw data from disk, background thread only
+	std::vector<float> m_scratch;    // Audio thread only
+
+	/* Loop cache. m_loopGen is odd while the background thread is writing. */
+
+	std::vector<float>    m_loop;
+	std::atomic<Frame>    m_loopStart;
+	std::atomic<Frame>    m_loopEnd;
+	std::atomic<unsigned> m_loopGen;
+
+	/* Ring buffer, holding frames in range [m_ringStart, m_ringEnd). m_ringGen
+	is odd while the background thread is moving it to a new position. */
+
+	std::vector<float>    m_ring;
+	Frame                 m_ringFrames;
+	std::atomic<Frame>    m_ringStart;
+	std::atomic<Frame>    m_ringEnd;
+	std::atomic<unsigned> m_ringGen;
+
+	/* Requests from the audio thread. */
+
+	std::atomic<Frame> m_readPos;
+	std::atomic<Frame> m_begin;
+	std::atomic<Frame> m_end;
+};
+} // namespace giada::m
+
+#endif
@@ -92,6 +92,7 @@ SampleData::SampleData(const m::Channel& ch)
 : waveId(ch.samplePlayer->getWaveId())
 , mode(ch.samplePlayer->mode)
 , isLoop(ch.samplePlayer->isAnyLoopMode())
+, isStreamed(ch.samplePlayer->hasStreamedWave())
 , pitch(ch.samplePlayer->pitch)
 , begin(ch.samplePlayer->begin)
 , end(ch.samplePlayer->end)
@@ -128,6 +129,7 @@ Data::Data(const m::Channel& c)
 , m_playStatus(&c.shared->playStatus)
 , m_recStatus(&c.shared->recStatus)
 , m_readActions(&c.shared->readActions)
+, m_cpuMeter(&c.shared->cpuMeter)
 {
 	if (c.type == ChannelType::SAMPLE)
 		sample = std::make_optional<SampleData>(c);
@@ -144,6 +146,8 @@ bool          Data::isMuted() const { return g_engine.getChannelsApi().get(id).i
 bool          Data::isSoloed() const { return g_engine.getChannelsApi().get(id).isSoloed(); }
 bool          Data::isArmed() const { return g_engine.getChannelsApi().get(id).armed; }
 
+m::CpuMeter::Stats Data::getCpuStats() const { return m_cpuMeter->collect(); }
+
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
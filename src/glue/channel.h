@@ -27,6 +27,7 @@
 #ifndef G_GLUE_CHANNEL_H
 #define G_GLUE_CHANNEL_H
 
+#include "core/cpuMeter.h"
 #include "core/model/model.h"
 #include "core/types.h"
 #include "core/weakAtomic.h"
@@ -60,6 +61,7 @@ struct SampleData
 	ID               waveId;
 	SamplePlayerMode mode;
 	bool             isLoop;
+	bool             isStreamed;
 	float            pitch;
 	Frame            begin;
 	Frame            end;
@@ -92,6 +94,11 @@ struct Data
 	bool          isSoloed() const;
 	bool          isArmed() const;
 
+	/* getCpuStats
+	Returns the time spent rendering the channel, plug-ins included. */
+
+	m::CpuMeter::Stats getCpuStats() const;
+
 	ID                      id;
 	ID                      columnId;
 	int                     position;
@@ -111,6 +118,7 @@ private:
 	WeakAtomic<ChannelStatus>* m_playStatus;
 	WeakAtomic<ChannelStatus>* m_recStatus;
 	WeakAtomic<bool>*          m_readActions;
+	m::CpuMeter*               m_cpuMeter;
 };
 
 /* getChannels
@@ -68,6 +68,15 @@ void openBrowserForProjectLoad()
 
 /* -------------------------------------------------------------------------- */
 
+void openBrowserForProjectPreload()
+{
+	v::gdWindow* childWin = new v::gdBrowserLoad(g_ui.getI18Text(v::LangMap::BROWSER_QUEUEPROJECT),
+	    g_ui.model.patchPath, c::storage::preloadProject, 0, g_ui.model);
+	g_ui.openSubWindow(*g_ui.mainWindow.get(), childWin, WID_FILE_BROWSER);
+}
+
+/* -------------------------------------------------------------------------- */
+
 void openBrowserForProjectSave()
 {
 	v::gdWindow* childWin = new v::gdBrowserSave(g_ui.getI18Text(v::LangMap::BROWSER_SAVEPROJECT),
@@ -95,6 +104,15 @@ void openBrowserForSampleSave(ID channelId)
 
 /* -------------------------------------------------------------------------- */
 
+void openBrowserForProjectRender()
+{
+	v::gdWindow* w = new v::gdBrowserSave(g_ui.getI18Text(v::LangMap::BROWSER_RENDERPROJECT),
+	    g_ui.model.samplePath, g_ui.model.projectName, c::storage::renderProject, 0, g_ui.model);
+	g_ui.openSubWindow(*g_ui.mainWindow.get(), w, WID_FILE_BROWSER);
+}
+
+/* -------------------------------------------------------------------------- */
+
 void openAboutWindow()
 {
 	g_ui.openSubWindow(*g_ui.mainWindow.get(), new v::gdAbout(), WID_ABOUT);
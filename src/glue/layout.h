@@ -49,9 +49,11 @@ struct Data;
 namespace giada::c::layout
 {
 void openBrowserForProjectLoad();
+void openBrowserForProjectPreload();
 void openBrowserForProjectSave();
 void openBrowserForSampleLoad(ID channelId);
 void openBrowserForSampleSave(ID channelId);
+void openBrowserForProjectRender();
 void openAboutWindow();
 void openKeyGrabberWindow(int key, std::function<bool(int)>);
 void openBpmWindow(float bpm);
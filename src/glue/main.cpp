@@ -93,6 +93,13 @@ Peak IO::getMasterInPeak()
 
 /* -------------------------------------------------------------------------- */
 
+m::LoadMonitor::Stats IO::getLoadStats()
+{
+	return g_engine.getMainApi().getLoadStats();
+}
+
+/* -------------------------------------------------------------------------- */
+
 bool IO::isKernelReady()
 {
 	return g_engine.isAudioReady();
@@ -27,6 +27,7 @@
 #ifndef G_MAIN_H
 #define G_MAIN_H
 
+#include "core/loadMonitor.h"
 #include "core/types.h"
 
 /* giada::c::main
@@ -68,9 +69,10 @@ struct IO
 	bool  masterInHasPlugins;
 	bool  inToOut;
 
-	Peak getMasterOutPeak();
-	Peak getMasterInPeak();
-	bool isKernelReady();
+	Peak                  getMasterOutPeak();
+	Peak                  getMasterInPeak();
+	m::LoadMonitor::Stats getLoadStats();
+	bool                  isKernelReady();
 };
 
 struct Sequencer
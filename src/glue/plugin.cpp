@@ -100,6 +100,13 @@ void Plugin::setResizeCallback(std::function<void(int, int)> f)
 	m_plugin.onEditorResize = f;
 }
 
+/* -------------------------------------------------------------------------- */
+
+m::CpuMeter::Stats Plugin::getCpuStats() const
+{
+	return m_plugin.cpuMeter.collect();
+}
+
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
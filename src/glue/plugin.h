@@ -28,6 +28,7 @@
 #define G_GLUE_PLUGIN_H
 
 #include "core/conf.h"
+#include "core/cpuMeter.h"
 #include "core/plugins/pluginHost.h"
 #include "core/plugins/pluginManager.h"
 #include "core/types.h"
@@ -79,6 +80,11 @@ struct Plugin
 
 	void setResizeCallback(std::function<void(int, int)> f);
 
+	/* getCpuStats
+	Returns the time spent by the plug-in on each audio block. */
+
+	m::CpuMeter::Stats getCpuStats() const;
+
 	ID          id;
 	ID          channelId;
 	bool        valid;
@@ -67,7 +67,7 @@ Data::Data(const m::Channel& c)
 , begin(c.samplePlayer->begin)
 , end(c.samplePlayer->end)
 , shift(c.samplePlayer->shift)
-, waveSize(c.samplePlayer->getWave()->getBuffer().countFrames())
+, waveSize(c.samplePlayer->getWave()->getSize())
 , waveBits(c.samplePlayer->getWave()->getBits())
 , waveDuration(c.samplePlayer->getWave()->getDuration())
 , waveRate(c.samplePlayer->getWave()->getRate())
@@ -108,8 +108,10 @@ Frame Data::getFramesInLoop() const
 
 Data getData(ID channelId)
 {
-	/* Prepare the preview channel first, then return Data object. */
+	/* Expand compact Waves and prepare the preview channel first, then return
+	Data object. */
 
+	g_engine.getSampleEditorApi().expand(channelId);
 	g_engine.getChannelsApi().loadPreviewChannel(channelId);
 	return Data(g_engine.getChannelsApi().get(channelId));
 }
@@ -53,6 +53,7 @@
 #include "utils/gui.h"
 #include "utils/log.h"
 #include "utils/string.h"
+#include <FL/Fl.H>
 #include <cassert>
 
 extern giada::m::Engine g_engine;
@@ -62,6 +63,19 @@ namespace giada::c::storage
 {
 namespace
 {
+/* preloadedPatch_, preloadedPatchPath_
+Patch of the project waiting to be switched to, if any, and its path. */
+
+m::Patch    preloadedPatch_;
+std::string preloadedPatchPath_;
+
+/* lazyMissingWaves_
+Samples of the current project that couldn't be loaded in background. */
+
+std::vector<std::string> lazyMissingWaves_;
+
+/* -------------------------------------------------------------------------- */
+
 void printLoadError_(int res)
 {
 	if (res == G_FILE_UNREADABLE)
@@ -88,6 +102,106 @@ bool validateFileName_(const std::string& name)
 	}
 	return true;
 }
+
+/* -------------------------------------------------------------------------- */
+
+/* publishLoadedWaves_
+Brings online the samples loaded in background so far. Once they are all in,
+shows the missing ones, if any. Returns true if samples are still loading. */
+
+bool publishLoadedWaves_()
+{
+	m::StorageApi& storageApi = g_engine.getStorageApi();
+
+	for (std::string& path : storageApi.publishLoadedWaves())
+		lazyMissingWaves_.push_back(std::move(path));
+
+	if (storageApi.isLoadingWaves())
+		return true;
+
+	if (!lazyMissingWaves_.empty())
+	{
+		m::model::LoadState state;
+		state.missingWaves = std::move(lazyMissingWaves_);
+		lazyMissingWaves_.clear();
+		layout::openMissingAssetsWindow(state);
+	}
+	return false;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* pollLoadedWaves_
+Timer callback: keeps publishing samples loaded in background until done. */
+
+void pollLoadedWaves_(void*)
+{
+	if (publishLoadedWaves_())
+		Fl::repeat_timeout(G_GUI_REFRESH_RATE, pollLoadedWaves_);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* waitForWaves_
+Makes sure all samples loaded in background are in place, e.g. before the
+project is saved. */
+
+void waitForWaves_()
+{
+	if (!g_engine.getStorageApi().isLoadingWaves())
+		return;
+
+	Fl::remove_timeout(pollLoadedWaves_);
+	g_engine.getStorageApi().waitForWaves();
+	publishLoadedWaves_();
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* commitPreloadedProject_
+Completes the switch to the preloaded project, if ready, and brings the UI in
+line. Plug-in editors must be closed before the old plug-ins go away, as in
+loadProject(). Returns true on success. */
+
+bool commitPreloadedProject_()
+{
+	if (!g_engine.getStorageApi().isPreloadedProjectReady())
+		return false;
+
+	g_ui.closeAllSubwindows();
+
+	if (!g_engine.getStorageApi().commitPreloadedProject())
+		return false;
+
+	Fl::remove_timeout(pollLoadedWaves_);
+	lazyMissingWaves_.clear();
+
+	g_ui.model.patchPath = preloadedPatchPath_;
+	g_ui.load(preloadedPatch_);
+	return true;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* pollPreloadedProject_
+Timer callback: queues the preloaded project for the switch as soon as its
+samples are loaded, then keeps trying to commit it until the switch has taken
+place. */
+
+void pollPreloadedProject_(void*)
+{
+	m::StorageApi& storageApi = g_engine.getStorageApi();
+
+	if (storageApi.isPreloadedProjectLoaded())
+	{
+		m::model::LoadState state = storageApi.armPreloadedProject();
+		if (!state.isGood())
+			layout::openMissingAssetsWindow(state);
+	}
+
+	if (!commitPreloadedProject_())
+		Fl::repeat_timeout(G_GUI_REFRESH_RATE, pollPreloadedProject_);
+}
 } // namespace
 
 /* -------------------------------------------------------------------------- */
@@ -102,9 +216,13 @@ void loadProject(void* data)
 	const m::PluginManager::SortMethod pluginsSortMethod = g_ui.model.pluginChooserSortMethod;
 
 	/* Close all sub-windows first, in case there are VST editors visible. VST
-	editors must be closed before deleting their plug-in processors. */
+	editors must be closed before deleting their plug-in processors. Any queued
+	project is dropped by the engine. */
 
 	g_ui.closeAllSubwindows();
+	Fl::remove_timeout(pollPreloadedProject_);
+	Fl::remove_timeout(pollLoadedWaves_);
+	lazyMissingWaves_.clear();
 
 	auto uiProgress     = g_ui.mainWindow->getScopedProgress(g_ui.getI18Text(v::LangMap::MESSAGE_STORAGE_LOADINGPROJECT));
 	auto engineProgress = [&uiProgress](float v) { uiProgress.setProgress(v); };
@@ -124,6 +242,48 @@ void loadProject(void* data)
 
 	g_ui.load(state.patch);
 
+	/* Samples might still be loading in background: keep an eye on them. */
+
+	if (g_engine.getStorageApi().isLoadingWaves())
+		Fl::add_timeout(G_GUI_REFRESH_RATE, pollLoadedWaves_);
+
+	browser->do_callback();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void preloadProject(void* data)
+{
+	v::gdBrowserLoad* browser = static_cast<v::gdBrowserLoad*>(data);
+
+	const std::string projectPath = browser->getSelectedItem();
+
+	/* The current project keeps playing: sub-windows can stay open until the
+	actual switch. Only plug-ins are created here, samples are loaded in
+	background and checked by pollPreloadedProject_(). */
+
+	auto uiProgress     = g_ui.mainWindow->getScopedProgress(g_ui.getI18Text(v::LangMap::MESSAGE_STORAGE_PRELOADINGPROJECT));
+	auto engineProgress = [&uiProgress](float v) { uiProgress.setProgress(v); };
+
+	/* A previously queued project might be playing already: bring the UI in
+	line before queueing the next one. */
+
+	Fl::remove_timeout(pollPreloadedProject_);
+	commitPreloadedProject_();
+
+	m::model::LoadState state = g_engine.getStorageApi().preloadProject(projectPath, m::model::SwitchPoint::LOOP, engineProgress);
+
+	if (state.patch.status != G_FILE_OK)
+	{
+		printLoadError_(state.patch.status);
+		return;
+	}
+
+	preloadedPatch_     = state.patch;
+	preloadedPatchPath_ = u::fs::getUpDir(projectPath);
+
+	Fl::add_timeout(G_GUI_REFRESH_RATE, pollPreloadedProject_);
+
 	browser->do_callback();
 }
 
@@ -147,6 +307,8 @@ void saveProject(void* data)
 	auto uiProgress     = g_ui.mainWindow->getScopedProgress(g_ui.getI18Text(v::LangMap::MESSAGE_STORAGE_SAVINGPROJECT));
 	auto engineProgress = [&uiProgress](float v) { uiProgress.setProgress(v); };
 
+	waitForWaves_();
+
 	g_ui.model.projectName = projectName;
 
 	if (g_engine.getStorageApi().storeProject(projectPath, g_ui.model, engineProgress))
@@ -204,4 +366,39 @@ void saveSample(void* data)
 
 	browser->do_callback();
 }
+
+/* -------------------------------------------------------------------------- */
+
+void renderProject(void* data)
+{
+	v::gdBrowserSave* browser  = static_cast<v::gdBrowserSave*>(data);
+	const std::string name     = browser->getName();
+	const std::string filePath = u::fs::join(browser->getCurrentPath(), u::fs::stripExt(name) + ".wav");
+
+	if (!validateFileName_(name))
+		return;
+
+	if (u::fs::fileExists(filePath) &&
+	    !v::gdConfirmWin(g_ui.getI18Text(v::LangMap::COMMON_WARNING),
+	        g_ui.getI18Text(v::LangMap::MESSAGE_STORAGE_FILEEXISTS)))
+		return;
+
+	auto uiProgress     = g_ui.mainWindow->getScopedProgress(g_ui.getI18Text(v::LangMap::MESSAGE_STORAGE_RENDERINGPROJECT));
+	auto engineProgress = [&uiProgress](float v) { uiProgress.setProgress(v); };
+
+	waitForWaves_();
+
+	/* Rendering works on the current project only. Bring the UI in line with a
+	queued project if it's already playing, the engine drops it otherwise. */
+
+	Fl::remove_timeout(pollPreloadedProject_);
+	commitPreloadedProject_();
+
+	if (!g_engine.getStorageApi().renderProject(filePath, /*loops=*/1, engineProgress))
+		v::gdAlert(g_ui.getI18Text(v::LangMap::MESSAGE_STORAGE_RENDERINGERROR));
+	else
+		g_ui.model.samplePath = u::fs::dirname(filePath);
+
+	browser->do_callback();
+}
 } // namespace giada::c::storage
\ No newline at end of file
@@ -33,9 +33,11 @@ Persistence functions. Only the main thread can use these! */
 namespace giada::c::storage
 {
 void loadProject(void* data);
+void preloadProject(void* data);
 void saveProject(void* data);
 void saveSample(void* data);
 void loadSample(void* data);
+void renderProject(void* data);
 } // namespace giada::c::storage
 
 #endif
@@ -101,6 +101,16 @@ void gdPluginList::rebuild()
 
 /* -------------------------------------------------------------------------- */
 
+void gdPluginList::refresh()
+{
+	/* Skip the last child, which is the 'add plug-in' button. */
+
+	for (int i = 0; i < list->countChildren() - 1; i++)
+		static_cast<gePluginElement*>(list->child(i))->refresh();
+}
+
+/* -------------------------------------------------------------------------- */
+
 const gePluginElement& gdPluginList::getNextElement(const gePluginElement& currEl) const
 {
 	int curr = list->find(currEl);
@@ -37,6 +37,7 @@
 #include "gui/ui.h"
 #include <FL/Fl.H>
 #include <FL/fl_draw.H>
+#include <fmt/core.h>
 
 extern giada::v::Ui g_ui;
 
@@ -88,6 +89,11 @@ void geChannel::refresh()
 	arm->setValue(m_channel.isArmed());
 	mute->setValue(m_channel.isMuted());
 	solo->setValue(m_channel.isSoloed());
+
+	const m::CpuMeter::Stats cpu = m_channel.getCpuStats();
+	mainButton->copy_tooltip(fmt::format(fmt::runtime(g_ui.getI18Text(LangMap::MAIN_CHANNEL_LABEL_CPU)),
+	    cpu.avg, cpu.peak)
+	                             .c_str());
 }
 
 /* -------------------------------------------------------------------------- */
@@ -49,6 +49,7 @@ void geChannelButton::refresh()
 	{
 	case ChannelStatus::OFF:
 	case ChannelStatus::EMPTY:
+	case ChannelStatus::LOADING:
 		setDefaultMode();
 		break;
 	case ChannelStatus::PLAY:
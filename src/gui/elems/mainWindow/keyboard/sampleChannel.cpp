@@ -188,6 +188,11 @@ void geSampleChannel::openMenu()
 		menu.setEnabled((ID)Menu::RENAME_CHANNEL, false);
 	}
 
+	/* Streamed samples are not in memory, so they can't be edited. */
+
+	if (m_channel.sample->isStreamed)
+		menu.setEnabled((ID)Menu::EDIT_SAMPLE, false);
+
 	if (!m_channel.hasActions)
 		menu.setEnabled((ID)Menu::CLEAR_ACTIONS, false);
 
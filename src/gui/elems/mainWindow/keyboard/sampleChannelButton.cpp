@@ -47,6 +47,9 @@ geSampleChannelButton::geSampleChannelButton(int x, int y, int w, int h, const c
 	case ChannelStatus::WRONG:
 		label(g_ui.getI18Text(LangMap::MAIN_CHANNEL_SAMPLENOTFOUND));
 		break;
+	case ChannelStatus::LOADING:
+		label(g_ui.getI18Text(LangMap::MAIN_CHANNEL_LOADING));
+		break;
 	default:
 		label(m_channel.sample->waveId == 0 ? g_ui.getI18Text(LangMap::MAIN_CHANNEL_NOSAMPLE) : m_channel.name.c_str());
 		break;
@@ -29,6 +29,7 @@
 #include "glue/channel.h"
 #include "glue/layout.h"
 #include "glue/main.h"
+#include "gui/elems/basics/box.h"
 #include "gui/elems/basics/dial.h"
 #include "gui/elems/basics/imageButton.h"
 #include "gui/elems/basics/textButton.h"
@@ -37,6 +38,7 @@
 #include "gui/graphics.h"
 #include "gui/ui.h"
 #include "utils/gui.h"
+#include <fmt/core.h>
 
 extern giada::v::Ui g_ui;
 
@@ -53,6 +55,7 @@ geMainIO::geMainIO()
 	m_masterFxOut  = new geImageButton(graphics::fxOff, graphics::fxOn);
 	m_masterFxIn   = new geImageButton(graphics::fxOff, graphics::fxOn);
 	m_midiActivity = new geMidiActivity();
+	m_dspLoad      = new geBox("", FL_ALIGN_RIGHT);
 
 	add(m_masterFxIn, G_GUI_UNIT);
 	add(m_inVol, G_GUI_UNIT);
@@ -62,6 +65,7 @@ geMainIO::geMainIO()
 	add(m_outVol, G_GUI_UNIT);
 	add(m_masterFxOut, G_GUI_UNIT);
 	add(m_midiActivity, 10);
+	add(m_dspLoad, 36);
 	end();
 
 	m_outMeter->copy_tooltip(g_ui.getI18Text(LangMap::MAIN_IO_LABEL_OUTMETER));
@@ -119,6 +123,14 @@ void geMainIO::refresh()
 	m_outMeter->redraw();
 	m_inMeter->redraw();
 	m_midiActivity->redraw();
+
+	const m::LoadMonitor::Stats load = m_io.getLoadStats();
+	m_dspLoad->copy_label(fmt::format("{:.0f}%", load.load * 100).c_str());
+	m_dspLoad->copy_tooltip(fmt::format(fmt::runtime(g_ui.getI18Text(LangMap::MAIN_IO_LABEL_DSPLOAD)),
+	    load.minLoad * 100, load.avgLoad * 100, load.maxLoad * 100, load.overloads,
+	    load.underflows + load.overflows)
+	                            .c_str());
+	m_dspLoad->redraw();
 }
 
 /* -------------------------------------------------------------------------- */
@@ -32,6 +32,7 @@
 
 namespace giada::v
 {
+class geBox;
 class geDial;
 class geSoundMeter;
 class geTextButton;
@@ -63,6 +64,7 @@ private:
 	geImageButton*  m_masterFxOut;
 	geImageButton*  m_masterFxIn;
 	geMidiActivity* m_midiActivity;
+	geBox*          m_dspLoad;
 };
 } // namespace giada::v
 
@@ -45,8 +45,10 @@ namespace
 enum class FileMenu
 {
 	OPEN_PROJECT = 0,
+	QUEUE_PROJECT,
 	SAVE_PROJECT,
 	CLOSE_PROJECT,
+	RENDER_PROJECT,
 #ifdef G_DEBUG_MODE
 	DEBUG_STATS,
 #endif
@@ -91,8 +93,10 @@ void geMainMenu::cb_file()
 	geMenu menu;
 
 	menu.addItem((ID)FileMenu::OPEN_PROJECT, g_ui.getI18Text(LangMap::MAIN_MENU_FILE_OPENPROJECT));
+	menu.addItem((ID)FileMenu::QUEUE_PROJECT, g_ui.getI18Text(LangMap::MAIN_MENU_FILE_QUEUEPROJECT));
 	menu.addItem((ID)FileMenu::SAVE_PROJECT, g_ui.getI18Text(LangMap::MAIN_MENU_FILE_SAVEPROJECT));
 	menu.addItem((ID)FileMenu::CLOSE_PROJECT, g_ui.getI18Text(LangMap::MAIN_MENU_FILE_CLOSEPROJECT));
+	menu.addItem((ID)FileMenu::RENDER_PROJECT, g_ui.getI18Text(LangMap::MAIN_MENU_FILE_RENDERPROJECT));
 #ifdef G_DEBUG_MODE
 	menu.addItem((ID)FileMenu::DEBUG_STATS, "Debug stats");
 #endif
@@ -104,12 +108,18 @@ void geMainMenu::cb_file()
 		case FileMenu::OPEN_PROJECT:
 			c::layout::openBrowserForProjectLoad();
 			break;
+		case FileMenu::QUEUE_PROJECT:
+			c::layout::openBrowserForProjectPreload();
+			break;
 		case FileMenu::SAVE_PROJECT:
 			c::layout::openBrowserForProjectSave();
 			break;
 		case FileMenu::CLOSE_PROJECT:
 			c::main::closeProject();
 			break;
+		case FileMenu::RENDER_PROJECT:
+			c::layout::openBrowserForProjectRender();
+			break;
 #ifdef G_DEBUG_MODE
 		case FileMenu::DEBUG_STATS:
 			c::main::printDebugInfo();
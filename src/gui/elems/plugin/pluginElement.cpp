@@ -29,6 +29,7 @@
 #include "gui/dialogs/pluginList.h"
 #include "gui/dialogs/pluginWindow.h"
 #include "gui/dialogs/pluginWindowGUI.h"
+#include "gui/elems/basics/box.h"
 #include "gui/elems/basics/choice.h"
 #include "gui/elems/basics/imageButton.h"
 #include "gui/elems/basics/pack.h"
@@ -38,6 +39,7 @@
 #include "utils/gui.h"
 #include "utils/log.h"
 #include <cassert>
+#include <fmt/core.h>
 #include <string>
 
 extern giada::v::Ui g_ui;
@@ -54,14 +56,18 @@ gePluginElement::gePluginElement(int x, int y, int w, int h, c::plugin::Plugin d
 	shiftUpBtn   = new geImageButton(graphics::upOff, graphics::upOn);
 	shiftDownBtn = new geImageButton(graphics::downOff, graphics::downOn);
 	remove       = new geImageButton(graphics::removeOff, graphics::removeOn);
+	cpu          = new geBox("", FL_ALIGN_RIGHT);
 	add(button);
 	add(program);
+	add(cpu, 80);
 	add(bypass, G_GUI_UNIT);
 	add(shiftUpBtn, G_GUI_UNIT);
 	add(shiftDownBtn, G_GUI_UNIT);
 	add(remove, G_GUI_UNIT);
 	end();
 
+	cpu->copy_tooltip(g_ui.getI18Text(LangMap::PLUGINLIST_LABEL_CPU));
+
 	remove->onClick = [this]() { removePlugin(); };
 
 	if (!m_plugin.valid)
@@ -117,6 +123,17 @@ const m::Plugin& gePluginElement::getPluginRef() const
 
 /* -------------------------------------------------------------------------- */
 
+void gePluginElement::refresh()
+{
+	if (!m_plugin.valid)
+		return;
+
+	const m::CpuMeter::Stats stats = m_plugin.getCpuStats();
+	cpu->copy_label(fmt::format(fmt::runtime(g_ui.getI18Text(LangMap::PLUGINLIST_CPU)), stats.avg, stats.peak).c_str());
+}
+
+/* -------------------------------------------------------------------------- */
+
 void gePluginElement::shiftUp()
 {
 	const gdPluginList* parent = static_cast<const gdPluginList*>(window());
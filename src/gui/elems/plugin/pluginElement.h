@@ -33,6 +33,7 @@
 
 namespace giada::v
 {
+class geBox;
 class geChoice;
 class geTextButton;
 class geImageButton;
@@ -44,12 +45,18 @@ public:
 	ID               getPluginId() const;
 	const m::Plugin& getPluginRef() const;
 
+	/* refresh
+	Updates the CPU usage column. */
+
+	void refresh();
+
 	geTextButton*  button;
 	geChoice*      program;
 	geTextButton*  bypass;
 	geImageButton* shiftUpBtn;
 	geImageButton* shiftDownBtn;
 	geImageButton* remove;
+	geBox*         cpu;
 
 private:
 	void openPluginWindow();
@@ -84,6 +84,7 @@ LangMap::LangMap()
 	m_data[MESSAGE_STORAGE_PATCHUNSUPPORTED]    = "This patch format is no longer supported.";
 	m_data[MESSAGE_STORAGE_PROJECTEXISTS]       = "Project exists: overwrite?";
 	m_data[MESSAGE_STORAGE_LOADINGPROJECT]      = "Loading project...";
+	m_data[MESSAGE_STORAGE_PRELOADINGPROJECT]   = "Preloading next project...";
 	m_data[MESSAGE_STORAGE_LOADINGSAMPLE]       = "Loading sample...";
 	m_data[MESSAGE_STORAGE_SAVINGPROJECT]       = "Saving project...";
 	m_data[MESSAGE_STORAGE_SAVINGPROJECTERROR]  = "Unable to save the project!";
@@ -91,11 +92,15 @@ LangMap::LangMap()
 	m_data[MESSAGE_STORAGE_FILEHASINVALIDCHARS] = "The file name contains invalid characters.";
 	m_data[MESSAGE_STORAGE_FILEEXISTS]          = "File exists: overwrite?";
 	m_data[MESSAGE_STORAGE_SAVINGFILEERROR]     = "Unable to save this sample!";
+	m_data[MESSAGE_STORAGE_RENDERINGPROJECT]    = "Rendering project...";
+	m_data[MESSAGE_STORAGE_RENDERINGERROR]      = "Unable to render the project!";
 
 	m_data[MAIN_MENU_FILE]                 = "File";
 	m_data[MAIN_MENU_FILE_OPENPROJECT]     = "Open project...";
+	m_data[MAIN_MENU_FILE_QUEUEPROJECT]    = "Queue next project...";
 	m_data[MAIN_MENU_FILE_SAVEPROJECT]     = "Save project...";
 	m_data[MAIN_MENU_FILE_CLOSEPROJECT]    = "Close project";
+	m_data[MAIN_MENU_FILE_RENDERPROJECT]   = "Render to file...";
 	m_data[MAIN_MENU_FILE_QUIT]            = "Quit Giada";
 	m_data[MAIN_MENU_EDIT]                 = "Edit";
 	m_data[MAIN_MENU_EDIT_FREEALLSAMPLES]  = "Free all Sample channels";
@@ -113,6 +118,9 @@ LangMap::LangMap()
 	m_data[MAIN_IO_LABEL_FXIN]         = "Main input plug-ins";
 	m_data[MAIN_IO_LABEL_MIDIACTIVITY] = "Master MIDI I/O activity\n\nNotifies MIDI messages sent (top) or "
 	                                     "received (bottom) globally.";
+	m_data[MAIN_IO_LABEL_DSPLOAD]      = "DSP load\n\nTime spent rendering each audio block, compared to "
+	                                     "the block duration.\n\nMin/avg/max: {:.0f}/{:.0f}/{:.0f}%\n"
+	                                     "Overloads: {}\nXruns: {}";
 
 	m_data[MAIN_TIMER_LABEL_BPM]        = "Beats per minute (BPM)";
 	m_data[MAIN_TIMER_LABEL_METER]      = "Beats and bars";
@@ -142,6 +150,7 @@ LangMap::LangMap()
 
 	m_data[MAIN_CHANNEL_NOSAMPLE]          = "-- no sample --";
 	m_data[MAIN_CHANNEL_SAMPLENOTFOUND]    = "* file not found! *";
+	m_data[MAIN_CHANNEL_LOADING]           = "-- loading... --";
 	m_data[MAIN_CHANNEL_LABEL_PLAY]        = "Play/stop";
 	m_data[MAIN_CHANNEL_LABEL_ARM]         = "Arm for recording";
 	m_data[MAIN_CHANNEL_LABEL_STATUS]      = "Progress bar";
@@ -154,6 +163,7 @@ LangMap::LangMap()
 	m_data[MAIN_CHANNEL_LABEL_VOLUME]       = "Volume";
 	m_data[MAIN_CHANNEL_LABEL_MIDIACTIVITY] = "MIDI I/O activity\n\nNotifies MIDI messages sent (top) or "
 	                                          "received (bottom) by this channel.";
+	m_data[MAIN_CHANNEL_LABEL_CPU]          = "CPU time per block\n\nAverage: {:.0f} µs\nPeak: {:.0f} µs";
 
 	m_data[MAIN_CHANNEL_MENU_INPUTMONITOR]           = "Input monitor";
 	m_data[MAIN_CHANNEL_MENU_OVERDUBPROTECTION]      = "Overdub protection";
@@ -191,6 +201,8 @@ LangMap::LangMap()
 	m_data[PLUGINLIST_TITLE_CHANNEL]   = "Channel Plug-ins";
 	m_data[PLUGINLIST_ADDPLUGIN]       = "-- add new plugin --";
 	m_data[PLUGINLIST_NOPROGRAMS]      = "-- no programs --";
+	m_data[PLUGINLIST_CPU]             = "{:.0f}/{:.0f} µs";
+	m_data[PLUGINLIST_LABEL_CPU]       = "Plugin CPU\n\nAverage and peak time spent processing each audio block.";
 
 	m_data[CHANNELNAME_TITLE] = "New channel name";
 
@@ -233,9 +245,11 @@ LangMap::LangMap()
 
 	m_data[BROWSER_SHOWHIDDENFILES] = "Show hidden files";
 	m_data[BROWSER_OPENPROJECT]     = "Open project";
+	m_data[BROWSER_QUEUEPROJECT]    = "Queue next project";
 	m_data[BROWSER_SAVEPROJECT]     = "Save project";
 	m_data[BROWSER_OPENSAMPLE]      = "Open sample";
 	m_data[BROWSER_SAVESAMPLE]      = "Save sample";
+	m_data[BROWSER_RENDERPROJECT]   = "Render project to file";
 	m_data[BROWSER_OPENPLUGINSDIR]  = "Open plug-ins directory";
 
 	m_data[MIDIINPUT_MASTER_TITLE]           = "MIDI Input Setup (global)";
@@ -301,6 +315,7 @@ LangMap::LangMap()
 	m_data[CONFIG_AUDIO_RESAMPLING_SINCBASIC]  = "Sinc basic quality (medium)";
 	m_data[CONFIG_AUDIO_RESAMPLING_ZEROORDER]  = "Zero Order Hold (fast)";
 	m_data[CONFIG_AUDIO_RESAMPLING_LINEAR]     = "Linear (very fast)";
+	m_data[CONFIG_AUDIO_RESAMPLING_CUBIC]      = "Cubic (fast)";
 	m_data[CONFIG_AUDIO_NODEVICESFOUND]        = "-- no devices found --";
 
 	m_data[CONFIG_MIDI_TITLE]           = "MIDI";
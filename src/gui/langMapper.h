@@ -89,6 +89,7 @@ public:
 	static constexpr auto MESSAGE_STORAGE_PATCHUNSUPPORTED    = "message_storage_patchUnsupported";
 	static constexpr auto MESSAGE_STORAGE_PROJECTEXISTS       = "message_storage_projectExists";
 	static constexpr auto MESSAGE_STORAGE_LOADINGPROJECT      = "message_storage_loadingProject";
+	static constexpr auto MESSAGE_STORAGE_PRELOADINGPROJECT   = "message_storage_preloadingProject";
 	static constexpr auto MESSAGE_STORAGE_LOADINGSAMPLE       = "message_storage_loadingSample";
 	static constexpr auto MESSAGE_STORAGE_SAVINGPROJECT       = "message_storage_savingProject";
 	static constexpr auto MESSAGE_STORAGE_SAVINGPROJECTERROR  = "message_storage_savingProjectError";
@@ -96,11 +97,15 @@ public:
 	static constexpr auto MESSAGE_STORAGE_FILEHASINVALIDCHARS = "message_storage_fileHasInvalidChars";
 	static constexpr auto MESSAGE_STORAGE_FILEEXISTS          = "message_storage_fileExists";
 	static constexpr auto MESSAGE_STORAGE_SAVINGFILEERROR     = "message_storage_savingFileError";
+	static constexpr auto MESSAGE_STORAGE_RENDERINGPROJECT    = "message_storage_renderingProject";
+	static constexpr auto MESSAGE_STORAGE_RENDERINGERROR      = "message_storage_renderingError";
 
 	static constexpr auto MAIN_MENU_FILE                 = "main_menu_file";
 	static constexpr auto MAIN_MENU_FILE_OPENPROJECT     = "main_menu_file_openProject";
+	static constexpr auto MAIN_MENU_FILE_QUEUEPROJECT    = "main_menu_file_queueProject";
 	static constexpr auto MAIN_MENU_FILE_SAVEPROJECT     = "main_menu_file_saveProject";
 	static constexpr auto MAIN_MENU_FILE_CLOSEPROJECT    = "main_menu_file_closeProject";
+	static constexpr auto MAIN_MENU_FILE_RENDERPROJECT   = "main_menu_file_renderProject";
 	static constexpr auto MAIN_MENU_FILE_QUIT            = "main_menu_file_quit";
 	static constexpr auto MAIN_MENU_EDIT                 = "main_menu_edit";
 	static constexpr auto MAIN_MENU_EDIT_FREEALLSAMPLES  = "main_menu_edit_freeAllSamples";
@@ -117,6 +122,7 @@ public:
 	static constexpr auto MAIN_IO_LABEL_FXOUT        = "main_IO_label_fxOut";
 	static constexpr auto MAIN_IO_LABEL_FXIN         = "main_IO_label_fxIn";
 	static constexpr auto MAIN_IO_LABEL_MIDIACTIVITY = "main_IO_label_midiActivity";
+	static constexpr auto MAIN_IO_LABEL_DSPLOAD      = "main_IO_label_dspLoad";
 
 	static constexpr auto MAIN_TIMER_LABEL_BPM        = "main_mainTimer_label_bpm";
 	static constexpr auto MAIN_TIMER_LABEL_METER      = "main_mainTimer_label_meter";
@@ -141,6 +147,7 @@ public:
 
 	static constexpr auto MAIN_CHANNEL_NOSAMPLE           = "main_channel_noSample";
 	static constexpr auto MAIN_CHANNEL_SAMPLENOTFOUND     = "main_channel_sampleNotFound";
+	static constexpr auto MAIN_CHANNEL_LOADING            = "main_channel_loading";
 	static constexpr auto MAIN_CHANNEL_LABEL_PLAY         = "main_channel_label_play";
 	static constexpr auto MAIN_CHANNEL_LABEL_ARM          = "main_channel_label_arm";
 	static constexpr auto MAIN_CHANNEL_LABEL_STATUS       = "main_channel_label_status";
@@ -151,6 +158,7 @@ public:
 	static constexpr auto MAIN_CHANNEL_LABEL_FX           = "main_channel_label_fx";
 	static constexpr auto MAIN_CHANNEL_LABEL_VOLUME       = "main_channel_label_volume";
 	static constexpr auto MAIN_CHANNEL_LABEL_MIDIACTIVITY = "main_channel_label_midiActivity";
+	static constexpr auto MAIN_CHANNEL_LABEL_CPU          = "main_channel_label_cpu";
 
 	static constexpr auto MAIN_CHANNEL_MENU_INPUTMONITOR           = "main_channel_menu_inputMonitor";
 	static constexpr auto MAIN_CHANNEL_MENU_OVERDUBPROTECTION      = "main_channel_menu_overdubProtection";
@@ -188,6 +196,8 @@ public:
 	static constexpr auto PLUGINLIST_TITLE_CHANNEL   = "pluginList_title_channel";
 	static constexpr auto PLUGINLIST_ADDPLUGIN       = "pluginList_addPlugin";
 	static constexpr auto PLUGINLIST_NOPROGRAMS      = "pluginList_noPrograms";
+	static constexpr auto PLUGINLIST_CPU             = "pluginList_cpu";
+	static constexpr auto PLUGINLIST_LABEL_CPU       = "pluginList_label_cpu";
 
 	static constexpr auto CHANNELNAME_TITLE = "channelName_title";
 
@@ -230,9 +240,11 @@ public:
 
 	static constexpr auto BROWSER_SHOWHIDDENFILES = "browser_showHiddenFiles";
 	static constexpr auto BROWSER_OPENPROJECT     = "browser_openProject";
+	static constexpr auto BROWSER_QUEUEPROJECT    = "browser_queueProject";
 	static constexpr auto BROWSER_SAVEPROJECT     = "browser_saveProject";
 	static constexpr auto BROWSER_OPENSAMPLE      = "browser_openSample";
 	static constexpr auto BROWSER_SAVESAMPLE      = "browser_saveSample";
+	static constexpr auto BROWSER_RENDERPROJECT   = "browser_renderProject";
 	static constexpr auto BROWSER_OPENPLUGINSDIR  = "browser_openPluginsDir";
 
 	static constexpr auto MIDIINPUT_MASTER_TITLE           = "midiInput_master_title";
@@ -292,6 +304,7 @@ public:
 	static constexpr auto CONFIG_AUDIO_RESAMPLING_SINCBASIC  = "config_audio_reseampling_sincBasic";
 	static constexpr auto CONFIG_AUDIO_RESAMPLING_ZEROORDER  = "config_audio_reseampling_zeroOrder";
 	static constexpr auto CONFIG_AUDIO_RESAMPLING_LINEAR     = "config_audio_reseampling_linear";
+	static constexpr auto CONFIG_AUDIO_RESAMPLING_CUBIC      = "config_audio_reseampling_cubic";
 	static constexpr auto CONFIG_AUDIO_NODEVICESFOUND        = "config_audio_noDevicesFound";
 
 	static constexpr auto CONFIG_MIDI_TITLE           = "config_midi_title";
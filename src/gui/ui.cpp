@@ -45,6 +45,7 @@ namespace giada::v
 Ui::Ui()
 : m_updater(*this)
 , m_blinker(0)
+, m_headless(false)
 {
 }
 
@@ -132,6 +133,21 @@ void Ui::init(int argc, char** argv, const m::Conf& conf, const std::string& pat
 
 /* -------------------------------------------------------------------------- */
 
+void Ui::initHeadless(const m::Conf& conf)
+{
+	model.load(conf);
+	m_headless = true;
+}
+
+/* -------------------------------------------------------------------------- */
+
+bool Ui::isHeadless() const
+{
+	return m_headless;
+}
+
+/* -------------------------------------------------------------------------- */
+
 void Ui::reset()
 {
 	mainWindow->setTitle(G_DEFAULT_PATCH_NAME);
@@ -170,6 +186,11 @@ void Ui::startUpdater() { m_updater.start(); }
 
 bool Ui::pumpEvent(const Updater::Event& e)
 {
+	/* Headless mode: the Updater loop is not running, events would pile up in
+	the queue forever. */
+
+	if (m_headless)
+		return false;
 	return m_updater.pumpEvent(e);
 }
 
@@ -186,10 +207,12 @@ void Ui::refresh()
 
 	m_blinker = (m_blinker + 1) % BLINK_RATE;
 
-	/* Refresh Sample Editor and Action Editor for dynamic playhead. */
+	/* Refresh Sample Editor and Action Editor for dynamic playhead, Plug-in
+	list for CPU usage. */
 
 	refreshSubWindow(WID_SAMPLE_EDITOR);
 	refreshSubWindow(WID_ACTION_EDITOR);
+	refreshSubWindow(WID_FX_LIST);
 }
 
 /* -------------------------------------------------------------------------- */
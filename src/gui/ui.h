@@ -71,6 +71,15 @@ public:
 	void load(const m::Patch&);
 
 	void init(int argc, char** argv, const m::Conf&, const std::string& patchName, bool isAudioReady);
+
+	/* initHeadless
+	Initializes the UI without any window, for headless mode. Events pumped by
+	other threads are discarded from now on, as there is no one to process 
+	them. */
+
+	void initHeadless(const m::Conf&);
+
+	bool isHeadless() const;
 	void reset();
 	void run();
 	void shutdown(m::Conf&);
@@ -146,6 +155,7 @@ private:
 	LangMapper m_langMapper;
 	Updater    m_updater;
 	int        m_blinker;
+	bool       m_headless;
 };
 } // namespace giada::v
 
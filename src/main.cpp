@@ -36,7 +36,6 @@ int main(int argc, char** argv)
 		return ret;
 
 	giada::m::init::startup(argc, argv);
-	giada::m::init::run();
 
-	return 0;
+	return giada::m::init::run();
 }
\ No newline at end of file
@@ -185,6 +185,12 @@ std::string getLangMapsPath()
 	return out.string();
 }
 
+std::string getResampleCachePath()
+{
+	auto out = stdfs::path(getHomePath()) / "cache" / "resampled";
+	return out.string();
+}
+
 /* -------------------------------------------------------------------------- */
 
 bool createConfigFolder()
@@ -48,6 +48,7 @@ std::string getCurrentPath();
 std::string getHomePath();
 std::string getMidiMapsPath();
 std::string getLangMapsPath();
+std::string getResampleCachePath();
 
 /* createConfigFolder
 Creates the configuration folder that holds the .conf file. */
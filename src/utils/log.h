@@ -34,6 +34,7 @@
 #include <fmt/core.h>
 #include <fmt/ostream.h>
 #include <fstream>
+#include <mutex>
 #include <string>
 #include <type_traits>
 #include <utility>
@@ -52,6 +53,7 @@ namespace giada::u::log
 {
 inline std::ofstream file;
 inline int           mode;
+inline std::mutex    mutex; // Messages can come from multiple threads
 
 /* init
 Initializes logger. Mode defines where to write the output: LOG_MODE_STDOUT,
@@ -66,6 +68,7 @@ static void print(const char* format, Args&&... args)
 {
 	if (mode == LOG_MODE_MUTE)
 		return;
+	std::scoped_lock lock(mutex);
 	if (mode == LOG_MODE_FILE && file.is_open())
 		fmt::print(file, fmt::runtime(format), args...);
 	else
@@ -130,6 +130,25 @@ std::string toString(RtAudio::Api api)
 
 /* -------------------------------------------------------------------------- */
 
+std::string toString(m::kernels::InstructionSet set)
+{
+	switch (set)
+	{
+	case m::kernels::InstructionSet::SCALAR:
+		return "scalar";
+	case m::kernels::InstructionSet::SSE2:
+		return "SSE2";
+	case m::kernels::InstructionSet::AVX2:
+		return "AVX2";
+	case m::kernels::InstructionSet::NEON:
+		return "NEON";
+	default:
+		return "(unknown)";
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
 float toFloat(const std::string& s)
 {
 	try
@@ -29,6 +29,7 @@
 #ifndef G_UTILS_STRING_H
 #define G_UTILS_STRING_H
 
+#include "core/audioKernels.h"
 #include "core/types.h"
 #include "deps/rtaudio/RtAudio.h"
 #include <sstream>
@@ -51,6 +52,7 @@ bool contains(const std::string&, char);
 
 std::string toString(Thread);
 std::string toString(RtAudio::Api);
+std::string toString(m::kernels::InstructionSet);
 
 /* toFloat, toInt
 Convert a string to numbers. Like std::stof, std::stoi, just safer. */
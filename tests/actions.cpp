@@ -0,0 +1,71 @@
+#include "src/core/model/actions.h"
+#include "src/core/actions/action.h"
+#include "src/core/midiEvent.h"
+#include "src/core/types.h"
+#include <catch2/catch.hpp>
+
+TEST_CASE("model::Actions")
+{
+	using namespace giada;
+	using namespace giada::m;
+
+	const ID        channelId = 1;
+	const MidiEvent e1        = MidiEvent::makeFrom3Bytes(MidiEvent::CHANNEL_NOTE_ON, 0x00, 0x00, 0);
+	const MidiEvent e2        = MidiEvent::makeFrom3Bytes(MidiEvent::CHANNEL_NOTE_OFF, 0x00, 0x00, 0);
+
+	model::Actions actions;
+	actions.rec(channelId, /*frame=*/10, e1);
+
+	SECTION("Test copies share storage")
+	{
+		model::Actions copy = actions;
+
+		REQUIRE(&copy.getAll() == &actions.getAll());
+	}
+
+	SECTION("Test copy-on-write")
+	{
+		model::Actions copy = actions;
+		copy.rec(channelId, /*frame=*/20, e2);
+
+		REQUIRE(&copy.getAll() != &actions.getAll());
+		REQUIRE(copy.getAll().size() == 2);
+		REQUIRE(actions.getAll().size() == 1);
+		REQUIRE(actions.getActionsOnFrame(20) == nullptr);
+
+		copy.clearChannel(channelId);
+
+		REQUIRE(copy.hasActions(channelId) == false);
+		REQUIRE(actions.hasActions(channelId) == true);
+	}
+
+	SECTION("Test playback index")
+	{
+		actions.rec(channelId, /*frame=*/30, e2);
+		actions.rec(channelId, /*frame=*/30, e1);
+
+		const model::Actions::Playback& playback = actions.getPlayback();
+
+		REQUIRE(playback.actions.size() == 3);
+		REQUIRE(playback.keyFrames.size() == 2);
+		REQUIRE(playback.keyFrames[0].frame == 10);
+		REQUIRE(playback.keyFrames[1].frame == 30);
+		REQUIRE(playback.getActions(playback.keyFrames[1]).size() == 2);
+		REQUIRE(playback.getActions(playback.keyFrames[1])[0].event.getRaw() == e2.getRaw());
+
+		actions.rec(/*channelId=*/2, /*frame=*/30, e1);
+
+		const model::Actions::Playback& playback2 = actions.getPlayback();
+		const std::span<const Action>   frame30   = playback2.getActions(playback2.keyFrames[1]);
+
+		REQUIRE(frame30.size() == 3);
+		REQUIRE(model::Actions::Playback::getActionsOnChannel(frame30, channelId).size() == 2);
+		REQUIRE(model::Actions::Playback::getActionsOnChannel(frame30, 2).size() == 1);
+		REQUIRE(model::Actions::Playback::getActionsOnChannel(frame30, 3).empty());
+
+		actions.clearAll();
+
+		REQUIRE(actions.getPlayback().actions.empty());
+		REQUIRE(actions.getPlayback().keyFrames.empty());
+	}
+}
@@ -0,0 +1,197 @@
+#include "../src/core/audioKernels.h"
+#include "../src/core/const.h"
+#include "../src/core/types.h"
+#include "deps/mcl-audio-buffer/src/audioBuffer.hpp"
+#include <catch2/catch.hpp>
+#include <cmath>
+
+TEST_CASE("kernels")
+{
+	using namespace giada;
+	using namespace giada::m;
+
+	/* Odd number of frames, to exercise the scalar tail of vector kernels. */
+
+	static const int BUFFER_SIZE = 67;
+
+	const kernels::InstructionSet set = GENERATE(
+	    kernels::InstructionSet::SCALAR,
+	    kernels::InstructionSet::SSE2,
+	    kernels::InstructionSet::AVX2,
+	    kernels::InstructionSet::NEON);
+
+	const kernels::InstructionSet defaultSet = kernels::getInstructionSet();
+
+	if (!kernels::setInstructionSet(set))
+		return;
+
+	mcl::AudioBuffer a(BUFFER_SIZE, G_MAX_IO_CHANS);
+	mcl::AudioBuffer b(BUFFER_SIZE, G_MAX_IO_CHANS);
+
+	for (int i = 0; i < BUFFER_SIZE; i++)
+	{
+		a[i][0] = std::sin(i * 0.1f);
+		a[i][1] = std::cos(i * 0.1f);
+		b[i][0] = 0.5f;
+		b[i][1] = -0.25f;
+	}
+
+	SECTION("Test sum")
+	{
+		mcl::AudioBuffer expected = a;
+		for (int i = 0; i < BUFFER_SIZE; i++)
+		{
+			expected[i][0] += b[i][0] * 0.8f * 0.3f;
+			expected[i][1] += b[i][1] * 0.8f * 0.7f;
+		}
+
+		kernels::sum(a, b, 0.8f, 0.3f, 0.7f);
+
+		for (int i = 0; i < BUFFER_SIZE; i++)
+		{
+			REQUIRE(a[i][0] == Approx(expected[i][0]));
+			REQUIRE(a[i][1] == Approx(expected[i][1]));
+		}
+	}
+
+	SECTION("Test peak")
+	{
+		a[BUFFER_SIZE - 1][1] = -2.0f; // In the tail
+		a[10][0]              = 1.5f;
+
+		const Peak peak = kernels::getPeak(a);
+
+		REQUIRE(peak.left == 1.5f);
+		REQUIRE(peak.right == 2.0f);
+	}
+
+	SECTION("Test finalize")
+	{
+		a[20][0] = 4.0f;
+
+		const Peak peak = kernels::finalize(a, nullptr, 2.0f, /*limit=*/true);
+
+		REQUIRE(a[20][0] == 1.0f);
+		REQUIRE(peak.left == 1.0f);
+		REQUIRE(peak.right == 1.0f);
+		for (int i = 0; i < BUFFER_SIZE; i++)
+		{
+			REQUIRE(a[i][0] <= 1.0f);
+			REQUIRE(a[i][0] >= -1.0f);
+		}
+	}
+
+	SECTION("Test finalize with input")
+	{
+		const Peak peak = kernels::finalize(b, &b, 1.0f, /*limit=*/false);
+
+		REQUIRE(b[0][0] == 1.0f);
+		REQUIRE(b[0][1] == -0.5f);
+		REQUIRE(peak.left == 1.0f);
+		REQUIRE(peak.right == 0.5f);
+	}
+
+	SECTION("Test interpolate")
+	{
+		/* Odd number of taps, to exercise the scalar tail. */
+
+		static const int TAPS = 11;
+
+		float rowA[TAPS * 2];
+		float rowB[TAPS * 2];
+		for (int i = 0; i < TAPS; i++)
+		{
+			rowA[i * 2] = rowA[i * 2 + 1] = 0.1f * i;
+			rowB[i * 2] = rowB[i * 2 + 1] = 1.0f - 0.05f * i;
+		}
+
+		float expected[2] = {0.0f, 0.0f};
+		for (int i = 0; i < TAPS; i++)
+		{
+			const float c = rowA[i * 2] + (rowB[i * 2] - rowA[i * 2]) * 0.25f;
+			expected[0] += a[i][0] * c;
+			expected[1] += a[i][1] * c;
+		}
+
+		float out[2];
+		kernels::interpolate(a[0], rowA, rowB, 0.25f, TAPS, out);
+
+		REQUIRE(out[0] == Approx(expected[0]));
+		REQUIRE(out[1] == Approx(expected[1]));
+	}
+
+	SECTION("Test interpolateMono")
+	{
+		/* Odd number of taps, to exercise the scalar tail. */
+
+		static const int TAPS = 19;
+
+		float mono[TAPS];
+		float rowA[TAPS * 2];
+		float rowB[TAPS * 2];
+		for (int i = 0; i < TAPS; i++)
+		{
+			mono[i]     = std::sin(i * 0.1f);
+			rowA[i * 2] = rowA[i * 2 + 1] = 0.1f * i;
+			rowB[i * 2] = rowB[i * 2 + 1] = 1.0f - 0.05f * i;
+		}
+
+		float expected = 0.0f;
+		for (int i = 0; i < TAPS; i++)
+			expected += mono[i] * (rowA[i * 2] + (rowB[i * 2] - rowA[i * 2]) * 0.25f);
+
+		float out[1];
+		kernels::interpolateMono(mono, rowA, rowB, 0.25f, TAPS, out);
+
+		REQUIRE(out[0] == Approx(expected));
+	}
+
+	SECTION("Test upmix")
+	{
+		mcl::AudioBuffer mono(BUFFER_SIZE, 1);
+		for (int i = 0; i < BUFFER_SIZE; i++)
+			mono[i][0] = std::sin(i * 0.1f);
+
+		kernels::upmix(mono[0], BUFFER_SIZE, b[0]);
+
+		for (int i = 0; i < BUFFER_SIZE; i++)
+		{
+			REQUIRE(b[i][0] == mono[i][0]);
+			REQUIRE(b[i][1] == mono[i][0]);
+		}
+	}
+
+	SECTION("Test pcm16ToFloat")
+	{
+		int16_t pcm[BUFFER_SIZE];
+		for (int i = 0; i < BUFFER_SIZE; i++)
+			pcm[i] = static_cast<int16_t>((i - BUFFER_SIZE / 2) * 977);
+
+		float out[BUFFER_SIZE];
+		kernels::pcm16ToFloat(pcm, BUFFER_SIZE, out);
+
+		for (int i = 0; i < BUFFER_SIZE; i++)
+			REQUIRE(out[i] == pcm[i] / 32768.0f);
+	}
+
+	SECTION("Test pcm24ToFloat")
+	{
+		int32_t expected[BUFFER_SIZE];
+		uint8_t pcm[BUFFER_SIZE * 3];
+		for (int i = 0; i < BUFFER_SIZE; i++)
+		{
+			expected[i]    = (i - BUFFER_SIZE / 2) * 250007;
+			pcm[i * 3]     = expected[i] & 0xFF;
+			pcm[i * 3 + 1] = (expected[i] >> 8) & 0xFF;
+			pcm[i * 3 + 2] = (expected[i] >> 16) & 0xFF;
+		}
+
+		float out[BUFFER_SIZE];
+		kernels::pcm24ToFloat(pcm, BUFFER_SIZE, out);
+
+		for (int i = 0; i < BUFFER_SIZE; i++)
+			REQUIRE(out[i] == expected[i] / 8388608.0f);
+	}
+
+	kernels::setInstructionSet(defaultSet);
+}
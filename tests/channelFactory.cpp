@@ -25,6 +25,9 @@ TEST_CASE("channelFactory")
 
 		SECTION("test clone")
 		{
+			data.channel.volume = 0.3f;
+			data.channel.pan    = 0.2f;
+
 			channelFactory::Data clone = channelFactory::create(data.channel, /*bufferSize=*/1024, Resampler::Quality::LINEAR);
 
 			REQUIRE(clone.channel.id != data.channel.id); // Clone must have new ID
@@ -39,6 +42,13 @@ TEST_CASE("channelFactory")
 			REQUIRE(clone.channel.hasActions == data.channel.hasActions);
 			REQUIRE(clone.channel.name == data.channel.name);
 			REQUIRE(clone.channel.height == data.channel.height);
+
+			/* Continuous parameters must be mirrored into the new shared
+			state, as the audio thread reads them from there. */
+
+			REQUIRE(clone.shared->volume.load() == data.channel.volume);
+			REQUIRE(clone.shared->pan.load() == data.channel.pan);
+			REQUIRE(clone.shared->pitch.load() == data.channel.samplePlayer->pitch);
 		}
 	}
 }
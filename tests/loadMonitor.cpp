@@ -0,0 +1,66 @@
+#include "../src/core/loadMonitor.h"
+#include <catch2/catch.hpp>
+
+TEST_CASE("LoadMonitor")
+{
+	using namespace giada::m;
+
+	LoadMonitor monitor;
+
+	SECTION("Test empty stats")
+	{
+		const LoadMonitor::Stats stats = monitor.getStats();
+
+		REQUIRE(stats.blocks == 0);
+		REQUIRE(stats.minLoad == 0.0f);
+		REQUIRE(stats.avgLoad == 0.0f);
+		REQUIRE(stats.maxLoad == 0.0f);
+	}
+
+	SECTION("Test record")
+	{
+		monitor.record(0.25, 1.0);
+		monitor.record(0.75, 1.0);
+		monitor.record(1.5, 1.0);
+
+		const LoadMonitor::Stats stats = monitor.getStats();
+
+		REQUIRE(stats.blocks == 3);
+		REQUIRE(stats.load == Approx(1.5f));
+		REQUIRE(stats.minLoad == Approx(0.25f));
+		REQUIRE(stats.avgLoad == Approx(2.5f / 3));
+		REQUIRE(stats.maxLoad == Approx(1.5f));
+		REQUIRE(stats.overloads == 1);
+		REQUIRE(stats.histogram[2] == 1);
+		REQUIRE(stats.histogram[7] == 1);
+		REQUIRE(stats.histogram[LoadMonitor::HISTOGRAM_SIZE - 1] == 1);
+	}
+
+	SECTION("Test xruns")
+	{
+		monitor.recordXrun(/*inputOverflow=*/true, /*outputUnderflow=*/false);
+		monitor.recordXrun(/*inputOverflow=*/true, /*outputUnderflow=*/true);
+
+		const LoadMonitor::Stats stats = monitor.getStats();
+
+		REQUIRE(stats.overflows == 2);
+		REQUIRE(stats.underflows == 1);
+	}
+
+	SECTION("Test reset")
+	{
+		monitor.record(0.5, 1.0);
+		monitor.recordXrun(true, true);
+		monitor.reset();
+
+		REQUIRE(monitor.getStats().blocks == 1); // Not cleared until next block
+
+		monitor.record(0.1, 1.0);
+
+		const LoadMonitor::Stats stats = monitor.getStats();
+
+		REQUIRE(stats.blocks == 1);
+		REQUIRE(stats.maxLoad == Approx(0.1f));
+		REQUIRE(stats.overflows == 0);
+	}
+}
@@ -0,0 +1,235 @@
+#include "../src/core/model/model.h"
+#include "../src/core/const.h"
+#include "../src/core/patch.h"
+#include "../src/core/plugins/pluginManager.h"
+#include "../src/core/types.h"
+#include <catch2/catch.hpp>
+#include <chrono>
+#include <thread>
+
+TEST_CASE("Model preload")
+{
+	using namespace giada;
+	using namespace giada::m;
+
+	constexpr int   SAMPLE_RATE = 44100;
+	constexpr int   BUFFER_SIZE = 1024;
+	constexpr float PATCH_BPM   = 90.0f;
+
+	model::Model  model;
+	PluginManager pluginManager;
+
+	model.registerThread(Thread::MAIN, /*realtime=*/false);
+	model.reset();
+	model.get().sequencer.recomputeFrames(SAMPLE_RATE);
+	model.swap(model::SwapType::NONE);
+
+	Patch patch;
+	patch.bpm        = PATCH_BPM;
+	patch.samplerate = SAMPLE_RATE;
+	patch.waves      = {{1, TEST_RESOURCES_DIR "test.wav"}};
+
+	auto preload = [&](model::SwitchPoint switchPoint) {
+		model.preload(patch, pluginManager, SAMPLE_RATE, BUFFER_SIZE, Resampler::Quality::LINEAR,
+		    switchPoint, [](float) {});
+	};
+
+	auto waitLoaded = [&model]() {
+		while (!model.isPreloadLoaded())
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	};
+
+	auto setRunning = [&model]() {
+		model.get().sequencer.status = SeqStatus::RUNNING;
+		model.swap(model::SwapType::NONE);
+	};
+
+	/* Moves the current frame 'offset' frames away from the end of the loop,
+	then asks for the Layout to render in the next block. */
+
+	auto renderAt = [&model](Frame offset) -> const model::Layout& {
+		const model::Sequencer& sequencer = model.get().sequencer;
+		sequencer.a_setCurrentFrame(sequencer.framesInLoop - offset, SAMPLE_RATE);
+		return model.getLayoutToRender_RT(model.get(), BUFFER_SIZE);
+	};
+
+	REQUIRE(model.getPreloaded_RT() == nullptr);
+
+	SECTION("Test arm and commit while stopped")
+	{
+		preload(model::SwitchPoint::LOOP);
+
+		/* Still loading: the audio thread doesn't see it. */
+
+		REQUIRE(model.getPreloaded_RT() == nullptr);
+		REQUIRE(model.isPreloadReady() == false);
+		REQUIRE(model.commitPreload() == false);
+
+		waitLoaded();
+		model.armPreload();
+
+		REQUIRE(model.getPreloaded_RT() != nullptr);
+		REQUIRE(&model.getLayoutToRender_RT(model.get(), BUFFER_SIZE) == &model.get());
+
+		/* Sequencer stopped: no beat to wait for. Configuration changed in the
+		meantime must survive the commit. */
+
+		model.get().behaviors.chansStopOnSeqHalt = true;
+
+		REQUIRE(model.isPreloadReady() == true);
+		REQUIRE(model.commitPreload() == true);
+		REQUIRE(model.getPreloaded_RT() == nullptr);
+		REQUIRE(model.get().sequencer.bpm == PATCH_BPM);
+		REQUIRE(model.get().behaviors.chansStopOnSeqHalt == true);
+		REQUIRE(model.getAllWaves().size() == 1);
+	}
+
+	SECTION("Test switch on a loop boundary")
+	{
+		setRunning();
+		preload(model::SwitchPoint::LOOP);
+		waitLoaded();
+		model.armPreload();
+
+		/* Halfway through the loop: keep rendering the current project. */
+
+		const Frame half = model.get().sequencer.framesInLoop / 2;
+
+		REQUIRE(&renderAt(half) == &model.get());
+		REQUIRE(model.isPreloadReady() == false);
+		REQUIRE(model.commitPreload() == false);
+
+		/* Never during a recording. */
+
+		model.get().mixer.isRecordingActions = true;
+		REQUIRE(&renderAt(BUFFER_SIZE / 4) == &model.get());
+		model.get().mixer.isRecordingActions = false;
+
+		/* Close enough to the end of the loop: switch, starting over. */
+
+		const model::Layout* preloaded = model.getPreloaded_RT();
+
+		REQUIRE(&renderAt(BUFFER_SIZE / 4) == preloaded);
+		REQUIRE(preloaded->sequencer.a_getCurrentFrame() == 0);
+
+		/* From now on the preloaded Layout is rendered, wherever the sequencer
+		is. */
+
+		REQUIRE(&renderAt(half) == preloaded);
+		REQUIRE(model.isPreloadReady() == true);
+		REQUIRE(model.commitPreload() == true);
+		REQUIRE(model.getPreloaded_RT() == nullptr);
+		REQUIRE(model.get().sequencer.bpm == PATCH_BPM);
+		REQUIRE(model.get().sequencer.isRunning() == true);
+	}
+
+	SECTION("Test discard")
+	{
+		SECTION("Test discard while loading")
+		{
+			preload(model::SwitchPoint::LOOP);
+			model.discardPreload();
+
+			REQUIRE(model.getPreloaded_RT() == nullptr);
+			REQUIRE(model.isPreloadLoaded() == false);
+		}
+
+		SECTION("Test discard while armed")
+		{
+			preload(model::SwitchPoint::LOOP);
+			waitLoaded();
+			model.armPreload();
+			model.discardPreload();
+
+			REQUIRE(model.getPreloaded_RT() == nullptr);
+			REQUIRE(model.isPreloadReady() == false);
+		}
+
+		SECTION("Test discard once switched")
+		{
+			setRunning();
+			preload(model::SwitchPoint::BAR);
+			waitLoaded();
+			model.armPreload();
+
+			REQUIRE(&renderAt(0) == model.getPreloaded_RT());
+
+			model.discardPreload();
+
+			REQUIRE(model.getPreloaded_RT() == nullptr);
+			REQUIRE(&model.getLayoutToRender_RT(model.get(), BUFFER_SIZE) == &model.get());
+		}
+
+		/* Nothing left behind: the current project is untouched, and a new
+		preload can start over. */
+
+		REQUIRE(model.get().sequencer.bpm == G_DEFAULT_BPM);
+		REQUIRE(model.getAllWaves().size() == 0);
+
+		model.discardPreload(); // No-op
+
+		preload(model::SwitchPoint::LOOP);
+		waitLoaded();
+		model.armPreload();
+		model.get().sequencer.status = SeqStatus::STOPPED;
+
+		REQUIRE(model.commitPreload() == true);
+		REQUIRE(model.get().sequencer.bpm == PATCH_BPM);
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+TEST_CASE("isCloseToSwitchPoint")
+{
+	using namespace giada;
+	using namespace giada::m;
+
+	constexpr Frame BUFFER_SIZE = 100;
+
+	model::Model model;
+
+	model.registerThread(Thread::MAIN, /*realtime=*/false);
+	model.reset();
+
+	model::Sequencer& sequencer = model.get().sequencer;
+
+	sequencer.framesInBar  = 1000;
+	sequencer.framesInLoop = 4000;
+
+	auto isClose = [&sequencer](Frame frame, model::SwitchPoint switchPoint) {
+		sequencer.a_setCurrentFrame(frame, G_DEFAULT_SAMPLERATE);
+		return model::isCloseToSwitchPoint(sequencer, switchPoint, BUFFER_SIZE);
+	};
+
+	SECTION("Test bar boundaries")
+	{
+		REQUIRE(isClose(0, model::SwitchPoint::BAR) == true);
+		REQUIRE(isClose(1000, model::SwitchPoint::BAR) == true);
+		REQUIRE(isClose(1050, model::SwitchPoint::BAR) == true); // Half a block after
+		REQUIRE(isClose(1051, model::SwitchPoint::BAR) == false);
+		REQUIRE(isClose(1949, model::SwitchPoint::BAR) == false);
+		REQUIRE(isClose(1950, model::SwitchPoint::BAR) == true); // Half a block before
+		REQUIRE(isClose(2500, model::SwitchPoint::BAR) == false);
+	}
+
+	SECTION("Test loop boundaries")
+	{
+		REQUIRE(isClose(0, model::SwitchPoint::LOOP) == true);
+		REQUIRE(isClose(1000, model::SwitchPoint::LOOP) == false); // Bar, not loop
+		REQUIRE(isClose(3949, model::SwitchPoint::LOOP) == false);
+		REQUIRE(isClose(3950, model::SwitchPoint::LOOP) == true);
+		REQUIRE(isClose(4000, model::SwitchPoint::LOOP) == true);
+		REQUIRE(isClose(4050, model::SwitchPoint::LOOP) == true);
+		REQUIRE(isClose(4051, model::SwitchPoint::LOOP) == false);
+	}
+
+	SECTION("Test empty period")
+	{
+		sequencer.framesInBar  = 0;
+		sequencer.framesInLoop = -1;
+
+		REQUIRE(isClose(1234, model::SwitchPoint::BAR) == true);
+		REQUIRE(isClose(1234, model::SwitchPoint::LOOP) == true);
+	}
+}
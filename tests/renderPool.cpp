@@ -0,0 +1,58 @@
+#include "../src/core/renderPool.h"
+#include <catch2/catch.hpp>
+#include <chrono>
+#include <vector>
+
+TEST_CASE("RenderPool")
+{
+	using namespace giada::m;
+
+	RenderPool pool;
+
+	std::vector<int> jobs(64, 0);
+	auto             job = [&jobs](std::size_t i) { jobs[i]++; };
+
+	SECTION("Test run without workers")
+	{
+		pool.run(jobs.size(), job);
+
+		REQUIRE(pool.countWorkers() == 0);
+		for (int j : jobs)
+			REQUIRE(j == 1);
+	}
+
+	SECTION("Test run with workers")
+	{
+		pool.start(3);
+
+		REQUIRE(pool.countWorkers() == 3);
+
+		for (int i = 0; i < 100; i++)
+			pool.run(jobs.size(), job);
+
+		for (int j : jobs)
+			REQUIRE(j == 100);
+
+		pool.stop();
+
+		REQUIRE(pool.countWorkers() == 0);
+	}
+
+	SECTION("Test run with spinning workers")
+	{
+		pool.start(3, std::chrono::milliseconds(1));
+
+		for (int i = 0; i < 100; i++)
+			pool.run(jobs.size(), job);
+
+		for (int j : jobs)
+			REQUIRE(j == 100);
+
+		pool.stop();
+	}
+
+	SECTION("Test thread index")
+	{
+		REQUIRE(RenderPool::getThreadIndex() == 0);
+	}
+}
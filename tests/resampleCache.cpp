@@ -0,0 +1,63 @@
+#include "../src/core/resampleCache.h"
+#include "deps/mcl-audio-buffer/src/audioBuffer.hpp"
+#include <catch2/catch.hpp>
+#include <filesystem>
+
+TEST_CASE("resampleCache")
+{
+	using namespace giada;
+	using namespace giada::m;
+
+	static const int FRAMES = 1024;
+
+	const std::string dir = (std::filesystem::temp_directory_path() / "giada-resample-cache-test").string();
+
+	std::error_code ec;
+	std::filesystem::remove_all(dir, ec);
+
+	SECTION("test key")
+	{
+		const std::string key = resampleCache::makeKey(TEST_RESOURCES_DIR "test.wav", 44100, Resampler::Quality::SINC_BEST);
+
+		REQUIRE(key != "");
+		REQUIRE(key == resampleCache::makeKey(TEST_RESOURCES_DIR "test.wav", 44100, Resampler::Quality::SINC_BEST));
+		REQUIRE(key != resampleCache::makeKey(TEST_RESOURCES_DIR "test.wav", 48000, Resampler::Quality::SINC_BEST));
+		REQUIRE(key != resampleCache::makeKey(TEST_RESOURCES_DIR "test.wav", 44100, Resampler::Quality::LINEAR));
+		REQUIRE(resampleCache::makeKey(TEST_RESOURCES_DIR "missing.wav", 44100, Resampler::Quality::LINEAR) == "");
+	}
+
+	SECTION("test store and load")
+	{
+		const std::string key = resampleCache::makeKey(TEST_RESOURCES_DIR "test.wav", 44100, Resampler::Quality::LINEAR);
+
+		REQUIRE(resampleCache::load(dir, key) == nullptr);
+
+		mcl::AudioBuffer buffer(FRAMES, 2);
+		for (int i = 0; i < FRAMES; i++)
+		{
+			buffer[i][0] = i / static_cast<float>(FRAMES);
+			buffer[i][1] = -i / static_cast<float>(FRAMES);
+		}
+
+		resampleCache::store(dir, key, buffer);
+
+		std::shared_ptr<mcl::AudioBuffer> cached = resampleCache::load(dir, key);
+
+		REQUIRE(cached != nullptr);
+		REQUIRE(cached->countFrames() == FRAMES);
+		REQUIRE(cached->countChannels() == 2);
+		for (int i = 0; i < FRAMES; i++)
+		{
+			REQUIRE((*cached)[i][0] == buffer[i][0]);
+			REQUIRE((*cached)[i][1] == buffer[i][1]);
+		}
+
+		/* Changes to a loaded entry are private. */
+
+		(*cached)[0][0] = 1.0f;
+
+		REQUIRE((*resampleCache::load(dir, key))[0][0] == 0.0f);
+	}
+
+	std::filesystem::remove_all(dir, ec);
+}
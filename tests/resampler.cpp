@@ -0,0 +1,198 @@
+#include "../src/core/resampler.h"
+#include "../src/core/const.h"
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <numbers>
+#include <vector>
+
+TEST_CASE("Resampler")
+{
+	using namespace giada::m;
+
+	constexpr long INPUT_LENGTH = 4096;
+	constexpr int  CHANNELS     = G_MAX_IO_CHANS;
+
+	const std::vector<Resampler::Quality> qualities = {
+	    Resampler::Quality::ZERO_ORDER_HOLD,
+	    Resampler::Quality::LINEAR,
+	    Resampler::Quality::CUBIC,
+	    Resampler::Quality::SINC_FASTEST,
+	    Resampler::Quality::SINC_MEDIUM,
+	    Resampler::Quality::SINC_BEST};
+
+	/* Returns 'frames' frames of a sine wave with 'channels' channels, at
+	'frequency' cycles per frame. */
+
+	auto makeSine = [](long frames, int channels, double frequency) {
+		std::vector<float> out(frames * channels);
+		for (long i = 0; i < frames; i++)
+			for (int c = 0; c < channels; c++)
+				out[i * channels + c] = static_cast<float>(std::sin(2.0 * std::numbers::pi * frequency * i));
+		return out;
+	};
+
+	/* Resamples the whole 'input' in blocks of 'blockSize' output frames, moving
+	forward by the frames used at each step, as WaveReader does. */
+
+	auto render = [](Resampler::Quality quality, std::vector<float>& input, int inputChannels, float ratio,
+	                  long blockSize) {
+		Resampler          resampler(quality, CHANNELS);
+		std::vector<float> out;
+		std::vector<float> block(blockSize * CHANNELS);
+		const long         inputLength = static_cast<long>(input.size()) / inputChannels;
+
+		for (long pos = 0; pos < inputLength;)
+		{
+			const Resampler::Result res = resampler.process(input.data(), pos, inputLength, inputChannels,
+			    block.data(), blockSize, ratio);
+			out.insert(out.end(), block.begin(), block.begin() + res.generated * CHANNELS);
+			pos += res.used;
+			if (res.generated < blockSize)
+				break;
+		}
+		return out;
+	};
+
+	SECTION("Test used and generated frames")
+	{
+		std::vector<float> input = makeSine(INPUT_LENGTH, CHANNELS, 0.01);
+		std::vector<float> output(256 * CHANNELS);
+
+		for (Resampler::Quality quality : qualities)
+		{
+			/* Output full: input used is 'ratio' times the output. */
+
+			for (float ratio : {0.5f, 1.0f, 1.5f, 2.5f, 4.0f})
+			{
+				Resampler               resampler(quality, CHANNELS);
+				const Resampler::Result res = resampler.process(input.data(), 0, INPUT_LENGTH, CHANNELS,
+				    output.data(), 256, ratio);
+
+				REQUIRE(res.generated == 256);
+				REQUIRE(res.used == static_cast<long>(256 * ratio));
+			}
+
+			/* Input over: output stops short, input used stays within range. */
+
+			Resampler               resampler(quality, CHANNELS);
+			const Resampler::Result res = resampler.process(input.data(), INPUT_LENGTH - 100, INPUT_LENGTH,
+			    CHANNELS, output.data(), 256, 2.0f);
+
+			REQUIRE(res.generated == 50);
+			REQUIRE(res.used == 100);
+		}
+	}
+
+	SECTION("Test consumed frames across blocks")
+	{
+		/* Ratios exactly representable in binary: the frames used over many
+		blocks must add up to the frames generated times the ratio. */
+
+		std::vector<float> input = makeSine(INPUT_LENGTH, CHANNELS, 0.01);
+		std::vector<float> output(64 * CHANNELS);
+
+		for (float ratio : {0.75f, 1.25f, 2.5f, 3.875f})
+		{
+			Resampler resampler(Resampler::Quality::SINC_BEST, CHANNELS);
+			long      used      = 0;
+			long      generated = 0;
+
+			for (int i = 0; i < 10; i++)
+			{
+				const Resampler::Result res = resampler.process(input.data(), used, INPUT_LENGTH, CHANNELS,
+				    output.data(), 64, ratio);
+				used += res.used;
+				generated += res.generated;
+			}
+
+			REQUIRE(generated == 640);
+			REQUIRE(used == static_cast<long>(std::floor(640 * ratio)));
+		}
+	}
+
+	SECTION("Test fractional position carried across blocks")
+	{
+		/* Resampling in small blocks must give the same result as doing it in
+		one go: the fractional read position survives between calls. */
+
+		std::vector<float> input = makeSine(INPUT_LENGTH, CHANNELS, 0.01);
+
+		for (Resampler::Quality quality : qualities)
+		{
+			for (float ratio : {0.7f, 1.3f, 3.3f})
+			{
+				const std::vector<float> oneGo   = render(quality, input, CHANNELS, ratio, INPUT_LENGTH * 2);
+				const std::vector<float> inBlock = render(quality, input, CHANNELS, ratio, 37);
+
+				REQUIRE(oneGo.size() == inBlock.size());
+				for (std::size_t i = 0; i < oneGo.size(); i++)
+					REQUIRE(inBlock[i] == Approx(oneGo[i]).margin(0.0001f));
+			}
+		}
+	}
+
+	SECTION("Test mono spread")
+	{
+		/* Mono input goes to all output channels, just like the same data
+		duplicated on a stereo input. */
+
+		std::vector<float> mono   = makeSine(INPUT_LENGTH, 1, 0.01);
+		std::vector<float> stereo = makeSine(INPUT_LENGTH, CHANNELS, 0.01);
+
+		for (Resampler::Quality quality : qualities)
+		{
+			const std::vector<float> fromMono   = render(quality, mono, 1, 1.3f, 256);
+			const std::vector<float> fromStereo = render(quality, stereo, CHANNELS, 1.3f, 256);
+
+			REQUIRE(fromMono.size() == fromStereo.size());
+			for (std::size_t i = 0; i < fromMono.size(); i += CHANNELS)
+			{
+				REQUIRE(fromMono[i] == fromMono[i + 1]);
+				REQUIRE(fromMono[i] == Approx(fromStereo[i]).margin(0.0001f));
+			}
+		}
+	}
+
+	SECTION("Test quality bands")
+	{
+		/* Sinc filters get narrower as the ratio grows, one band at a time: a
+		low tone goes through untouched at any ratio, while a tone above the
+		new Nyquist frequency is removed. Only the frames far from the edges of
+		the input are checked, where the filter sees actual data. */
+
+		constexpr long EDGE = 128;
+
+		std::vector<float> low  = makeSine(INPUT_LENGTH, CHANNELS, 0.005);
+		std::vector<float> high = makeSine(INPUT_LENGTH, CHANNELS, 0.4);
+
+		for (Resampler::Quality quality : {Resampler::Quality::SINC_FASTEST, Resampler::Quality::SINC_MEDIUM,
+		         Resampler::Quality::SINC_BEST})
+		{
+			for (float ratio : {1.0f, 1.5f, 2.0f, 3.0f, G_MAX_PITCH})
+			{
+				const std::vector<float> lowOut  = render(quality, low, CHANNELS, ratio, 256);
+				const std::vector<float> highOut = render(quality, high, CHANNELS, ratio, 256);
+
+				const long first = static_cast<long>(EDGE / ratio);
+				const long last  = static_cast<long>((INPUT_LENGTH - EDGE) / ratio);
+
+				for (long i = first; i < last; i++)
+				{
+					const double expected = std::sin(2.0 * std::numbers::pi * 0.005 * i * ratio);
+					REQUIRE(lowOut[i * CHANNELS] == Approx(expected).margin(0.01));
+				}
+
+				/* At ratio 1 nothing is filtered out, the tone is still below
+				Nyquist. */
+
+				if (ratio == 1.0f)
+					continue;
+
+				float peak = 0.0f;
+				for (long i = first; i < last; i++)
+					peak = std::max(peak, std::abs(highOut[i * CHANNELS]));
+				REQUIRE(peak < 0.05f);
+			}
+		}
+	}
+}
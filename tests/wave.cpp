@@ -1,3 +1,4 @@
+#include "../src/core/const.h"
 #include "../src/core/wave.h"
 #include <catch2/catch.hpp>
 #include <memory>
@@ -43,5 +44,83 @@ TEST_CASE("Wave")
 			REQUIRE(wave.getBasename() == "sample");
 			REQUIRE(wave.getBasename(true) == "sample.wav");
 		}
+
+		SECTION("test copy-on-write")
+		{
+			wave.getWritableBuffer()[0][0] = 0.5f;
+
+			m::Wave copy(wave);
+
+			REQUIRE(&copy.getBuffer() == &wave.getBuffer());
+
+			copy.getWritableBuffer()[0][0] = 1.0f;
+
+			REQUIRE(&copy.getBuffer() != &wave.getBuffer());
+			REQUIRE(copy.getBuffer()[0][0] == 1.0f);
+			REQUIRE(wave.getBuffer()[0][0] == 0.5f);
+			REQUIRE(copy.getBuffer().countFrames() == BUFFER_SIZE);
+		}
+	}
+
+	SECTION("test compact")
+	{
+		m::Wave wave(1);
+		wave.alloc(BUFFER_SIZE, CHANNELS, SAMPLE_RATE, /*bits=*/16, "path/to/sample.wav");
+		for (int i = 0; i < BUFFER_SIZE; i++)
+		{
+			wave.getWritableBuffer()[i][0] = (i % 64) / 128.0f;
+			wave.getWritableBuffer()[i][1] = -(i % 64) / 128.0f;
+		}
+		wave.setOriginal(true); // As if decoded from file
+
+		const std::size_t floatSize = wave.getMemorySize();
+
+		REQUIRE(wave.compact());
+		REQUIRE(wave.isCompact());
+		REQUIRE(wave.getSize() == BUFFER_SIZE);
+		REQUIRE(wave.getMemorySize() == floatSize / 2);
+
+		SECTION("test read")
+		{
+			float out[4 * G_MAX_IO_CHANS];
+			wave.getCompact()->read(out, BUFFER_SIZE - 2, 4);
+
+			REQUIRE(out[0] == (BUFFER_SIZE - 2) % 64 / 128.0f);
+			REQUIRE(out[1] == -((BUFFER_SIZE - 2) % 64) / 128.0f);
+			REQUIRE(out[4] == 0.0f); // Past the end: silence
+			REQUIRE(out[7] == 0.0f);
+		}
+
+		SECTION("test expand")
+		{
+			wave.expand();
+
+			REQUIRE(!wave.isCompact());
+			REQUIRE(wave.getBuffer().countFrames() == BUFFER_SIZE);
+			for (int i = 0; i < BUFFER_SIZE; i++)
+			{
+				REQUIRE(wave.getBuffer()[i][0] == (i % 64) / 128.0f);
+				REQUIRE(wave.getBuffer()[i][1] == -(i % 64) / 128.0f);
+			}
+		}
+
+		SECTION("test float Wave is not compacted")
+		{
+			m::Wave floatWave(2);
+			floatWave.alloc(BUFFER_SIZE, CHANNELS, SAMPLE_RATE, BIT_DEPTH, "path/to/sample.wav");
+
+			REQUIRE(!floatWave.compact());
+		}
+
+		SECTION("test replaced data is not compacted")
+		{
+			m::Wave resampled(3);
+			resampled.alloc(BUFFER_SIZE, CHANNELS, SAMPLE_RATE, /*bits=*/16, "path/to/sample.wav");
+			resampled.setOriginal(true);
+			resampled.replaceData(mcl::AudioBuffer(BUFFER_SIZE, CHANNELS));
+
+			REQUIRE(!resampled.isOriginal());
+			REQUIRE(!resampled.compact());
+		}
 	}
 }
@@ -2,9 +2,13 @@
 #include "../src/core/const.h"
 #include "../src/core/resampler.h"
 #include "../src/core/wave.h"
+#include <atomic>
 #include <catch2/catch.hpp>
+#include <cmath>
 #include <memory>
 #include <samplerate.h>
+#include <stop_token>
+#include <vector>
 
 using std::string;
 using namespace giada::m;
@@ -25,11 +29,66 @@ TEST_CASE("waveFactory")
 
 		REQUIRE(res.status == G_RES_OK);
 		REQUIRE(res.wave->getRate() == G_SAMPLE_RATE);
-		REQUIRE(res.wave->getBuffer().countChannels() == G_CHANNELS);
+		REQUIRE(res.wave->getBuffer().countChannels() == 1); // Mono samples stay mono
 		REQUIRE(res.wave->isLogical() == false);
 		REQUIRE(res.wave->isEdited() == false);
 	}
 
+	SECTION("test cancelled creation")
+	{
+		std::stop_source stop;
+		stop.request_stop();
+
+		waveFactory::Result res = waveFactory::createFromFile(TEST_RESOURCES_DIR "test.wav",
+		    /*ID=*/0, /*sampleRate=*/G_SAMPLE_RATE, Resampler::Quality::LINEAR, /*streamingThreshold=*/0,
+		    stop.get_token());
+
+		REQUIRE(res.status != G_RES_OK);
+		REQUIRE(res.wave == nullptr);
+
+		std::vector<std::unique_ptr<Wave>> waves = waveFactory::deserializeWaves({{1, TEST_RESOURCES_DIR "test.wav"}},
+		    G_SAMPLE_RATE, Resampler::Quality::LINEAR, /*streamingThreshold=*/0, []() {}, stop.get_token());
+
+		REQUIRE(waves.size() == 1);
+		REQUIRE(waves[0] == nullptr);
+	}
+
+	SECTION("test bit depth")
+	{
+		waveFactory::Result pcm16 = waveFactory::createFromFile(TEST_RESOURCES_DIR "test.wav",
+		    /*ID=*/0, /*sampleRate=*/G_SAMPLE_RATE, Resampler::Quality::LINEAR);
+		waveFactory::Result pcm24 = waveFactory::createFromFile(TEST_RESOURCES_DIR "test-24.wav",
+		    /*ID=*/0, /*sampleRate=*/G_SAMPLE_RATE, Resampler::Quality::LINEAR);
+		waveFactory::Result fp32 = waveFactory::createFromFile(TEST_RESOURCES_DIR "test-float.wav",
+		    /*ID=*/0, /*sampleRate=*/G_SAMPLE_RATE, Resampler::Quality::LINEAR);
+
+		REQUIRE(pcm16.status == G_RES_OK);
+		REQUIRE(pcm24.status == G_RES_OK);
+		REQUIRE(fp32.status == G_RES_OK);
+		REQUIRE(pcm16.wave->getBits() == 16);
+		REQUIRE(pcm24.wave->getBits() == 24);
+		REQUIRE(fp32.wave->getBits() == 32);
+
+		SECTION("test 24-bit Wave is compacted with no loss")
+		{
+			const mcl::AudioBuffer original = pcm24.wave->getBuffer();
+
+			REQUIRE(waveFactory::compact(*pcm24.wave, /*force=*/true, /*budget=*/0, {}));
+			REQUIRE(pcm24.wave->getCompact()->getBits() == 24);
+
+			pcm24.wave->expand();
+			for (int i = 0; i < original.countFrames(); i++)
+				REQUIRE(pcm24.wave->getBuffer()[i][0] == original[i][0]);
+		}
+
+		SECTION("test float Wave is never compacted")
+		{
+			REQUIRE_FALSE(waveFactory::compact(*fp32.wave, /*force=*/true, /*budget=*/0, {}));
+			REQUIRE_FALSE(fp32.wave->isCompact());
+			REQUIRE(fp32.wave->getBuffer()[30][0] > 1.0f); // Overs are kept
+		}
+	}
+
 	SECTION("test recording")
 	{
 		std::unique_ptr<Wave> wave = waveFactory::createEmpty(G_BUFFER_SIZE,
@@ -52,8 +111,71 @@ TEST_CASE("waveFactory")
 
 		REQUIRE(res.wave->getRate() == G_SAMPLE_RATE * 2);
 		REQUIRE(res.wave->getBuffer().countFrames() == oldSize * 2);
-		REQUIRE(res.wave->getBuffer().countChannels() == G_CHANNELS);
+		REQUIRE(res.wave->getBuffer().countChannels() == 1);
 		REQUIRE(res.wave->isLogical() == false);
 		REQUIRE(res.wave->isEdited() == false);
 	}
+
+	SECTION("test parallel deserialization")
+	{
+		const std::vector<Patch::Wave> pwaves = {
+		    {10, TEST_RESOURCES_DIR "test.wav"},
+		    {11, TEST_RESOURCES_DIR "missing.wav"},
+		    {12, TEST_RESOURCES_DIR "test.wav"}};
+
+		std::atomic<int>                   loaded = 0;
+		std::vector<std::unique_ptr<Wave>> waves  = waveFactory::deserializeWaves(pwaves, G_SAMPLE_RATE,
+		    Resampler::Quality::LINEAR, /*streamingThreshold=*/0, [&loaded]() { loaded++; });
+
+		REQUIRE(loaded == 3);
+		REQUIRE(waves.size() == 3);
+		REQUIRE(waves[0]->id == 10);
+		REQUIRE(waves[1] == nullptr);
+		REQUIRE(waves[2]->id == 12);
+		REQUIRE(waves[2]->getBuffer().countFrames() == waves[0]->getBuffer().countFrames());
+	}
+
+	SECTION("test chunked resampling")
+	{
+		/* Long enough to be split in chunks, with a last partial one. Chunks
+		must match a single conversion of the whole buffer, frame by frame. */
+
+		static const int FRAMES = G_LOAD_CHUNK_FRAMES * 3 + 123;
+
+		std::unique_ptr<Wave> wave = waveFactory::createEmpty(FRAMES, G_MAX_IO_CHANS, G_SAMPLE_RATE, "test.wav");
+		for (int i = 0; i < FRAMES; i++)
+		{
+			wave->getWritableBuffer()[i][0] = std::sin(i * 0.01f) * 0.5f + std::sin(i * 0.3f) * 0.25f;
+			wave->getWritableBuffer()[i][1] = std::cos(i * 0.02f) * 0.5f;
+		}
+
+		std::vector<float> input(wave->getBuffer()[0], wave->getBuffer()[0] + FRAMES * G_MAX_IO_CHANS);
+		std::vector<float> expected((FRAMES * 160 + 146) / 147 * G_MAX_IO_CHANS);
+
+		SRC_DATA data{};
+		data.data_in       = input.data();
+		data.input_frames  = FRAMES;
+		data.data_out      = expected.data();
+		data.output_frames = static_cast<long>(expected.size()) / G_MAX_IO_CHANS;
+		data.src_ratio     = 48000 / static_cast<double>(G_SAMPLE_RATE);
+
+		REQUIRE(src_simple(&data, SRC_SINC_BEST_QUALITY, G_MAX_IO_CHANS) == 0);
+
+		REQUIRE(waveFactory::resample(*wave.get(), Resampler::Quality::SINC_BEST, 48000) == G_RES_OK);
+		REQUIRE(wave->getRate() == 48000);
+		REQUIRE(wave->getBuffer().countFrames() == data.output_frames);
+
+		/* Frames past the ones generated by the single conversion, if any, are
+		left silent. */
+
+		const mcl::AudioBuffer& buffer = wave->getBuffer();
+		for (int i = 0; i < buffer.countFrames(); i++)
+		{
+			for (int j = 0; j < G_MAX_IO_CHANS; j++)
+			{
+				const float value = i < data.output_frames_gen ? expected[i * G_MAX_IO_CHANS + j] : 0.0f;
+				REQUIRE(buffer[i][j] == Approx(value).margin(0.00001f));
+			}
+		}
+	}
 }
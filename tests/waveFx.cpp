@@ -73,6 +73,22 @@ TEST_CASE("waveFx")
 		REQUIRE(waveStereo.getBuffer().countFrames() == area);
 	}
 
+	SECTION("test paste mono into stereo")
+	{
+		int a = 100;
+
+		for (int i = 0; i < BUFFER_SIZE; i++)
+			waveMono.getWritableBuffer()[i][0] = 0.5f;
+
+		wfx::paste(waveMono, waveStereo, a);
+
+		REQUIRE(waveMono.getBuffer().countChannels() == 1); // Source untouched
+		REQUIRE(waveStereo.getBuffer().countFrames() == BUFFER_SIZE * 2);
+		REQUIRE(waveStereo.getBuffer().countChannels() == 2);
+		REQUIRE(waveStereo.getBuffer()[a][0] == 0.5f);
+		REQUIRE(waveStereo.getBuffer()[a][1] == 0.5f);
+	}
+
 	SECTION("test fade")
 	{
 		int a = 47;
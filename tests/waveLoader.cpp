@@ -0,0 +1,90 @@
+#include "../src/core/waveLoader.h"
+#include "../src/core/wave.h"
+#include <catch2/catch.hpp>
+
+TEST_CASE("WaveLoader")
+{
+	using namespace giada;
+	using namespace giada::m;
+
+	static const int SAMPLE_RATE = 44100;
+
+	WaveLoader loader;
+
+	REQUIRE(loader.isLoading() == false);
+	REQUIRE(loader.press(/*channelId=*/1, /*velocity=*/127, /*frame=*/0) == false);
+	REQUIRE(loader.release(/*channelId=*/1) == false);
+
+	SECTION("test load in order")
+	{
+		loader.start({{{10, TEST_RESOURCES_DIR "test.wav"}, {1, 2}},
+		                 {{11, TEST_RESOURCES_DIR "missing.wav"}, {3}},
+		                 {{12, TEST_RESOURCES_DIR "test.wav"}, {4}}},
+		    SAMPLE_RATE, Resampler::Quality::LINEAR, /*streamingThreshold=*/0, /*threads=*/1);
+
+		REQUIRE(loader.isLoading() == true);
+
+		loader.wait();
+
+		REQUIRE(loader.isLoading() == true); // Not collected yet
+
+		std::vector<WaveLoader::Result> results = loader.collect();
+
+		REQUIRE(loader.isLoading() == false);
+		REQUIRE(results.size() == 3);
+		REQUIRE(results[0].wave->id == 10);
+		REQUIRE(results[0].channelIds == (std::vector<ID>{1, 2}));
+		REQUIRE(results[1].wave == nullptr);
+		REQUIRE(results[1].patchWave.path == TEST_RESOURCES_DIR "missing.wav");
+		REQUIRE(results[2].wave->id == 12);
+	}
+
+	SECTION("test key presses")
+	{
+		loader.start({{{10, TEST_RESOURCES_DIR "test.wav"}, {1, 2}},
+		                 {{11, TEST_RESOURCES_DIR "test.wav"}, {3}}},
+		    SAMPLE_RATE, Resampler::Quality::LINEAR, /*streamingThreshold=*/0, /*threads=*/1);
+
+		REQUIRE(loader.press(2, 64, 1000) == true);
+		REQUIRE(loader.press(3, 100, 2000) == true);
+		REQUIRE(loader.press(5, 100, 3000) == false);
+
+		REQUIRE(loader.release(3) == true);
+		loader.wait();
+
+		std::vector<WaveLoader::Result> results = loader.collect();
+
+		REQUIRE(results.size() == 2);
+
+		for (const WaveLoader::Result& r : results)
+		{
+			REQUIRE(r.presses.size() == 1);
+			if (r.wave->id == 10)
+			{
+				REQUIRE(r.presses[0].channelId == 2);
+				REQUIRE(r.presses[0].velocity == 64);
+				REQUIRE(r.presses[0].frame == 1000);
+				REQUIRE(r.presses[0].released == false);
+			}
+			else
+			{
+				REQUIRE(r.presses[0].channelId == 3);
+				REQUIRE(r.presses[0].released == true);
+			}
+		}
+
+		/* Channels are not waiting anymore once collected. */
+
+		REQUIRE(loader.press(2, 64, 4000) == false);
+	}
+
+	SECTION("test stop")
+	{
+		loader.start({{{10, TEST_RESOURCES_DIR "test.wav"}, {1}}},
+		    SAMPLE_RATE, Resampler::Quality::LINEAR, /*streamingThreshold=*/0);
+		loader.stop();
+
+		REQUIRE(loader.isLoading() == false);
+		REQUIRE(loader.collect().empty());
+	}
+}
@@ -1,9 +1,12 @@
 #include "../src/core/channels/waveReader.h"
 #include "../src/core/resampler.h"
 #include "../src/core/wave.h"
+#include "../src/core/waveFactory.h"
+#include "../src/core/waveStream.h"
 #include "../src/utils/vector.h"
 #include <catch2/catch.hpp>
 #include <memory>
+#include <vector>
 
 TEST_CASE("WaveReader")
 {
@@ -13,8 +16,8 @@ TEST_CASE("WaveReader")
 	constexpr int NUM_CHANNELS = 2;
 
 	m::Wave wave(0);
-	wave.getBuffer().alloc(BUFFER_SIZE, NUM_CHANNELS);
-	wave.getBuffer().forEachFrame([](float* f, int i) {
+	wave.getWritableBuffer().alloc(BUFFER_SIZE, NUM_CHANNELS);
+	wave.getWritableBuffer().forEachFrame([](float* f, int i) {
 		f[0] = static_cast<float>(i + 1);
 		f[1] = static_cast<float>(i + 1);
 	});
@@ -69,4 +72,85 @@ TEST_CASE("WaveReader")
 			REQUIRE(numFramesFilled == res.generated);
 		}
 	}
+
+	SECTION("Test fill, mono Wave")
+	{
+		m::Wave mono(0);
+		mono.getWritableBuffer().alloc(BUFFER_SIZE, 1);
+		mono.getWritableBuffer().forEachFrame([](float* f, int i) {
+			f[0] = static_cast<float>(i + 1);
+		});
+		waveReader.wave = &mono;
+
+		mcl::AudioBuffer out(BUFFER_SIZE, NUM_CHANNELS);
+
+		m::WaveReader::Result res = waveReader.fill(out,
+		    /*start=*/0, BUFFER_SIZE, /*offset=*/0, /*pitch=*/1.0f);
+
+		REQUIRE(res.used == BUFFER_SIZE);
+		REQUIRE(res.generated == BUFFER_SIZE);
+		for (int i = 0; i < BUFFER_SIZE; i++)
+		{
+			REQUIRE(out[i][0] == static_cast<float>(i + 1));
+			REQUIRE(out[i][1] == static_cast<float>(i + 1));
+		}
+	}
+	SECTION("Test fill, pitch 3.0, streamed and compact Waves")
+	{
+		/* Streamed and compact Waves are resampled in chunks gathered in a
+		scratch buffer: the result must match the in-memory path, with the
+		widest filter and block after block. */
+
+		constexpr int   FIRST = 1024;
+		constexpr float PITCH = 3.0f;
+
+		const std::string      path = TEST_RESOURCES_DIR "test.wav";
+		m::waveFactory::Result res  = m::waveFactory::createFromFile(path, /*ID=*/0, /*sampleRate=*/44100,
+		     m::Resampler::Quality::LINEAR);
+
+		REQUIRE(res.status == G_RES_OK);
+
+		m::Wave& inMemory = *res.wave;
+
+		m::Wave compact(inMemory);
+		REQUIRE(compact.compact());
+
+		m::Wave streamed(1);
+		streamed.alloc(FIRST, G_MAX_IO_CHANS, inMemory.getRate(), inMemory.getBits(), path);
+		for (int i = 0; i < FIRST; i++)
+			streamed.getWritableBuffer()[i][0] = streamed.getWritableBuffer()[i][1] = inMemory.getBuffer()[i][0];
+		streamed.setStream(std::make_unique<m::WaveStream>(path, FIRST));
+
+		auto render = [](m::Wave& w) {
+			m::Resampler  resampler(m::Resampler::Quality::SINC_BEST, G_MAX_IO_CHANS);
+			m::WaveReader reader(&resampler);
+			reader.wave = &w;
+
+			mcl::AudioBuffer   block(BUFFER_SIZE, G_MAX_IO_CHANS);
+			std::vector<float> out;
+			for (Frame start = 0; start < w.getSize();)
+			{
+				block.clear();
+				const m::WaveReader::Result r = reader.fill(block, start, w.getSize(), /*offset=*/0, PITCH);
+				out.insert(out.end(), block[0], block[0] + r.generated * G_MAX_IO_CHANS);
+				start += r.used;
+				if (r.generated < block.countFrames())
+					break;
+			}
+			return out;
+		};
+
+		const std::vector<float> expected = render(inMemory);
+
+		REQUIRE(expected.size() > BUFFER_SIZE * G_MAX_IO_CHANS);
+
+		for (m::Wave* w : {&compact, &streamed})
+		{
+			const std::vector<float> actual = render(*w);
+
+			REQUIRE(actual.size() == expected.size());
+			for (std::size_t i = 0; i < actual.size(); i++)
+				REQUIRE(actual[i] == Approx(expected[i]).margin(0.00001f));
+		}
+	}
 }
@@ -0,0 +1,62 @@
+#include "../src/core/waveStream.h"
+#include "../src/core/const.h"
+#include "../src/core/resampler.h"
+#include "../src/core/wave.h"
+#include "../src/core/waveFactory.h"
+#include <catch2/catch.hpp>
+#include <vector>
+
+TEST_CASE("WaveStream")
+{
+	using namespace giada::m;
+
+	constexpr int FIRST = 1024;
+
+	/* Reference data: same file loaded in memory. The test file is mono, so
+	it's kept mono in memory, while the stream upmixes it to stereo. */
+
+	waveFactory::Result res = waveFactory::createFromFile(TEST_RESOURCES_DIR "test.wav",
+	    /*ID=*/0, /*sampleRate=*/44100, Resampler::Quality::LINEAR);
+	const mcl::AudioBuffer& data = res.wave->getBuffer();
+
+	REQUIRE(data.countChannels() == 1);
+
+	mcl::AudioBuffer head(FIRST, G_MAX_IO_CHANS);
+	for (int i = 0; i < FIRST; i++)
+		head[i][0] = head[i][1] = data[i][0];
+
+	/* The constructor fills the loop cache and the ring buffer right away, so
+	the short test file is entirely available. */
+
+	WaveStream stream(TEST_RESOURCES_DIR "test.wav", FIRST);
+
+	REQUIRE(stream.isOpen());
+	REQUIRE(stream.getSize() == data.countFrames());
+
+	SECTION("Test read across head and streamed part")
+	{
+		const int          count = FIRST * 4;
+		std::vector<float> out(count * G_MAX_IO_CHANS);
+
+		REQUIRE(stream.read(head, out.data(), FIRST / 2, count));
+
+		for (int i = 0; i < count; i++)
+		{
+			REQUIRE(out[i * 2] == data[FIRST / 2 + i][0]);
+			REQUIRE(out[i * 2 + 1] == data[FIRST / 2 + i][0]);
+		}
+	}
+
+	SECTION("Test read out of range")
+	{
+		std::vector<float> out(FIRST * G_MAX_IO_CHANS, 1.0f);
+
+		REQUIRE(stream.read(head, out.data(), stream.getSize() - FIRST / 2, FIRST));
+
+		for (int i = FIRST / 2; i < FIRST; i++)
+		{
+			REQUIRE(out[i * 2] == 0.0f);
+			REQUIRE(out[i * 2 + 1] == 0.0f);
+		}
+	}
+}